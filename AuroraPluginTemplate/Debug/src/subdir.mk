@@ -4,13 +4,58 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/AuroraPlugin.cpp 
+../src/AuroraPlugin.cpp \
+../src/FrameSlicing.cpp \
+../src/SweepIndex.cpp \
+../src/LayoutCache.cpp \
+../src/PanelHitTest.cpp \
+../src/CoverageMap.cpp \
+../src/LayoutGenerator.cpp \
+../src/LayoutUpdates.cpp \
+../src/ColorBatch.cpp \
+../src/PaletteGradient.cpp \
+../src/BlendKernels.cpp \
+../src/RGB8.cpp \
+../src/FrameBuffer.cpp \
+../src/OutputStage.cpp \
+../src/OKLab.cpp \
+../src/PaletteUpdates.cpp 
 
 OBJS += \
-./src/AuroraPlugin.o 
+./src/AuroraPlugin.o \
+./src/FrameSlicing.o \
+./src/SweepIndex.o \
+./src/LayoutCache.o \
+./src/PanelHitTest.o \
+./src/CoverageMap.o \
+./src/LayoutGenerator.o \
+./src/LayoutUpdates.o \
+./src/ColorBatch.o \
+./src/PaletteGradient.o \
+./src/BlendKernels.o \
+./src/RGB8.o \
+./src/FrameBuffer.o \
+./src/OutputStage.o \
+./src/OKLab.o \
+./src/PaletteUpdates.o 
 
 CPP_DEPS += \
-./src/AuroraPlugin.d 
+./src/AuroraPlugin.d \
+./src/FrameSlicing.d \
+./src/SweepIndex.d \
+./src/LayoutCache.d \
+./src/PanelHitTest.d \
+./src/CoverageMap.d \
+./src/LayoutGenerator.d \
+./src/LayoutUpdates.d \
+./src/ColorBatch.d \
+./src/PaletteGradient.d \
+./src/BlendKernels.d \
+./src/RGB8.d \
+./src/FrameBuffer.d \
+./src/OutputStage.d \
+./src/OKLab.d \
+./src/PaletteUpdates.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -0,0 +1,49 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LibraryStubs.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TESTS_INC_LIBRARYSTUBS_H_
+#define TESTS_INC_LIBRARYSTUBS_H_
+
+#include "LayoutProcessingUtils.h"
+#include "ColorUtils.h"
+
+/*
+ * Stand-ins for the parts of libPluginUtilities the checks and benchmarks link against. The library in Utilities is
+ * built for the Aurora and macOS hosts only, the stand-ins let the checks build and run on any host.
+ * Panels are regular polygons with Shape::sideLength sides: orientation 0 is a triangle pointing up (horizontal base
+ * at the bottom) and an axis aligned square, other orientations rotate them counterclockwise about the centroid.
+ * parseLayoutData reads the positionData stream (panelId, x, y, orientation, shapeType per panel) and sets
+ * layoutGeometricCenter to the mean of the centroids. rotateAuroraPanels turns the centroids around
+ * layoutGeometricCenter and adds the angle to the orientations. HSVtoRGB and RGBtoHSV use the textbook float formulas
+ */
+
+/**
+ * @description: the layout getLayoutData returns, not owned
+ */
+void setStubLayoutData(LayoutData* layoutData);
+
+/**
+ * @description: the palette getColorPalette returns, not owned
+ */
+void setStubColorPalette(RGB_t* palette, int nColors);
+
+#endif /* TESTS_INC_LIBRARYSTUBS_H_ */
@@ -0,0 +1,144 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * BlendKernelsCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "BlendKernels.h"
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * Compares the integer kernels with a 64 bit reference, once element by element (a one element call only runs the
+ * scalar blend) and once over whole buffers (the vector blend, plus the scalar one on the tail). Run under
+ * -fsanitize=undefined, this also catches any signed overflow in the scalar blends. Float kernels are compared
+ * between the two paths
+ */
+
+enum { LERP, LERP_CONSTANT, ADD, MAX, MULTIPLY, SCREEN, N_BLENDS };
+static const char* blendNames[N_BLENDS] = {"lerp", "lerp constant", "add", "max", "multiply", "screen"};
+
+/*rounded x/fullScale, there are no ties as fullScale is odd*/
+static uint64_t roundedDiv(uint64_t x, uint64_t fullScale){
+	return (2*x + fullScale)/(2*fullScale);
+}
+
+static uint64_t reference(int blend, uint64_t d, uint64_t s, uint64_t t, uint64_t fullScale){
+	switch (blend){
+	case LERP:
+	case LERP_CONSTANT: return roundedDiv(d*(fullScale - t) + s*t, fullScale);
+	case ADD: return (d + s > fullScale) ? fullScale : d + s;
+	case MAX: return (d > s) ? d : s;
+	case MULTIPLY: return roundedDiv(d*s, fullScale);
+	default: return fullScale - roundedDiv((fullScale - d)*(fullScale - s), fullScale);
+	}
+}
+
+template <typename T>
+static void runBlend(int blend, T* dst, const T* src, const T* t, int n){
+	switch (blend){
+	case LERP: blendLerp(dst, src, t, n); break;
+	case LERP_CONSTANT: blendLerpConstant(dst, src[0], t, n); break;
+	case ADD: blendAdd(dst, src, n); break;
+	case MAX: blendMax(dst, src, n); break;
+	case MULTIPLY: blendMultiply(dst, src, n); break;
+	default: blendScreen(dst, src, n); break;
+	}
+}
+
+/**
+ * @description: checks every blend on all (d, s, t) triples of values, one element at a time and as one buffer
+ */
+template <typename T>
+static void checkIntegerBlends(const std::vector<T>& values, uint64_t fullScale, const char* type){
+	int nValues = values.size();
+	std::vector<T> d, s, t;
+	for (int i = 0; i < nValues; i++){
+		for (int j = 0; j < nValues; j++){
+			for (int k = 0; k < nValues; k++){
+				d.push_back(values[i]);
+				s.push_back(values[j]);
+				t.push_back(values[k]);
+			}
+		}
+	}
+	int n = d.size();
+	for (int blend = 0; blend < N_BLENDS; blend++){
+		//lerp constant blends a single source value, so every source value gets a buffer of its own
+		int nSources = (blend == LERP_CONSTANT) ? nValues : 1;
+		for (int source = 0; source < nSources; source++){
+			std::vector<T> src = s;
+			if (blend == LERP_CONSTANT){
+				src.assign(n, values[source]);
+			}
+			std::vector<T> batch = d;
+			runBlend(blend, batch.data(), src.data(), t.data(), n);
+			int nFailures = 0;
+			for (int i = 0; i < n && nFailures < 5; i++){
+				T alone = d[i];
+				runBlend(blend, &alone, &src[i], &t[i], 1);
+				uint64_t expected = reference(blend, d[i], src[i], t[i], fullScale);
+				bool ok = alone == expected && batch[i] == expected;
+				nFailures += !ok;
+				CHECK(ok, "%s %s(%u, %u, %u): scalar %u, vector %u, expected %u", type, blendNames[blend],
+						(unsigned)d[i], (unsigned)src[i], (unsigned)t[i], (unsigned)alone, (unsigned)batch[i],
+						(unsigned)expected);
+			}
+		}
+	}
+}
+
+static void checkFloatBlends(){
+	const int n = 1000;
+	std::vector<float> d(n), s(n), t(n);
+	srand(7);
+	for (int i = 0; i < n; i++){
+		d[i] = rand()/(float)RAND_MAX;
+		s[i] = rand()/(float)RAND_MAX;
+		t[i] = rand()/(float)RAND_MAX;
+	}
+	for (int blend = 0; blend < N_BLENDS; blend++){
+		std::vector<float> batch = d;
+		runBlend(blend, batch.data(), s.data(), t.data(), n);
+		int nFailures = 0;
+		for (int i = 0; i < n && nFailures < 5; i++){
+			float alone = d[i];
+			runBlend(blend, &alone, (blend == LERP_CONSTANT) ? &s[0] : &s[i], &t[i], 1);
+			nFailures += (alone != batch[i]);
+			CHECK(alone == batch[i], "float %s at %d: scalar %.9g, vector %.9g", blendNames[blend], i, alone, batch[i]);
+		}
+	}
+}
+
+int main(){
+	std::vector<uint8_t> bytes = {0, 1, 2, 127, 128, 129, 200, 254, 255};
+	checkIntegerBlends(bytes, 255, "uint8_t");
+
+	//full scale values first, their products overflow a 32 bit int
+	std::vector<uint16_t> words = {65535, 65534, 0, 1, 255, 256, 32767, 32768, 32769, 40000, 65279};
+	srand(3);
+	for (int i = 0; i < 10; i++){
+		words.push_back(rand() & 0xFFFF);
+	}
+	checkIntegerBlends(words, 65535, "uint16_t");
+
+	checkFloatBlends();
+	return CHECK_RESULT();
+}
@@ -0,0 +1,73 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * ColorBatchBench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "ColorBatch.h"
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * Times HSVtoRGBBatch and RGBtoHSVBatch against a per-color loop over HSVtoRGB and RGBtoHSV, and against the scalar
+ * code of ColorBatch.cpp alone: ColorBatchScalar.o is ColorBatch.cpp built without SSE2 and AVX, with the functions
+ * renamed. HSVtoRGB and RGBtoHSV are the stand-ins of LibraryStubs.cpp here, not the Aurora library
+ */
+
+void HSVtoRGBBatchScalar(const HSV_t* hsv, RGB_t* rgb, int nColors);
+void RGBtoHSVBatchScalar(const RGB_t* rgb, HSV_t* hsv, int nColors);
+
+int main(){
+	const int sizes[] = {64, 512, 4096};
+	for (int n = 0; n < 3; n++){
+		int nColors = sizes[n];
+		int nRuns = 2000000/nColors;
+		std::vector<HSV_t> hsv(nColors);
+		std::vector<RGB_t> rgb(nColors);
+		srand(1);
+		for (int i = 0; i < nColors; i++){
+			hsv[i] = {rand() % 360, rand() % 101, rand() % 101};
+			rgb[i] = {rand() % 256, rand() % 256, rand() % 256};
+		}
+		std::vector<RGB_t> rgbOut(nColors);
+		std::vector<HSV_t> hsvOut(nColors);
+
+		double batchUs = timePerCall([&](){ HSVtoRGBBatch(hsv.data(), rgbOut.data(), nColors); }, nRuns);
+		double scalarUs = timePerCall([&](){ HSVtoRGBBatchScalar(hsv.data(), rgbOut.data(), nColors); }, nRuns);
+		double loopUs = timePerCall([&](){
+			for (int i = 0; i < nColors; i++){
+				HSVtoRGB(hsv[i], &rgbOut[i]);
+			}
+		}, nRuns);
+		printf("HSVtoRGB %5d colors: batch %8.2f us, batch scalar %8.2f us, per color %8.2f us\n", nColors, batchUs,
+				scalarUs, loopUs);
+
+		batchUs = timePerCall([&](){ RGBtoHSVBatch(rgb.data(), hsvOut.data(), nColors); }, nRuns);
+		scalarUs = timePerCall([&](){ RGBtoHSVBatchScalar(rgb.data(), hsvOut.data(), nColors); }, nRuns);
+		loopUs = timePerCall([&](){
+			for (int i = 0; i < nColors; i++){
+				RGBtoHSV(rgb[i], &hsvOut[i]);
+			}
+		}, nRuns);
+		printf("RGBtoHSV %5d colors: batch %8.2f us, batch scalar %8.2f us, per color %8.2f us\n", nColors, batchUs,
+				scalarUs, loopUs);
+	}
+	return 0;
+}
@@ -0,0 +1,106 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * ColorBatchCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "ColorBatch.h"
+#include <limits.h>
+#include <vector>
+
+/*
+ * The vector paths of ColorBatch.cpp must give the same results as its scalar code. A one color batch is converted by
+ * the scalar code only, so every color converted in a large batch is compared with the same color converted alone
+ */
+
+static bool sameRgb(const RGB_t& a, const RGB_t& b){
+	return a.R == b.R && a.G == b.G && a.B == b.B;
+}
+
+static bool sameHsv(const HSV_t& a, const HSV_t& b){
+	return a.H == b.H && a.S == b.S && a.V == b.V;
+}
+
+static void checkHsv(const std::vector<HSV_t>& hsv){
+	std::vector<RGB_t> rgb(hsv.size());
+	HSVtoRGBBatch(hsv.data(), rgb.data(), hsv.size());
+	int nFailures = 0;
+	for (unsigned int i = 0; i < hsv.size() && nFailures < 10; i++){
+		RGB_t alone;
+		HSVtoRGBBatch(&hsv[i], &alone, 1);
+		nFailures += !sameRgb(rgb[i], alone);
+		CHECK(sameRgb(rgb[i], alone), "HSV (%d, %d, %d): batch (%d, %d, %d), alone (%d, %d, %d)", hsv[i].H, hsv[i].S,
+				hsv[i].V, rgb[i].R, rgb[i].G, rgb[i].B, alone.R, alone.G, alone.B);
+	}
+}
+
+static void checkRgb(const std::vector<RGB_t>& rgb){
+	std::vector<HSV_t> hsv(rgb.size());
+	RGBtoHSVBatch(rgb.data(), hsv.data(), rgb.size());
+	int nFailures = 0;
+	for (unsigned int i = 0; i < rgb.size() && nFailures < 10; i++){
+		HSV_t alone;
+		RGBtoHSVBatch(&rgb[i], &alone, 1);
+		nFailures += !sameHsv(hsv[i], alone);
+		CHECK(sameHsv(hsv[i], alone), "RGB (%d, %d, %d): batch (%d, %d, %d), alone (%d, %d, %d)", rgb[i].R, rgb[i].G,
+				rgb[i].B, hsv[i].H, hsv[i].S, hsv[i].V, alone.H, alone.S, alone.V);
+	}
+}
+
+int main(){
+	//every in range HSV color, and out of range ones around every boundary
+	std::vector<HSV_t> hsv;
+	for (int h = -370; h <= 730; h++){
+		for (int s = -2; s <= 102; s++){
+			for (int v = -2; v <= 102; v += (h >= 0 && h < 360) ? 1 : 7){
+				hsv.push_back({h, s, v});
+			}
+		}
+	}
+	//hues around the limit of the vector path, mixed with normal ones so both paths meet in one block
+	const int bigHues[] = {4194303, 4194304, -4194303, -4194304, 16777217, -16777217, INT_MAX, INT_MIN, 359, -1};
+	for (int i = 0; i < 10; i++){
+		for (int k = 0; k < 9; k++){
+			hsv.push_back({(k == 4) ? bigHues[i] : 60*k + i, 50 + k, 100 - k});
+		}
+	}
+	checkHsv(hsv);
+
+	std::vector<RGB_t> rgb;
+	for (int r = -3; r <= 258; r += 3){
+		for (int g = -2; g <= 258; g += 2){
+			for (int b = -1; b <= 258; b++){
+				rgb.push_back({r, g, b});
+			}
+		}
+	}
+	rgb.push_back({INT_MIN, INT_MAX, 0});
+	rgb.push_back({INT_MAX, INT_MIN, 128});
+	checkRgb(rgb);
+
+	//spot checks against known values
+	RGB_t out;
+	HSV_t red = {0, 100, 100}, halfCyan = {180, 100, 50};
+	HSVtoRGBBatch(&red, &out, 1);
+	CHECK(sameRgb(out, RGB_t{255, 0, 0}), "red is (%d, %d, %d)", out.R, out.G, out.B);
+	HSVtoRGBBatch(&halfCyan, &out, 1);
+	CHECK(sameRgb(out, RGB_t{0, 128, 128}), "half cyan is (%d, %d, %d)", out.R, out.G, out.B);
+	return CHECK_RESULT();
+}
@@ -0,0 +1,167 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * ConstexprColorCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "ConstexprColor.h"
+#include "ColorBatch.h"
+#include "PaletteGradient.h"
+#include <vector>
+
+/*
+ * The tables of ConstexprColor.h must match the ones built at runtime: the conversions are compared with
+ * HSVtoRGBBatch and RGBtoHSVBatch over every input (and out of range inputs), the palette, hue and gradient tables
+ * with their runtime counterparts. The tables are evaluated by the compiler, so a conversion that is not a constant
+ * expression fails to build here
+ */
+
+static constexpr HSV_t paletteHsv[] = {{227, 100, 99}, {182, 100, 100}, {125, 100, 93}, {0, 0, 100}, {300, 40, 20}};
+static constexpr auto palette = makePaletteTable(paletteHsv);
+static constexpr auto hues = makeHueTable<360>(100, 100);
+static constexpr auto gradient = makeGradientTable<1024>(palette.colors);
+static constexpr RGB_t twoColors[] = {{255, 0, 0}, {0, 0, 255}};
+static constexpr auto smallGradient = makeGradientTable<2>(twoColors);
+static constexpr RGB_t oneColor[] = {{12, 34, 56}};
+static constexpr auto flatGradient = makeGradientTable<16>(oneColor);
+
+static_assert(palette.colors[3].R == 255 && palette.colors[3].G == 255 && palette.colors[3].B == 255,
+		"white converts at compile time");
+static_assert(hues.colors[120].R == 0 && hues.colors[120].G == 255 && hues.colors[120].B == 0,
+		"green converts at compile time");
+static_assert(gradient.colors[0].R == palette.colors[0].R && gradient.colors[1023].B == palette.colors[4].B,
+		"the gradient ends on the palette ends");
+
+static bool sameRgb(const RGB_t& a, const RGB_t& b){
+	return a.R == b.R && a.G == b.G && a.B == b.B;
+}
+
+static bool sameHsv(const HSV_t& a, const HSV_t& b){
+	return a.H == b.H && a.S == b.S && a.V == b.V;
+}
+
+static void checkHsvToRgb(const std::vector<HSV_t>& hsv){
+	std::vector<RGB_t> rgb(hsv.size());
+	HSVtoRGBBatch(hsv.data(), rgb.data(), hsv.size());
+	int nFailures = 0;
+	for (unsigned int i = 0; i < hsv.size() && nFailures < 10; i++){
+		RGB_t expected = constexprHSVtoRGB(hsv[i]);
+		nFailures += !sameRgb(rgb[i], expected);
+		CHECK(sameRgb(rgb[i], expected), "HSV (%d, %d, %d): runtime (%d, %d, %d), constexpr (%d, %d, %d)", hsv[i].H,
+				hsv[i].S, hsv[i].V, rgb[i].R, rgb[i].G, rgb[i].B, expected.R, expected.G, expected.B);
+	}
+}
+
+static void checkRgbToHsv(const std::vector<RGB_t>& rgb){
+	std::vector<HSV_t> hsv(rgb.size());
+	RGBtoHSVBatch(rgb.data(), hsv.data(), rgb.size());
+	int nFailures = 0;
+	for (unsigned int i = 0; i < rgb.size() && nFailures < 10; i++){
+		HSV_t expected = constexprRGBtoHSV(rgb[i]);
+		nFailures += !sameHsv(hsv[i], expected);
+		CHECK(sameHsv(hsv[i], expected), "RGB (%d, %d, %d): runtime (%d, %d, %d), constexpr (%d, %d, %d)", rgb[i].R,
+				rgb[i].G, rgb[i].B, hsv[i].H, hsv[i].S, hsv[i].V, expected.H, expected.S, expected.V);
+	}
+}
+
+static void checkConversions(){
+	std::vector<HSV_t> hsv;
+	for (int h = -720; h < 1080; h++){
+		for (int s = -5; s <= 105; s++){
+			for (int v = -5; v <= 105; v += (h >= 0 && h < 360) ? 1 : 7){
+				hsv.push_back(HSV_t{h, s, v});
+			}
+		}
+	}
+	checkHsvToRgb(hsv);
+
+	std::vector<RGB_t> rgb;
+	for (int r = 0; r < 256; r++){
+		rgb.clear();
+		for (int g = 0; g < 256; g++){
+			for (int b = 0; b < 256; b++){
+				rgb.push_back(RGB_t{r, g, b});
+			}
+		}
+		checkRgbToHsv(rgb);
+	}
+	rgb.clear();
+	for (int x = -300; x <= 600; x += 3){
+		rgb.push_back(RGB_t{x, 255 - x, x/2});
+	}
+	checkRgbToHsv(rgb);
+}
+
+static void checkPaletteTables(){
+	const int nColors = sizeof(paletteHsv)/sizeof(paletteHsv[0]);
+	RGB_t rgb[nColors];
+	HSVtoRGBBatch(paletteHsv, rgb, nColors);
+	for (int i = 0; i < nColors; i++){
+		CHECK(sameRgb(palette.colors[i], rgb[i]), "palette color %d differs from HSVtoRGBBatch", i);
+	}
+
+	HSV_t hueHsv[360];
+	RGB_t hueRgb[360];
+	for (int k = 0; k < 360; k++){
+		hueHsv[k] = HSV_t{k, 100, 100};
+	}
+	HSVtoRGBBatch(hueHsv, hueRgb, 360);
+	for (int k = 0; k < 360; k++){
+		CHECK(sameRgb(hues.colors[k], hueRgb[k]), "hue table entry %d differs from HSVtoRGBBatch", k);
+	}
+}
+
+template <int SIZE, int N>
+static void checkGradient(const GradientTable_t<SIZE>& table, const RGB_t (&colors)[N], const char* name){
+	PaletteGradient_t runtime;
+	buildPaletteGradient(colors, N, SIZE, &runtime, PALETTE_INTERPOLATION_RGB);
+	CHECK(runtime.size == SIZE, "%s: runtime size %d", name, runtime.size);
+	CHECK(table.scale == runtime.scale, "%s: scale %f, runtime %f", name, table.scale, runtime.scale);
+	int nFailures = 0;
+	for (int k = 0; k < SIZE && nFailures < 10; k++){
+		nFailures += !sameRgb(table.colors[k], runtime.colors[k]);
+		CHECK(sameRgb(table.colors[k], runtime.colors[k]), "%s entry %d: constexpr (%d, %d, %d), runtime (%d, %d, %d)",
+				name, k, table.colors[k].R, table.colors[k].G, table.colors[k].B, runtime.colors[k].R,
+				runtime.colors[k].G, runtime.colors[k].B);
+	}
+	for (float colour = -1.0f; colour <= N; colour += 0.01f){
+		CHECK(&getGradientColor(table, colour) - table.colors == &getGradientColor(&runtime, colour) - runtime.colors,
+				"%s: lookups differ at %f", name, colour);
+	}
+}
+
+static void checkGradients(){
+	checkGradient(gradient, palette.colors, "palette gradient");
+	checkGradient(smallGradient, twoColors, "2 entry gradient");
+	checkGradient(flatGradient, oneColor, "single color gradient");
+	RGB_t fromHues[360];
+	for (int k = 0; k < 360; k++){
+		fromHues[k] = hues.colors[k];
+	}
+	static constexpr auto hueGradient = makeGradientTable<4096>(hues.colors);
+	checkGradient(hueGradient, fromHues, "hue gradient");
+}
+
+int main(){
+	checkConversions();
+	checkPaletteTables();
+	checkGradients();
+	return CHECK_RESULT();
+}
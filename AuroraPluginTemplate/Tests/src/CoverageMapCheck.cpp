@@ -0,0 +1,180 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * CoverageMapCheck.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Check.h"
+#include "CoverageMap.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * CoverageMap on generated layouts. The weight of every pixel in every panel is read back through sampleChannel with
+ * an image that is 1 at that pixel only. The weights of each panel must sum to exactly 65535, and must equal a brute
+ * force count of the subsamples of every pixel of the raster that isPointInsidePanel puts in the panel, normalized
+ * the same way. At a coarse resolution panels fall between the subsamples and must get their centroid pixel.
+ * sampleImage must average an image with the same weights, and the covered area must match the area of the shapes
+ */
+
+#define WEIGHT_ONE 65535
+#define AREA_TOLERANCE 0.05			/*relative, at resolutions of a few pixels per panel side*/
+
+/*expected weights[panel][pixel], from every subsample of every pixel. Adds the area of the subsamples inside
+panels to coveredArea*/
+static std::vector<std::vector<int> > getBruteForceWeights(LayoutData* layout, int width, int height,
+		double* coveredArea){
+	double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+	for (int i = 0; i < layout->nPanels; i++){
+		Shape* shape = layout->panels[i].shape;
+		for (int k = 0; k < shape->nVertices; k++){
+			minX = fmin(minX, shape->vertices[k].x);
+			maxX = fmax(maxX, shape->vertices[k].x);
+			minY = fmin(minY, shape->vertices[k].y);
+			maxY = fmax(maxY, shape->vertices[k].y);
+		}
+	}
+	double pixelWidth = (maxX - minX)/width, pixelHeight = (maxY - minY)/height;
+
+	std::vector<std::vector<int> > weights(layout->nPanels, std::vector<int>(width*height, 0));
+	for (int i = 0; i < layout->nPanels; i++){
+		std::vector<int>& w = weights[i];
+		int total = 0;
+		for (int r = 0; r < height; r++){
+			for (int c = 0; c < width; c++){
+				for (int sy = 0; sy < COVERAGE_MAP_SUBSAMPLES; sy++){
+					for (int sx = 0; sx < COVERAGE_MAP_SUBSAMPLES; sx++){
+						Point p(minX + (c + (sx + 0.5)/COVERAGE_MAP_SUBSAMPLES)*pixelWidth,
+								maxY - (r + (sy + 0.5)/COVERAGE_MAP_SUBSAMPLES)*pixelHeight);
+						w[r*width + c] += isPointInsidePanel(&layout->panels[i], p);
+					}
+				}
+				total += w[r*width + c];
+			}
+		}
+		*coveredArea += total*pixelWidth*pixelHeight/(COVERAGE_MAP_SUBSAMPLES*COVERAGE_MAP_SUBSAMPLES);
+		if (total == 0){
+			const Point& centroid = layout->panels[i].shape->getCentroid();
+			int c = (int)floor((centroid.x - minX)/pixelWidth), r = (int)floor((maxY - centroid.y)/pixelHeight);
+			c = (c < 0) ? 0 : ((c >= width) ? width - 1 : c);
+			r = (r < 0) ? 0 : ((r >= height) ? height - 1 : r);
+			w[r*width + c] = WEIGHT_ONE;
+			continue;
+		}
+		//the rounding remainder goes to the first of the largest counts
+		int sum = 0, largest = -1;
+		for (int k = 0; k < width*height; k++){
+			if (w[k] > 0 && (largest < 0 || w[k] > w[largest])){
+				largest = k;
+			}
+		}
+		for (int k = 0; k < width*height; k++){
+			w[k] = (int)(((int64_t)w[k]*WEIGHT_ONE)/total);
+			sum += w[k];
+		}
+		w[largest] += WEIGHT_ONE - sum;
+	}
+	return weights;
+}
+
+static void checkLayout(int shapeType, int nPanels, int angle, int width, int height, bool isFine, const char* name){
+	LayoutData* layout = NULL;
+	generateLayoutData(shapeType, nPanels, 11, &layout);
+	rotateAuroraPanels(layout, &angle);
+	CoverageMap map(layout, width, height);
+	CHECK(map.getWidth() == width && map.getHeight() == height, "%s: wrong raster size", name);
+	int nPixels = width*height;
+
+	//weights[panel][pixel] as the map holds them
+	std::vector<std::vector<int> > weights(nPanels, std::vector<int>(nPixels));
+	std::vector<float> image(nPixels, 0.0f), values(nPanels);
+	for (int k = 0; k < nPixels; k++){
+		image[k] = 1;
+		map.sampleChannel(image.data(), values.data());
+		image[k] = 0;
+		for (int i = 0; i < nPanels; i++){
+			weights[i][k] = (int)lround(values[i]*WEIGHT_ONE);
+		}
+	}
+
+	double coveredArea = 0, shapeArea = 0;
+	std::vector<std::vector<int> > expected = getBruteForceWeights(layout, width, height, &coveredArea);
+	int nWrongSums = 0, nWrongPanels = 0;
+	for (int i = 0; i < nPanels; i++){
+		int sum = 0;
+		for (int k = 0; k < nPixels; k++){
+			sum += weights[i][k];
+		}
+		nWrongSums += (sum != WEIGHT_ONE);
+		nWrongPanels += (weights[i] != expected[i]);
+		Shape* shape = layout->panels[i].shape;
+		double area = 0;
+		for (int k = 0; k < shape->nVertices; k++){
+			const Point& a = shape->vertices[k];
+			const Point& b = shape->vertices[(k + 1) % shape->nVertices];
+			area += (a.x*b.y - b.x*a.y)/2;
+		}
+		shapeArea += fabs(area);
+	}
+	CHECK(nWrongSums == 0, "%s: the weights of %d panels do not sum to %d", name, nWrongSums, WEIGHT_ONE);
+	CHECK(nWrongPanels == 0, "%s: %d panels differ from the brute force coverage", name, nWrongPanels);
+	CHECK(!isFine || fabs(coveredArea - shapeArea) < AREA_TOLERANCE*shapeArea,
+			"%s: the subsamples cover %f, the shapes %f", name, coveredArea, shapeArea);
+
+	//sampleImage with the same weights, on a random image
+	std::vector<uint8_t> rgb(3*nPixels);
+	for (int k = 0; k < 3*nPixels; k++){
+		rgb[k] = rand() & 0xFF;
+	}
+	std::vector<Frame_t> frames(nPanels);
+	CHECK(map.sampleImage(rgb.data(), 3, frames.data()) == nPanels, "%s: wrong frame count", name);
+	int nWrongFrames = 0;
+	for (int i = 0; i < nPanels; i++){
+		int64_t sums[3] = {0, 0, 0};
+		for (int k = 0; k < nPixels; k++){
+			for (int ch = 0; ch < 3; ch++){
+				sums[ch] += (int64_t)weights[i][k]*rgb[3*k + ch];
+			}
+		}
+		const Frame_t& f = frames[i];
+		nWrongFrames += f.panelId != layout->panels[i].panelId || f.transTime != 3 ||
+				f.r != (int)((sums[0] + WEIGHT_ONE/2)/WEIGHT_ONE) || f.g != (int)((sums[1] + WEIGHT_ONE/2)/WEIGHT_ONE) ||
+				f.b != (int)((sums[2] + WEIGHT_ONE/2)/WEIGHT_ONE);
+	}
+	CHECK(nWrongFrames == 0, "%s: %d frames differ from the weighted average of the image", name, nWrongFrames);
+	freeLayoutData(layout);
+}
+
+int main(){
+	const int angles[] = {0, 30, 90};
+	char name[64];
+	for (int angle : angles){
+		snprintf(name, sizeof(name), "triangles at %d", angle);
+		checkLayout(SHAPE_TRIANGLE, 12, angle, 40, 30, true, name);
+		snprintf(name, sizeof(name), "squares at %d", angle);
+		checkLayout(SHAPE_SQUARE, 9, angle, 33, 17, true, name);
+		snprintf(name, sizeof(name), "mixed at %d", angle);
+		checkLayout(LAYOUT_GENERATOR_MIXED, 14, angle, 24, 36, true, name);
+		snprintf(name, sizeof(name), "coarse mixed at %d", angle);
+		checkLayout(LAYOUT_GENERATOR_MIXED, 60, angle, 3, 2, false, name);
+	}
+	return CHECK_RESULT();
+}
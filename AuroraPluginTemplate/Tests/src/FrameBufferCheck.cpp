@@ -0,0 +1,111 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FrameBufferCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "FrameBuffer.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <vector>
+
+/*
+ * Checks that writeFrames quantizes like the documented clamp and truncate, on both the vector loop and the tail, for
+ * special values and a fine sweep over the whole range, and that the buffer follows the layout
+ */
+
+static int expectedChannel(float x){
+	if (isnan(x) || x <= 0){
+		return 0;
+	}
+	return (x >= 255) ? 255 : (int)x;
+}
+
+int main(){
+	const float special[] = {NAN, -NAN, INFINITY, -INFINITY, -0.0f, 0.0f, 1e-30f, 0.999999f, 1.0f, 127.5f, 254.99998f,
+			255.0f, 255.00002f, 256.0f, 1e30f, -1e30f, -0.5f, -1.0f};
+	const int nSpecial = sizeof(special)/sizeof(special[0]);
+
+	FrameBuffer_t frameBuffer;
+	for (int nPanels = 1; nPanels <= 23; nPanels++){
+		LayoutData* layout = NULL;
+		generateLayoutData(SHAPE_SQUARE, nPanels, nPanels, &layout);
+		getFrameBuffer(layout, &frameBuffer);
+		CHECK(frameBuffer.nPanels == nPanels && frameBuffer.capacity >= nPanels, "buffer of %d panels", nPanels);
+		bool black = true;
+		for (int i = 0; i < nPanels; i++){
+			black = black && frameBuffer.r[i] == 0 && frameBuffer.g[i] == 0 && frameBuffer.b[i] == 0;
+			//every channel sees every special value at some position of the vector and of the tail
+			frameBuffer.r[i] = special[i % nSpecial];
+			frameBuffer.g[i] = special[(i + 5) % nSpecial];
+			frameBuffer.b[i] = special[(nSpecial - 1 - i % nSpecial)];
+		}
+		CHECK(black, "getFrameBuffer did not clear the buffer of %d panels", nPanels);
+
+		std::vector<Frame_t> frames(nPanels);
+		CHECK(writeFrames(&frameBuffer, frames.data(), 3) == nPanels, "writeFrames count");
+		for (int i = 0; i < nPanels; i++){
+			const Frame_t& f = frames[i];
+			CHECK(f.panelId == layout->panels[i].panelId && f.transTime == 3, "panel %d of %d", i, nPanels);
+			CHECK(f.r == expectedChannel(frameBuffer.r[i]) && f.g == expectedChannel(frameBuffer.g[i]) &&
+					f.b == expectedChannel(frameBuffer.b[i]), "panel %d of %d: (%g, %g, %g) written as (%d, %d, %d)",
+					i, nPanels, frameBuffer.r[i], frameBuffer.g[i], frameBuffer.b[i], f.r, f.g, f.b);
+		}
+		freeLayoutData(layout);
+	}
+
+	//a smaller layout reuses the buffers
+	LayoutData* layout = NULL;
+	generateLayoutData(SHAPE_TRIANGLE, 400, 1, &layout);
+	getFrameBuffer(layout, &frameBuffer);
+	float* r = frameBuffer.r;
+	LayoutData* smaller = NULL;
+	generateLayoutData(SHAPE_TRIANGLE, 100, 1, &smaller);
+	getFrameBuffer(smaller, &frameBuffer);
+	CHECK(frameBuffer.r == r && frameBuffer.nPanels == 100, "a smaller layout reallocated");
+
+	//a sweep over [-2, 258] in steps of 1/64 through all three channels
+	std::vector<Frame_t> frames(layout->nPanels);
+	getFrameBuffer(layout, &frameBuffer);
+	int nFailures = 0;
+	for (float start = -2; start < 258 && nFailures < 10; start += layout->nPanels/64.0f){
+		for (int i = 0; i < frameBuffer.nPanels; i++){
+			frameBuffer.r[i] = start + i/64.0f;
+			frameBuffer.g[i] = 256 - frameBuffer.r[i];
+			frameBuffer.b[i] = frameBuffer.r[i]*0.5f;
+		}
+		writeFrames(&frameBuffer, frames.data(), 1);
+		for (int i = 0; i < frameBuffer.nPanels; i++){
+			bool ok = frames[i].r == expectedChannel(frameBuffer.r[i]) &&
+					frames[i].g == expectedChannel(frameBuffer.g[i]) && frames[i].b == expectedChannel(frameBuffer.b[i]);
+			nFailures += !ok;
+			CHECK(ok, "(%g, %g, %g) written as (%d, %d, %d)", frameBuffer.r[i], frameBuffer.g[i], frameBuffer.b[i],
+					frames[i].r, frames[i].g, frames[i].b);
+		}
+	}
+
+	clearFrameBuffer(&frameBuffer, 300, -4, 12.75f);
+	writeFrames(&frameBuffer, frames.data(), 1);
+	CHECK(frames[0].r == 255 && frames[0].g == 0 && frames[0].b == 12, "clearFrameBuffer");
+
+	freeLayoutData(smaller);
+	freeLayoutData(layout);
+	return CHECK_RESULT();
+}
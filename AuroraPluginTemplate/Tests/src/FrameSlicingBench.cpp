@@ -0,0 +1,61 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FrameSlicingBench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "FrameSlicing.h"
+#include "LayoutGenerator.h"
+
+/*
+ * Times the slicing of large generated square walls, the case the grid based slicer was written for, in both the
+ * array of FrameSlice_t and the flat table form. Rotated walls have a finer spacing and more slices
+ */
+
+static void benchWall(int nPanels, int angle){
+	LayoutData* layout = NULL;
+	generateLayoutData(SHAPE_SQUARE, nPanels, 1, &layout);
+	rotateAuroraPanels(layout, &angle);
+
+	FrameSlice_t* frameSlices = NULL;
+	int nFrameSlices = 0;
+	double arrayUs = timePerCall([&](){
+		getFrameSlicesFromLayout(layout, &frameSlices, &nFrameSlices);
+		freeFrameSlices(frameSlices);
+	}, 20);
+
+	FrameSliceTable_t table;
+	double tableUs = timePerCall([&](){
+		getFrameSliceTableFromLayout(layout, &table);
+	}, 20);
+
+	printf("%6d squares at %2d degrees: %5d slices, getFrameSlicesFromLayout %9.1f us, "
+			"getFrameSliceTableFromLayout %9.1f us\n", nPanels, angle, table.nSlices, arrayUs, tableUs);
+	freeLayoutData(layout);
+}
+
+int main(){
+	const int sizes[] = {1024, 4096, 16384};
+	for (int s = 0; s < 3; s++){
+		benchWall(sizes[s], 0);
+		benchWall(sizes[s], 30);
+	}
+	return 0;
+}
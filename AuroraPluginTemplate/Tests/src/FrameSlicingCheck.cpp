@@ -0,0 +1,113 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FrameSlicingCheck.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Check.h"
+#include "FrameSlicing.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <vector>
+
+/*
+ * getFrameSlicesFromLayout and getFrameSliceTableFromLayout on generated layouts at every orientation: both give the
+ * same slices in the same order, every panel is in the slice its centroid rounds to on the grid of
+ * getFrameSliceSpacing, and a table refilled with a smaller layout or an empty one stays consistent
+ */
+
+static void checkLayout(LayoutData* layout, const char* name, int angle, FrameSliceTable_t* table){
+	FrameSlice_t* slices = NULL;
+	int nSlices = 0;
+	getFrameSlicesFromLayout(layout, &slices, &nSlices);
+	getFrameSliceTableFromLayout(layout, table);
+
+	CHECK(table->nSlices == nSlices, "%s at %d: table has %d slices, array %d", name, angle, table->nSlices, nSlices);
+	CHECK(table->nPanelIds == layout->nPanels && table->offsets[0] == 0 && table->offsets[table->nSlices]
+			== layout->nPanels, "%s at %d: offsets do not span the %d panels", name, angle, layout->nPanels);
+	for (int s = 0; s < nSlices && s < table->nSlices; s++){
+		bool same = table->sliceSize(s) == (int)slices[s].panelIds.size();
+		for (int k = 0; same && k < table->sliceSize(s); k++){
+			same = table->panelIds[table->offsets[s] + k] == slices[s].panelIds[k];
+		}
+		CHECK(same, "%s at %d: slice %d differs between the table and the array", name, angle, s);
+	}
+
+	//brute force: the slice of every panel from its centroid
+	double spacing = getFrameSliceSpacing(layout);
+	double minX = INFINITY, maxX = -INFINITY;
+	for (int i = 0; i < layout->nPanels; i++){
+		minX = fmin(minX, layout->panels[i].shape->getCentroid().x);
+		maxX = fmax(maxX, layout->panels[i].shape->getCentroid().x);
+	}
+	CHECK(nSlices == (int)floor((maxX - minX)/spacing + 0.5) + 1, "%s at %d: %d slices for a width of %f", name,
+			angle, nSlices, maxX - minX);
+	std::vector<int> sliceOf(layout->nPanels + 1, -1);
+	for (int s = 0; s < table->nSlices; s++){
+		for (int k = table->offsets[s]; k < table->offsets[s + 1]; k++){
+			int panelId = table->panelIds[k];
+			CHECK(panelId >= 1 && panelId <= layout->nPanels && sliceOf[panelId] == -1, "%s at %d: panel %d twice",
+					name, angle, panelId);
+			if (panelId >= 1 && panelId <= layout->nPanels){
+				sliceOf[panelId] = s;
+			}
+		}
+	}
+	int nFailures = 0;
+	for (int i = 0; i < layout->nPanels && nFailures < 5; i++){
+		int expected = (int)floor((layout->panels[i].shape->getCentroid().x - minX)/spacing + 0.5);
+		expected = (expected >= nSlices) ? nSlices - 1 : expected;
+		int panelId = layout->panels[i].panelId;
+		nFailures += sliceOf[panelId] != expected;
+		CHECK(sliceOf[panelId] == expected, "%s at %d: panel %d in slice %d, its centroid is in slice %d", name, angle,
+				panelId, sliceOf[panelId], expected);
+	}
+	freeFrameSlices(slices);
+}
+
+int main(){
+	const int shapes[] = {SHAPE_TRIANGLE, SHAPE_SQUARE, LAYOUT_GENERATOR_MIXED};
+	const char* names[] = {"triangles", "squares", "mixed"};
+	const int sizes[] = {1, 2, 17, 300};
+	FrameSliceTable_t reused;
+	for (int t = 0; t < 3; t++){
+		for (int n = 3; n >= 0; n--){
+			LayoutData* layout = NULL;
+			generateLayoutData(shapes[t], sizes[n], 7 + n, &layout);
+			for (int angle = 0; angle < 360; angle += 30){
+				FrameSliceTable_t fresh;
+				checkLayout(layout, names[t], angle, &fresh);
+				//largest layouts first, so the reused table is refilled without growing
+				checkLayout(layout, names[t], angle, &reused);
+				int step = 30;
+				rotateAuroraPanels(layout, &step);
+			}
+			freeLayoutData(layout);
+		}
+	}
+
+	LayoutData empty;
+	FrameSliceTable_t table;
+	getFrameSliceTableFromLayout(&empty, &table);
+	CHECK(table.nSlices == 0 && table.nPanelIds == 0, "empty layout: %d slices", table.nSlices);
+	CHECK(table.offsets != NULL && table.offsets[0] == 0, "empty layout: offsets is not the single entry 0");
+	getFrameSliceTableFromLayout(&empty, &reused);
+	CHECK(reused.nSlices == 0 && reused.offsets[0] == 0, "empty layout in a used table: %d slices", reused.nSlices);
+	return CHECK_RESULT();
+}
@@ -0,0 +1,245 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutCacheCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "LayoutCache.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+/*the file layout of LayoutCache.cpp, used to damage specific fields*/
+#define HEADER_SIZE 32
+#define SECTION_ENTRY_SIZE 24
+#define SECTION_OFFSET_AT 8
+#define SECTION_SIZE_AT 16
+#define SECTION_SLICE_OFFSETS 2
+#define SECTION_SLICE_PANELIDS 3
+#define SECTION_NEIGHBOUR_INDICES 5
+#define SECTION_GRID 6
+
+static std::vector<char> readFile(const char* path){
+	std::vector<char> bytes;
+	FILE* fp = fopen(path, "rb");
+	if (fp){
+		char buffer[4096];
+		size_t n;
+		while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0){
+			bytes.insert(bytes.end(), buffer, buffer + n);
+		}
+		fclose(fp);
+	}
+	return bytes;
+}
+
+static void writeFile(const char* path, const std::vector<char>& bytes, size_t size){
+	FILE* fp = fopen(path, "wb");
+	fwrite(bytes.data(), 1, size, fp);
+	fclose(fp);
+}
+
+static bool sameArrays(const int* a, const int* b, int n){
+	return n == 0 || memcmp(a, b, n*sizeof(int)) == 0;
+}
+
+static bool sameDerivedData(const LayoutDerivedData_t& a, const LayoutDerivedData_t& b){
+	int nCells = a.grid.width*a.grid.height;
+	return a.nPanels == b.nPanels && a.nSlices == b.nSlices && a.grid.width == b.grid.width &&
+			a.grid.height == b.grid.height && a.grid.cellSize == b.grid.cellSize &&
+			sameArrays(a.sliceOffsets, b.sliceOffsets, a.nSlices + 1) &&
+			sameArrays(a.slicePanelIds, b.slicePanelIds, a.sliceOffsets[a.nSlices]) &&
+			sameArrays(a.neighbourOffsets, b.neighbourOffsets, a.nPanels + 1) &&
+			sameArrays(a.neighbourIndices, b.neighbourIndices, a.neighbourOffsets[a.nPanels]) &&
+			sameArrays(a.cellOffsets, b.cellOffsets, nCells + 1) &&
+			sameArrays(a.cellPanelIndices, b.cellPanelIndices, a.nPanels);
+}
+
+/**
+ * @description: writes a damaged copy of the cache and loads it. The load must miss, compute the same structures as
+ * buildLayoutDerivedData and leave a good cache behind
+ */
+static void checkDamaged(LayoutData* layout, const char* path, const std::vector<char>& bytes, size_t size,
+		const LayoutDerivedData_t& expected, const char* what){
+	writeFile(path, bytes, size);
+	LayoutDerivedData_t derived;
+	CHECK(loadLayoutDerivedData(layout, path, &derived) == LAYOUT_CACHE_MISS, "%s: the damaged cache was used", what);
+	CHECK(sameDerivedData(derived, expected), "%s: wrong structures after a miss", what);
+	CHECK(readFile(path).size() > HEADER_SIZE, "%s: cache not rewritten", what);
+}
+
+static void setSectionField(std::vector<char>& bytes, int tag, int field, uint64_t value){
+	memcpy(&bytes[HEADER_SIZE + (tag - 1)*SECTION_ENTRY_SIZE + field], &value, sizeof(value));
+}
+
+static uint64_t getSectionField(const std::vector<char>& bytes, int tag, int field){
+	uint64_t value;
+	memcpy(&value, &bytes[HEADER_SIZE + (tag - 1)*SECTION_ENTRY_SIZE + field], sizeof(value));
+	return value;
+}
+
+static int nOrientCalls = 0;
+
+//stands in for the search of a plugin like SoundBar's findMaxExpanse
+static int orientLayout(LayoutData* layoutData){
+	nOrientCalls++;
+	int angle = 90;
+	rotateAuroraPanels(layoutData, &angle);
+	return 90;
+}
+
+static bool sameCentroids(const LayoutData* a, const LayoutData* b){
+	for (int i = 0; i < a->nPanels; i++){
+		Point ca = a->panels[i].shape->getCentroid();
+		Point cb = b->panels[i].shape->getCentroid();
+		if (fabs(ca.x - cb.x) > 1e-3 || fabs(ca.y - cb.y) > 1e-3){
+			return false;
+		}
+	}
+	return a->nPanels == b->nPanels;
+}
+
+/**
+ * @description: a hit must turn the layout by the angle the miss remembered without calling orientLayout again
+ */
+static void checkOrientation(const char* path){
+	LayoutData* first = NULL;
+	LayoutData* second = NULL;
+	generateLayoutData(SHAPE_SQUARE, 25, 5, &first);
+	generateLayoutData(SHAPE_SQUARE, 25, 5, &second);
+	unlink(path);
+
+	LayoutDerivedData_t missed, hit;
+	CHECK(loadLayoutDerivedData(first, path, &missed, orientLayout) == LAYOUT_CACHE_MISS, "oriented: first load hit");
+	CHECK(nOrientCalls == 1 && missed.rotation == 90, "oriented: %d calls, rotation %d after a miss", nOrientCalls,
+			missed.rotation);
+	LayoutDerivedData_t expected;
+	buildLayoutDerivedData(first, &expected);
+	CHECK(sameDerivedData(missed, expected), "oriented: the structures are not the ones of the turned layout");
+
+	CHECK(loadLayoutDerivedData(second, path, &hit, orientLayout) == LAYOUT_CACHE_HIT, "oriented: second load missed");
+	CHECK(nOrientCalls == 1, "oriented: orientLayout called on a hit");
+	CHECK(hit.rotation == 90 && sameCentroids(first, second), "oriented: a hit did not turn the layout the same way");
+	CHECK(sameDerivedData(hit, expected), "oriented: wrong structures from the cache");
+
+	unlink(path);
+	freeLayoutData(first);
+	freeLayoutData(second);
+}
+
+int main(){
+	char dir[] = "/tmp/layoutCacheCheckXXXXXX";
+	CHECK(mkdtemp(dir) != NULL, "no temporary directory");
+	setenv("XDG_CACHE_HOME", dir, 1);
+
+	char path[1024];
+	CHECK(getLayoutCachePath("LayoutCacheCheck", path, sizeof(path)) == 0, "no cache path");
+	CHECK(path[0] == '/' && strstr(path, dir) == path, "cache path %s is not in %s", path, dir);
+	char shortPath[8];
+	CHECK(getLayoutCachePath("LayoutCacheCheck", shortPath, sizeof(shortPath)) == LAYOUT_CACHE_ERROR_NO_CACHE_DIR,
+			"a truncated path was accepted");
+	unsetenv("XDG_CACHE_HOME");
+	setenv("HOME", "relative", 1);
+	CHECK(getLayoutCachePath("LayoutCacheCheck", shortPath, sizeof(shortPath)) == LAYOUT_CACHE_ERROR_NO_CACHE_DIR,
+			"a relative cache dir was accepted");
+	setenv("XDG_CACHE_HOME", dir, 1);
+
+	LayoutData* layout = NULL;
+	generateLayoutData(LAYOUT_GENERATOR_MIXED, 40, 3, &layout);
+	LayoutDerivedData_t expected;
+	buildLayoutDerivedData(layout, &expected);
+
+	{
+		LayoutDerivedData_t derived;
+		CHECK(loadLayoutDerivedData(layout, "relative.layoutcache", &derived) == LAYOUT_CACHE_MISS, "relative path hit");
+		CHECK(access("relative.layoutcache", F_OK) != 0, "a cache was written to the working directory");
+		CHECK(sameDerivedData(derived, expected), "wrong structures without a cache");
+		CHECK(loadLayoutDerivedData(layout, path, &derived) == LAYOUT_CACHE_MISS, "first load hit");
+		CHECK(loadLayoutDerivedData(layout, path, &derived) == LAYOUT_CACHE_HIT, "second load missed");
+		CHECK(derived.mapping != NULL && sameDerivedData(derived, expected), "wrong structures from the cache");
+	}
+
+	const std::vector<char> good = readFile(path);
+	for (size_t size = 0; size < good.size(); size += 4){
+		checkDamaged(layout, path, good, size, expected, "truncated");
+	}
+
+	std::vector<char> bad = good;
+	setSectionField(bad, SECTION_NEIGHBOUR_INDICES, SECTION_OFFSET_AT, ~(uint64_t)7);
+	checkDamaged(layout, path, bad, bad.size(), expected, "offset wrapping around");
+	bad = good;
+	setSectionField(bad, SECTION_NEIGHBOUR_INDICES, SECTION_OFFSET_AT, good.size());
+	checkDamaged(layout, path, bad, bad.size(), expected, "offset past the end");
+	bad = good;
+	setSectionField(bad, SECTION_NEIGHBOUR_INDICES, SECTION_SIZE_AT, ~(uint64_t)0);
+	checkDamaged(layout, path, bad, bad.size(), expected, "huge size");
+
+	//a neighbour index past the panels
+	bad = good;
+	uint64_t neighboursAt = getSectionField(good, SECTION_NEIGHBOUR_INDICES, SECTION_OFFSET_AT);
+	int index = layout->nPanels;
+	memcpy(&bad[neighboursAt], &index, sizeof(index));
+	checkDamaged(layout, path, bad, bad.size(), expected, "neighbour index out of range");
+
+	//slice offsets ending past the panels, with a panel id section grown to match
+	bad = good;
+	uint64_t sliceOffsetsAt = getSectionField(good, SECTION_SLICE_OFFSETS, SECTION_OFFSET_AT);
+	int end = layout->nPanels + 1;
+	memcpy(&bad[sliceOffsetsAt + expected.nSlices*sizeof(int)], &end, sizeof(end));
+	setSectionField(bad, SECTION_SLICE_PANELIDS, SECTION_SIZE_AT, end*sizeof(int));
+	checkDamaged(layout, path, bad, bad.size(), expected, "slice offsets past the panels");
+
+	//a grid with more cells than the file could hold
+	bad = good;
+	uint64_t gridAt = getSectionField(good, SECTION_GRID, SECTION_OFFSET_AT);
+	LayoutGrid_t grid;
+	memcpy(&grid, &bad[gridAt], sizeof(grid));
+	grid.width = 1 << 20;
+	grid.height = 1 << 20;
+	memcpy(&bad[gridAt], &grid, sizeof(grid));
+	checkDamaged(layout, path, bad, bad.size(), expected, "huge grid");
+
+	//every single flipped byte must either be caught or leave structures whose indices are all usable
+	for (size_t i = 0; i < good.size(); i++){
+		bad = good;
+		bad[i] ^= 0x5A;
+		writeFile(path, bad, bad.size());
+		LayoutDerivedData_t derived;
+		if (loadLayoutDerivedData(layout, path, &derived) == LAYOUT_CACHE_HIT){
+			int nCells = derived.grid.width*derived.grid.height;
+			bool usable = derived.cellOffsets[nCells] == derived.nPanels &&
+					derived.sliceOffsets[derived.nSlices] == derived.nPanels;
+			for (int k = 0; k < derived.neighbourOffsets[derived.nPanels]; k++){
+				usable = usable && derived.neighbourIndices[k] >= 0 && derived.neighbourIndices[k] < derived.nPanels;
+			}
+			CHECK(usable, "byte %zu flipped: unusable structures were mapped", i);
+		}
+	}
+
+	checkOrientation(path);
+
+	unlink(path);
+	rmdir(dir);
+	freeLayoutData(layout);
+	return CHECK_RESULT();
+}
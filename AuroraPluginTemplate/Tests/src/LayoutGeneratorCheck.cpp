@@ -0,0 +1,132 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutGeneratorCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <set>
+
+/*positions are integers, so vertices computed from them are off by up to about half a unit*/
+#define VERTEX_TOLERANCE 1.0
+
+static bool samePoint(const Point& a, const Point& b){
+	return fabs(a.x - b.x) <= VERTEX_TOLERANCE && fabs(a.y - b.y) <= VERTEX_TOLERANCE;
+}
+
+static bool shareEdge(const Shape* a, const Shape* b){
+	for (int i = 0; i < a->nVertices; i++){
+		const Point& a1 = a->vertices[i];
+		const Point& a2 = a->vertices[(i + 1) % a->nVertices];
+		for (int k = 0; k < b->nVertices; k++){
+			const Point& b1 = b->vertices[k];
+			const Point& b2 = b->vertices[(k + 1) % b->nVertices];
+			if ((samePoint(a1, b1) && samePoint(a2, b2)) || (samePoint(a1, b2) && samePoint(a2, b1))){
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/*strictly inside, i.e. further than VERTEX_TOLERANCE from every edge*/
+static bool isDeepInside(const Shape* shape, const Point& p){
+	for (int i = 0; i < shape->nVertices; i++){
+		const Point& a = shape->vertices[i];
+		const Point& b = shape->vertices[(i + 1) % shape->nVertices];
+		double cross = (b.x - a.x)*(p.y - a.y) - (b.y - a.y)*(p.x - a.x);
+		if (cross < VERTEX_TOLERANCE*hypot(b.x - a.x, b.y - a.y)){
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool overlap(const Shape* a, const Shape* b){
+	if (isDeepInside(a, b->getCentroid()) || isDeepInside(b, a->getCentroid())){
+		return true;
+	}
+	for (int i = 0; i < b->nVertices; i++){
+		if (isDeepInside(a, b->vertices[i])){
+			return true;
+		}
+	}
+	for (int i = 0; i < a->nVertices; i++){
+		if (isDeepInside(b, a->vertices[i])){
+			return true;
+		}
+	}
+	return false;
+}
+
+static void checkLayout(int shapeType, int nPanels, unsigned int seed){
+	LayoutData* layout = NULL;
+	int n = generateLayoutData(shapeType, nPanels, seed, &layout);
+	CHECK(n == nPanels, "type %d: %d panels instead of %d", shapeType, n, nPanels);
+
+	std::set<int> ids;
+	int nTriangleOnSquare = 0;
+	for (int i = 0; i < layout->nPanels; i++){
+		ids.insert(layout->panels[i].panelId);
+		const Shape* shape = layout->panels[i].shape;
+		bool connected = (layout->nPanels == 1);
+		for (int k = 0; k < layout->nPanels; k++){
+			if (k == i){
+				continue;
+			}
+			const Shape* other = layout->panels[k].shape;
+			if (Point::distance(shape->getCentroid(), other->getCentroid()) > 2*Shape::sideLength){
+				continue;
+			}
+			if (shareEdge(shape, other)){
+				connected = true;
+				nTriangleOnSquare += (shape->shapeType == SHAPE_TRIANGLE && other->shapeType == SHAPE_SQUARE);
+			}
+			CHECK(k < i || !overlap(shape, other), "type %d seed %u: panels %d and %d overlap", shapeType, seed,
+					layout->panels[i].panelId, layout->panels[k].panelId);
+		}
+		CHECK(connected, "type %d seed %u: panel %d shares no full edge", shapeType, seed, layout->panels[i].panelId);
+	}
+	CHECK((int)ids.size() == n && *ids.begin() == 1 && *ids.rbegin() == n, "type %d: panelIds not 1 ... n",
+			shapeType);
+	if (shapeType == LAYOUT_GENERATOR_MIXED && nPanels >= 2){
+		CHECK(nTriangleOnSquare >= 1, "seed %u: no triangle stands on a square", seed);
+	}
+	freeLayoutData(layout);
+}
+
+int main(){
+	const int types[] = {SHAPE_TRIANGLE, SHAPE_SQUARE, LAYOUT_GENERATOR_MIXED};
+	for (int t = 0; t < 3; t++){
+		for (unsigned int seed = 1; seed <= 20; seed++){
+			checkLayout(types[t], 1 + seed*17 % 300, seed);
+		}
+	}
+
+	std::vector<int> a, b, c;
+	generateLayoutByteStream(LAYOUT_GENERATOR_MIXED, 200, 7, &a);
+	generateLayoutByteStream(LAYOUT_GENERATOR_MIXED, 200, 7, &b);
+	generateLayoutByteStream(LAYOUT_GENERATOR_MIXED, 200, 8, &c);
+	CHECK(a == b, "the same seed gave different layouts");
+	CHECK(a != c, "different seeds gave the same layout");
+	CHECK(generateLayoutByteStream(SHAPE_RHYTHM, 10, 1, &a) == -1, "unsupported shape type accepted");
+	return CHECK_RESULT();
+}
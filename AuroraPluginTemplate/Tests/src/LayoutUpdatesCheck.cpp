@@ -0,0 +1,258 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutUpdatesCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "LibraryStubs.h"
+#include "LayoutUpdates.h"
+#include "LayoutGenerator.h"
+#include "SweepIndex.h"
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+#define POSITION_TOLERANCE 1e-6
+#define HOST_UPDATES 200				/*lists sent by the host thread while the frame thread applies them*/
+
+/*raw positionData of every panel, kept up to date with the deltas, as the host would*/
+typedef std::map<int, LayoutDelta_t> RawLayout;
+
+static std::atomic<int> nLayoutChangedCalls(0);
+static int pluginRotation = 0;
+static LayoutDeltaQueue deltaQueue;
+
+//as a plugin does it: the host thread only queues, the frame thread applies in applyPendingDeltas
+void pluginLayoutChanged(LayoutData* layoutData, const LayoutDelta_t* deltas, int nDeltas){
+	nLayoutChangedCalls++;
+	deltaQueue.push(deltas, nDeltas);
+}
+
+static int applyPendingDeltas(LayoutData* layout){
+	static std::vector<LayoutDelta_t> deltas;
+	int nDeltas = deltaQueue.take(&deltas);
+	if (nDeltas > 0 && applyLayoutDeltas(layout, deltas.data(), nDeltas, pluginRotation) != 0){
+		return -1;
+	}
+	return nDeltas;
+}
+
+static std::vector<int> toStream(const LayoutDelta_t* deltas, int nDeltas){
+	std::vector<int> stream;
+	for (int i = 0; i < nDeltas; i++){
+		const LayoutDelta_t& d = deltas[i];
+		int ints[LAYOUT_DELTA_INTS] = {d.type, d.panelId, d.x, d.y, d.orientation, d.shapeType};
+		stream.insert(stream.end(), ints, ints + LAYOUT_DELTA_INTS);
+	}
+	return stream;
+}
+
+static void applyToRaw(RawLayout& raw, const LayoutDelta_t* deltas, int nDeltas){
+	for (int i = 0; i < nDeltas; i++){
+		if (deltas[i].type == LAYOUT_DELTA_REMOVE){
+			raw.erase(deltas[i].panelId);
+		}
+		else {
+			int shapeType = raw.count(deltas[i].panelId) ? raw[deltas[i].panelId].shapeType : deltas[i].shapeType;
+			raw[deltas[i].panelId] = deltas[i];
+			raw[deltas[i].panelId].shapeType = shapeType;
+		}
+	}
+}
+
+/**
+ * @description: checks that every panel of the layout sits where the raw layout, turned by rotation around center,
+ * puts it, with the orientation turned by the same angle
+ */
+static void checkMatchesRaw(LayoutData* layout, const RawLayout& raw, const Point& center, int rotation,
+		const char* what){
+	CHECK(layout->nPanels == (int)raw.size(), "%s: %d panels instead of %d", what, layout->nPanels, (int)raw.size());
+	for (int i = 0; i < layout->nPanels; i++){
+		RawLayout::const_iterator it = raw.find(layout->panels[i].panelId);
+		if (it == raw.end()){
+			CHECK(false, "%s: panel %d should not exist", what, layout->panels[i].panelId);
+			continue;
+		}
+		double a = rotation*M_PI/180;
+		double dx = it->second.x - center.x, dy = it->second.y - center.y;
+		double x = center.x + dx*cos(a) - dy*sin(a);
+		double y = center.y + dx*sin(a) + dy*cos(a);
+		const Shape* shape = layout->panels[i].shape;
+		CHECK(fabs(shape->getCentroid().x - x) < POSITION_TOLERANCE && fabs(shape->getCentroid().y - y) < POSITION_TOLERANCE,
+				"%s: panel %d at (%g, %g) instead of (%g, %g)", what, it->first, shape->getCentroid().x,
+				shape->getCentroid().y, x, y);
+		CHECK(((shape->getOrientation() - it->second.orientation - rotation) % 360 + 360) % 360 == 0,
+				"%s: panel %d has orientation %d", what, it->first, shape->getOrientation());
+	}
+}
+
+static std::vector<int> sweepPanels(SweepIndex& index, degrees angle){
+	const int* panelIds = NULL;
+	int n = index.getPanelsInRange(angle, -1e9, 1e9, &panelIds);
+	std::vector<int> sorted(panelIds, panelIds + n);
+	std::sort(sorted.begin(), sorted.end());
+	return sorted;
+}
+
+int main(){
+	std::vector<int> stream;
+	int nPanels = generateLayoutByteStream(SHAPE_SQUARE, 30, 5, &stream);
+	RawLayout raw;
+	for (int i = 0; i < nPanels; i++){
+		const int* p = &stream[i*LAYOUT_STREAM_INTS_PER_PANEL];
+		LayoutDelta_t panel = {LAYOUT_DELTA_ADD, p[0], p[1], p[2], p[3], p[4]};
+		raw[p[0]] = panel;
+	}
+	LayoutData* layout = NULL;
+	parseLayoutData(stream.data(), nPanels, &layout);
+	setStubLayoutData(layout);
+	const Point center = layout->layoutGeometricCenter;
+
+	//the plugin turns its layout by 90 degrees before any change arrives
+	pluginRotation = 90;
+	rotateAuroraPanels(layout, &pluginRotation);
+	SweepIndex sweep(layout);
+	sweepPanels(sweep, 45);	//a cached direction, patched by the deltas below
+
+	//deltas use the raw coordinates of the stream, not the rotated ones
+	int side = LAYOUT_GENERATOR_SIDE;
+	int farX = 0;
+	for (RawLayout::iterator it = raw.begin(); it != raw.end(); ++it){
+		farX = std::max(farX, it->second.x);
+	}
+	LayoutDelta_t deltas[] = {
+		{LAYOUT_DELTA_ADD, 1000, farX + side, raw[1].y, 0, SHAPE_SQUARE},
+		{LAYOUT_DELTA_REMOVE, 2, 0, 0, 0, 0},
+		{LAYOUT_DELTA_MOVE, 3, farX + 2*side, raw[1].y, 90, 0},
+	};
+	int streamDeltas[3*LAYOUT_DELTA_INTS];
+	for (int i = 0; i < 3; i++){
+		const LayoutDelta_t& d = deltas[i];
+		int ints[LAYOUT_DELTA_INTS] = {d.type, d.panelId, d.x, d.y, d.orientation, d.shapeType};
+		std::copy(ints, ints + LAYOUT_DELTA_INTS, &streamDeltas[i*LAYOUT_DELTA_INTS]);
+	}
+
+	//a bad list is rejected as a whole, without calling the plugin
+	LayoutDelta_t bad[] = {deltas[0], {LAYOUT_DELTA_REMOVE, 4242, 0, 0, 0, 0}};
+	int badStream[2*LAYOUT_DELTA_INTS] = {
+		bad[0].type, bad[0].panelId, bad[0].x, bad[0].y, bad[0].orientation, bad[0].shapeType,
+		bad[1].type, bad[1].panelId, 0, 0, 0, 0
+	};
+	CHECK(passLayoutDeltas(badStream, 2) == LAYOUT_UPDATE_ERROR_PANEL_NO_EXIST, "a missing panel was accepted");
+	CHECK(nLayoutChangedCalls == 0, "the plugin was called with rejected deltas");
+	checkMatchesRaw(layout, raw, center, 90, "after a rejected update");
+
+	CHECK(passLayoutDeltas(streamDeltas, 3) == 0, "valid deltas rejected");
+	CHECK(nLayoutChangedCalls == 1, "the plugin was called %d times", nLayoutChangedCalls.load());
+	checkMatchesRaw(layout, raw, center, 90, "before the frame applied the update");
+	CHECK(applyPendingDeltas(layout) == 3, "the queued deltas were not taken");
+	CHECK(applyPendingDeltas(layout) == 0, "deltas taken twice");
+	applyToRaw(raw, deltas, 3);
+	checkMatchesRaw(layout, raw, center, 90, "after the update");
+	CHECK(layout->layoutGeometricCenter.x == center.x && layout->layoutGeometricCenter.y == center.y,
+			"the rotation center moved");
+
+	//the added panel lines up with the rotated layout: it touches the panel it was placed next to
+	const Shape* added = layout->panels[layout->nPanels - 1].shape;
+	int nTouching = 0;
+	for (int i = 0; i < layout->nPanels - 1; i++){
+		double d = Point::distance(added->getCentroid(), layout->panels[i].shape->getCentroid());
+		nTouching += fabs(d - side) < POSITION_TOLERANCE;
+	}
+	CHECK(nTouching >= 1, "the added panel touches no panel");
+
+	//the sweep index patched with the same deltas matches one built from the updated layout
+	sweep.applyLayoutDeltas(layout, deltas, 3, pluginRotation);
+	SweepIndex rebuilt(layout);
+	const degrees angles[] = {0, 45, 90, 200};
+	for (int a = 0; a < 4; a++){
+		CHECK(sweepPanels(sweep, angles[a]) == sweepPanels(rebuilt, angles[a]), "sweep at %g differs", angles[a]);
+		double minA, maxA, minB, maxB;
+		sweep.getExtent(angles[a], &minA, &maxA);
+		rebuilt.getExtent(angles[a], &minB, &maxB);
+		CHECK(fabs(minA - minB) < POSITION_TOLERANCE && fabs(maxA - maxB) < POSITION_TOLERANCE,
+				"extent at %g differs", angles[a]);
+	}
+
+	//after another turn of the plugin, new deltas still land where the raw layout says
+	int angle = 30;
+	rotateAuroraPanels(layout, &angle);
+	pluginRotation += angle;
+	LayoutDelta_t more[] = {{LAYOUT_DELTA_MOVE, 1000, farX + side, raw[1].y - side, 0, 0}};
+	CHECK(applyLayoutDeltas(layout, more, 1, pluginRotation) == 0, "second update rejected");
+	applyToRaw(raw, more, 1);
+	checkMatchesRaw(layout, raw, center, 120, "after a second rotation");
+
+	//a list sent before the frame applied the previous one is validated against the panels that one leaves
+	LayoutDelta_t first[] = {{LAYOUT_DELTA_ADD, 2000, farX + 3*side, raw[1].y, 0, SHAPE_SQUARE}};
+	LayoutDelta_t second[] = {{LAYOUT_DELTA_MOVE, 2000, farX + 3*side, raw[1].y + side, 0, 0},
+			{LAYOUT_DELTA_REMOVE, 1000, 0, 0, 0, 0}};
+	LayoutDelta_t third[] = {{LAYOUT_DELTA_MOVE, 1000, farX, raw[1].y, 0, 0}};
+	std::vector<int> firstStream = toStream(first, 1), secondStream = toStream(second, 2);
+	std::vector<int> thirdStream = toStream(third, 1);
+	CHECK(passLayoutDeltas(firstStream.data(), 1) == 0, "queued add rejected");
+	CHECK(passLayoutDeltas(secondStream.data(), 2) == 0, "a move of a queued add rejected");
+	CHECK(passLayoutDeltas(thirdStream.data(), 1) == LAYOUT_UPDATE_ERROR_PANEL_NO_EXIST,
+			"a move of a panel removed by a queued list was accepted");
+	CHECK(applyPendingDeltas(layout) == 3, "the queued lists were not taken in one piece");
+	applyToRaw(raw, first, 1);
+	applyToRaw(raw, second, 2);
+	checkMatchesRaw(layout, raw, center, 120, "after queued lists");
+
+	//the host sends lists while the frame thread applies them: every list arrives, in order
+	std::vector<LayoutDelta_t> hostDeltas;
+	for (int k = 0; k < HOST_UPDATES; k++){
+		LayoutDelta_t move = {LAYOUT_DELTA_MOVE, 2000, farX + 3*side, raw[1].y + (k % 7)*side, 90*(k % 4), 0};
+		LayoutDelta_t change = (k % 2 == 0) ? LayoutDelta_t{LAYOUT_DELTA_ADD, 3000 + k, farX + 4*side, raw[1].y, 0,
+				SHAPE_SQUARE} : LayoutDelta_t{LAYOUT_DELTA_REMOVE, 3000 + k - 1, 0, 0, 0, 0};
+		hostDeltas.push_back(move);
+		hostDeltas.push_back(change);
+	}
+	std::atomic<int> nRejected(0);
+	std::atomic<bool> isHostDone(false);
+	std::thread host([&](){
+		for (int k = 0; k < HOST_UPDATES; k++){
+			std::vector<int> listStream = toStream(&hostDeltas[2*k], 2);
+			nRejected += passLayoutDeltas(listStream.data(), 2) != 0;
+			std::this_thread::yield();
+		}
+		isHostDone = true;
+	});
+	int nApplied = 0, nFailed = 0;
+	for (bool isLast = false; !isLast;){
+		isLast = isHostDone;
+		int n = applyPendingDeltas(layout);
+		nFailed += (n < 0);
+		nApplied += (n > 0) ? n : 0;
+		std::this_thread::yield();
+	}
+	host.join();
+	CHECK(nRejected == 0 && nFailed == 0, "%d lists rejected, %d failed to apply", nRejected.load(), nFailed);
+	CHECK(nApplied == 2*HOST_UPDATES, "%d of %d deltas applied", nApplied, 2*HOST_UPDATES);
+	applyToRaw(raw, hostDeltas.data(), hostDeltas.size());
+	checkMatchesRaw(layout, raw, center, 120, "after updates from the host thread");
+
+	setStubLayoutData(NULL);
+	freeLayoutData(layout);
+	return CHECK_RESULT();
+}
@@ -0,0 +1,225 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LibraryStubs.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "LibraryStubs.h"
+#include "DataManager.h"
+#include <math.h>
+#include <stdio.h>
+
+int Shape::sideLength = 150;
+
+Point::Point() : x(0), y(0){
+}
+
+Point::Point(double _x, double _y) : x(_x), y(_y){
+}
+
+Point Point::operator+(Point p2){
+	return Point(x + p2.x, y + p2.y);
+}
+
+Point Point::operator-(Point p2){
+	return Point(x - p2.x, y - p2.y);
+}
+
+void Point::ToInt(int* _x, int* _y){
+	*_x = (int)lround(x);
+	*_y = (int)lround(y);
+}
+
+Point Point::rotate(degrees angle){
+	double a = degs2rads(angle);
+	return Point(x*cos(a) - y*sin(a), x*sin(a) + y*cos(a));
+}
+
+std::string Point::ToString(){
+	char text[64];
+	snprintf(text, sizeof(text), "(%f, %f)", x, y);
+	return text;
+}
+
+double Point::distance(Point P1, Point P2){
+	return hypot(P1.x - P2.x, P1.y - P2.y);
+}
+
+double degs2rads(double degs){
+	return degs*M_PI/180;
+}
+
+Shape::Shape() : orientation(0), vertices(NULL), nVertices(0), area(0), shapeType(0){
+}
+
+Shape::~Shape(){
+	delete [] vertices;
+}
+
+const Point& Shape::getCentroid() const {
+	return centroid;
+}
+
+int Shape::getOrientation() const {
+	return orientation;
+}
+
+/**
+ * A regular polygon standing in for the triangle, square and rhythm shapes of the library
+ */
+class StubPolygon : public Shape {
+	void computeVertices(){
+		double circumradius = sideLength/(2*sin(M_PI/nVertices));
+		double firstAngle = (nVertices == 3) ? 90 : 45;
+		for (int i = 0; i < nVertices; i++){
+			double a = degs2rads(firstAngle + orientation + 360.0*i/nVertices);
+			vertices[i] = Point(centroid.x + circumradius*cos(a), centroid.y + circumradius*sin(a));
+		}
+	}
+
+public:
+	StubPolygon(int shapeType, Point centroid, int orientation){
+		this->shapeType = shapeType;
+		this->centroid = centroid;
+		this->orientation = orientation;
+		nVertices = (shapeType == SHAPE_SQUARE) ? 4 : 3;
+		vertices = new Point[nVertices];
+		area = nVertices*sideLength*sideLength/(4*tan(M_PI/nVertices));
+		computeVertices();
+	}
+
+	bool isPointInsideShape(Point p){
+		for (int i = 0; i < nVertices; i++){
+			const Point& a = vertices[i];
+			const Point& b = vertices[(i + 1) % nVertices];
+			if ((b.x - a.x)*(p.y - a.y) - (b.y - a.y)*(p.x - a.x) < 0){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void updateShape(Point* centroid, int* orientation){
+		if (centroid){
+			this->centroid = *centroid;
+		}
+		if (orientation){
+			this->orientation = *orientation;
+		}
+		computeVertices();
+	}
+};
+
+void parseLayoutData(int* layoutDataByteStream, int nPanels, LayoutData** layoutData){
+	LayoutData* layout = new LayoutData();
+	layout->nPanels = nPanels;
+	layout->panels = (nPanels > 0) ? new Panel[nPanels] : NULL;
+	double cx = 0, cy = 0;
+	for (int i = 0; i < nPanels; i++){
+		const int* p = layoutDataByteStream + 5*i;
+		layout->panels[i].panelId = p[0];
+		layout->panels[i].shape = new StubPolygon(p[4], Point(p[1], p[2]), p[3]);
+		cx += p[1];
+		cy += p[2];
+	}
+	if (nPanels > 0){
+		layout->layoutGeometricCenter = Point(cx/nPanels, cy/nPanels);
+	}
+	*layoutData = layout;
+}
+
+int rotateAuroraPanels(LayoutData* layoutData, int* angle_degrees){
+	int angle = (int)lround(*angle_degrees/30.0)*30;
+	*angle_degrees = angle;
+	Point center = layoutData->layoutGeometricCenter;
+	for (int i = 0; i < layoutData->nPanels; i++){
+		Shape* shape = layoutData->panels[i].shape;
+		Point centroid = shape->getCentroid();
+		centroid = (centroid - center).rotate(angle) + center;
+		int orientation = shape->getOrientation() + angle;
+		shape->updateShape(&centroid, &orientation);
+	}
+	return 0;
+}
+
+bool isPointInsidePanel(Panel* panel, Point p){
+	return panel->shape->isPointInsideShape(p);
+}
+
+int pointInsideWhichPanel(LayoutData* layoutData, Point p){
+	for (int i = 0; i < layoutData->nPanels; i++){
+		if (isPointInsidePanel(&layoutData->panels[i], p)){
+			return layoutData->panels[i].panelId;
+		}
+	}
+	return -1;
+}
+
+void freeLayoutData(LayoutData* layoutData){
+	delete layoutData;
+}
+
+void freeFrameSlices(FrameSlice_t* frameSlices){
+	delete [] frameSlices;
+}
+
+static LayoutData* stubLayoutData = NULL;
+static RGB_t* stubPalette = NULL;
+static int stubNColors = 0;
+
+void setStubLayoutData(LayoutData* layoutData){
+	stubLayoutData = layoutData;
+}
+
+void setStubColorPalette(RGB_t* palette, int nColors){
+	stubPalette = palette;
+	stubNColors = nColors;
+}
+
+LayoutData* getLayoutData(){
+	return stubLayoutData;
+}
+
+void getColorPalette(RGB_t** palette, int* nColors){
+	*palette = stubPalette;
+	*nColors = stubNColors;
+}
+
+void HSVtoRGB(HSV_t hsv, RGB_t* rgb){
+	double h = fmod(fmod(hsv.H, 360.0) + 360.0, 360.0);
+	double s = fmin(fmax(hsv.S, 0), 100)/100.0, v = fmin(fmax(hsv.V, 0), 100)/100.0;
+	double c = v*s, x = c*(1 - fabs(fmod(h/60, 2) - 1)), m = v - c;
+	int region = (int)(h/60);
+	const double r[6] = {c, x, 0, 0, x, c}, g[6] = {x, c, c, x, 0, 0}, b[6] = {0, 0, x, c, c, x};
+	rgb->R = (int)lround((r[region] + m)*255);
+	rgb->G = (int)lround((g[region] + m)*255);
+	rgb->B = (int)lround((b[region] + m)*255);
+}
+
+void RGBtoHSV(RGB_t rgb, HSV_t* hsv){
+	double r = rgb.R/255.0, g = rgb.G/255.0, b = rgb.B/255.0;
+	double max = fmax(r, fmax(g, b)), min = fmin(r, fmin(g, b)), c = max - min;
+	double h = 0;
+	if (c > 0){
+		h = (max == r) ? fmod((g - b)/c + 6, 6) : ((max == g) ? (b - r)/c + 2 : (r - g)/c + 4);
+	}
+	hsv->H = (int)lround(60*h) % 360;
+	hsv->S = (max > 0) ? (int)lround(100*c/max) : 0;
+	hsv->V = (int)lround(100*max);
+}
@@ -0,0 +1,120 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * OKLabCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "OKLab.h"
+#include <math.h>
+#include <limits.h>
+
+/*
+ * Checks the OKLab conversions against the reference values of the OKLab definition, that sRGB colors survive the
+ * round trips through OKLab and OKLCh unchanged, and the interpolation rules
+ */
+
+#define LAB_TOLERANCE 1e-4
+
+static bool sameRgb(const RGB_t& a, const RGB_t& b){
+	return a.R == b.R && a.G == b.G && a.B == b.B;
+}
+
+static bool nearLab(const OKLab_t& lab, double L, double a, double b){
+	return fabs(lab.L - L) < LAB_TOLERANCE && fabs(lab.a - a) < LAB_TOLERANCE && fabs(lab.b - b) < LAB_TOLERANCE;
+}
+
+static void checkRoundTrips(int r, int g, int b, int* nFailures){
+	RGB_t rgb = {r, g, b}, viaLab, viaLch;
+	OKLab_t lab, labBack;
+	OKLCh_t lch;
+	RGBtoOKLab(rgb, &lab);
+	OKLabtoRGB(lab, &viaLab);
+	OKLabtoOKLCh(lab, &lch);
+	OKLChtoOKLab(lch, &labBack);
+	OKLabtoRGB(labBack, &viaLch);
+	bool ok = sameRgb(rgb, viaLab) && sameRgb(rgb, viaLch) && lch.h >= 0 && lch.h < 360 && lch.C >= 0;
+	*nFailures += !ok;
+	CHECK(ok, "(%d, %d, %d) comes back as (%d, %d, %d) through OKLab, (%d, %d, %d) through OKLCh, hue %g", r, g, b,
+			viaLab.R, viaLab.G, viaLab.B, viaLch.R, viaLch.G, viaLch.B, lch.h);
+}
+
+int main(){
+	//reference values from the definition of OKLab
+	OKLab_t lab;
+	RGBtoOKLab(RGB_t{255, 255, 255}, &lab);
+	CHECK(nearLab(lab, 1, 0, 0), "white is (%g, %g, %g)", lab.L, lab.a, lab.b);
+	RGBtoOKLab(RGB_t{0, 0, 0}, &lab);
+	CHECK(nearLab(lab, 0, 0, 0), "black is (%g, %g, %g)", lab.L, lab.a, lab.b);
+	RGBtoOKLab(RGB_t{255, 0, 0}, &lab);
+	CHECK(nearLab(lab, 0.627955, 0.224863, 0.125846), "red is (%g, %g, %g)", lab.L, lab.a, lab.b);
+	RGBtoOKLab(RGB_t{0, 255, 0}, &lab);
+	CHECK(nearLab(lab, 0.866440, -0.233888, 0.179498), "green is (%g, %g, %g)", lab.L, lab.a, lab.b);
+	RGBtoOKLab(RGB_t{0, 0, 255}, &lab);
+	CHECK(nearLab(lab, 0.452014, -0.032457, -0.311528), "blue is (%g, %g, %g)", lab.L, lab.a, lab.b);
+
+	//round trips of a grid over the cube plus every grey and every value on the edges from black
+	int nFailures = 0;
+	for (int r = 0; r < 256 && nFailures < 10; r += 5){
+		for (int g = 0; g < 256 && nFailures < 10; g += 3){
+			for (int b = 0; b < 256 && nFailures < 10; b++){
+				checkRoundTrips(r, g, b, &nFailures);
+			}
+		}
+	}
+	for (int v = 0; v < 256; v++){
+		checkRoundTrips(v, v, v, &nFailures);
+		checkRoundTrips(v, 0, 0, &nFailures);
+		checkRoundTrips(0, v, 0, &nFailures);
+		checkRoundTrips(0, 0, v, &nFailures);
+		checkRoundTrips(255, v, 255 - v, &nFailures);
+	}
+
+	//out of range input is clamped, colors outside sRGB come back clamped
+	OKLab_t clampedLab;
+	RGBtoOKLab(RGB_t{300, -20, INT_MAX}, &lab);
+	RGBtoOKLab(RGB_t{255, 0, 255}, &clampedLab);
+	CHECK(nearLab(lab, clampedLab.L, clampedLab.a, clampedLab.b), "RGB input not clamped");
+	RGB_t rgb;
+	OKLabtoRGB(OKLab_t{0.9, 0.4, 0.4}, &rgb);
+	CHECK(rgb.R >= 0 && rgb.R <= 255 && rgb.G >= 0 && rgb.G <= 255 && rgb.B >= 0 && rgb.B <= 255,
+			"out of gamut gives (%d, %d, %d)", rgb.R, rgb.G, rgb.B);
+
+	//interpolation
+	OKLab_t red, blue;
+	RGBtoOKLab(RGB_t{255, 0, 0}, &red);
+	RGBtoOKLab(RGB_t{0, 0, 255}, &blue);
+	OKLab_t mid = mixOKLab(red, blue, 0.5);
+	CHECK(nearLab(mixOKLab(red, blue, 0), red.L, red.a, red.b) && nearLab(mixOKLab(red, blue, 1), blue.L, blue.a, blue.b),
+			"mixOKLab endpoints");
+	CHECK(nearLab(mid, (red.L + blue.L)/2, (red.a + blue.a)/2, (red.b + blue.b)/2), "mixOKLab midpoint");
+
+	OKLCh_t from = {0.5, 0.1, 350}, to = {0.7, 0.2, 10};
+	OKLCh_t lch = mixOKLCh(from, to, 0.5);
+	CHECK(fabs(lch.L - 0.6) < 1e-9 && fabs(lch.C - 0.15) < 1e-9 && (lch.h < 1e-9 || lch.h > 360 - 1e-9),
+			"350 to 10 degrees does not cross 0: hue %g", lch.h);
+	lch = mixOKLCh(to, from, 0.25);
+	CHECK(fabs(lch.h - 5) < 1e-9, "10 to 350 degrees at 0.25: hue %g", lch.h);
+	OKLCh_t grey = {0.3, 0, 200};
+	lch = mixOKLCh(grey, to, 0.5);
+	CHECK(fabs(lch.h - 10) < 1e-9, "fading in from grey sweeps the hue to %g", lch.h);
+	lch = mixOKLCh(from, grey, 0.5);
+	CHECK(fabs(lch.h - 350) < 1e-9, "fading out to grey sweeps the hue to %g", lch.h);
+	return CHECK_RESULT();
+}
@@ -0,0 +1,141 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * OutputStageCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "OutputStage.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+/*
+ * Checks the folded tables against the gamma, brightness and calibration computed directly in double precision, and
+ * the lookup of the table of every frame, in layout order, shuffled and for panels outside the layout
+ */
+
+static int directOutput(int v, double gamma, double brightness, double gain){
+	double out = floor(255*brightness*pow(v/255.0, gamma)*gain + 0.5);
+	return (out < 255) ? (int)out : 255;
+}
+
+/**
+ * @description: checks every table of a panel against the direct computation. Float and double may round a value
+ * that lands within float precision of .5 differently, so off by one is accepted there only
+ */
+static void checkPanelLuts(const OutputStage_t* outputStage, int index, double gamma, double brightness,
+		const double gain[3], const char* what){
+	int nFailures = 0;
+	for (int c = 0; c < 3; c++){
+		const uint8_t* lut = getOutputLut(outputStage, index, c);
+		for (int v = 0; v < 256 && nFailures < 5; v++){
+			int expected = directOutput(v, gamma, brightness, gain[c]);
+			double exact = 255*brightness*pow(v/255.0, gamma)*gain[c];
+			bool nearHalf = fabs(exact - floor(exact) - 0.5) < 1e-4*(exact + 1);
+			bool ok = lut[v] == expected || (nearHalf && abs(lut[v] - expected) == 1);
+			ok = ok && (v == 0 || lut[v] >= lut[v - 1]);
+			nFailures += !ok;
+			CHECK(ok, "%s: panel %d channel %d input %d gives %d instead of %d", what, index, c, v, lut[v], expected);
+		}
+	}
+}
+
+static Frame_t frameOf(int panelId, int r, int g, int b){
+	Frame_t frame = {panelId, r, g, b, 1};
+	return frame;
+}
+
+int main(){
+	LayoutData* layout = NULL;
+	generateLayoutData(SHAPE_TRIANGLE, 60, 2, &layout);
+	OutputStage_t outputStage;
+	getOutputStage(layout, &outputStage);
+	const double unity[3] = {1, 1, 1};
+
+	//defaults are the identity on every table, including the uncalibrated one
+	for (int i = 0; i <= layout->nPanels; i++){
+		checkPanelLuts(&outputStage, i, 1, 1, unity, "identity");
+	}
+
+	setOutputGamma(&outputStage, 2.2f);
+	setOutputBrightness(&outputStage, 0.7f);
+	setOutputGamma(&outputStage, 0);
+	setOutputGamma(&outputStage, -1);
+	CHECK(outputStage.gamma == 2.2f, "a gamma <= 0 was not ignored");
+	const double gain[3] = {1.5, 0.25, 0.8};
+	int calibrated = layout->panels[7].panelId;
+	CHECK(setPanelCalibration(&outputStage, calibrated, 1.5f, 0.25f, 0.8f) == 0, "calibration rejected");
+	CHECK(setPanelCalibration(&outputStage, 99999, 1, 1, 1) == OUTPUT_STAGE_ERROR_PANEL_NO_EXIST,
+			"calibration of a missing panel accepted");
+	checkPanelLuts(&outputStage, 7, 2.2, 0.7f, gain, "calibrated");
+	checkPanelLuts(&outputStage, 8, 2.2, 0.7f, unity, "uncalibrated");
+	checkPanelLuts(&outputStage, layout->nPanels, 2.2, 0.7f, unity, "outside the layout");
+
+	//a brightness change rebuilds every table and keeps the calibration
+	setOutputBrightness(&outputStage, 3);
+	checkPanelLuts(&outputStage, 7, 2.2, 3, gain, "calibrated and overdriven");
+	setOutputBrightness(&outputStage, -2);
+	const double zero[3] = {0, 0, 0};
+	checkPanelLuts(&outputStage, 3, 2.2, 0, zero, "black");
+	setOutputBrightness(&outputStage, 0.7f);
+
+	//the same frames give the same result in layout order and shuffled, which takes the binary search
+	std::vector<Frame_t> ordered, shuffled;
+	for (int i = 0; i < layout->nPanels; i++){
+		ordered.push_back(frameOf(layout->panels[i].panelId, i*4, 255 - i, (i*37) % 256));
+	}
+	ordered.push_back(frameOf(-5, 300, -20, 128));
+	shuffled = ordered;
+	std::reverse(shuffled.begin(), shuffled.end());
+	std::vector<Frame_t> expected = ordered;
+	applyOutputStage(&outputStage, ordered.data(), ordered.size());
+	applyOutputStage(&outputStage, shuffled.data(), shuffled.size());
+	std::reverse(shuffled.begin(), shuffled.end());
+	for (unsigned int i = 0; i < ordered.size(); i++){
+		int index = (i < (unsigned)layout->nPanels) ? i : layout->nPanels;
+		int r = std::min(std::max(expected[i].r, 0), 255);
+		int g = std::min(std::max(expected[i].g, 0), 255);
+		int b = std::min(std::max(expected[i].b, 0), 255);
+		bool ok = ordered[i].r == getOutputLut(&outputStage, index, 0)[r] &&
+				ordered[i].g == getOutputLut(&outputStage, index, 1)[g] &&
+				ordered[i].b == getOutputLut(&outputStage, index, 2)[b];
+		CHECK(ok, "frame %u of panel %d used the wrong table", i, expected[i].panelId);
+		CHECK(ordered[i].r == shuffled[i].r && ordered[i].g == shuffled[i].g && ordered[i].b == shuffled[i].b &&
+				ordered[i].panelId == shuffled[i].panelId && ordered[i].transTime == 1,
+				"frame %u differs when shuffled", i);
+	}
+
+	//setting the stage up again resets the settings and reuses the tables for a smaller layout
+	uint8_t* luts = outputStage.luts;
+	LayoutData* smaller = NULL;
+	generateLayoutData(SHAPE_SQUARE, 20, 2, &smaller);
+	getOutputStage(smaller, &outputStage);
+	CHECK(outputStage.luts == luts, "a smaller layout reallocated");
+	CHECK(outputStage.gamma == 1 && outputStage.brightness == 1, "settings not reset");
+	for (int i = 0; i <= smaller->nPanels; i++){
+		checkPanelLuts(&outputStage, i, 1, 1, unity, "reset");
+	}
+
+	freeLayoutData(smaller);
+	freeLayoutData(layout);
+	return CHECK_RESULT();
+}
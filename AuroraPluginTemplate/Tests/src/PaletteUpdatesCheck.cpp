@@ -0,0 +1,232 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PaletteUpdatesCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "LibraryStubs.h"
+#include "PaletteUpdates.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*
+ * Palette generations: the first view is the palette of the DataManager, every update publishes a new generation and
+ * notifies the plugin, views are refreshed only when the generation changed, the colors of a view survive the next
+ * updates that arrive before the view is refreshed and buffers are reused. The first views are taken by several
+ * threads at once. A reader thread checks it sees every published palette complete, once in lock step with the host
+ * and once while the host publishes as fast as it can, where the colors of the view it holds must not change until it
+ * refreshes it. Run under ThreadSanitizer to check the slots are never written while read
+ */
+
+static RGB_t dataManagerPalette[] = {{255, 0, 0}, {0, 255, 0}, {0, 0, 255}};
+static int nNotifications = 0;
+static PaletteView_t notifiedView;
+
+void pluginPaletteChanged(const PaletteView_t* palette){
+	nNotifications++;
+	notifiedView = *palette;
+}
+
+static std::vector<int> makeStream(int nColors, int seed){
+	std::vector<int> stream(nColors*PALETTE_COLOR_INTS);
+	for (int i = 0; i < nColors; i++){
+		stream[i*PALETTE_COLOR_INTS] = (seed + i) % 256;
+		stream[i*PALETTE_COLOR_INTS + 1] = (seed*3 + i) % 256;
+		stream[i*PALETTE_COLOR_INTS + 2] = (seed*7 + i) % 256;
+	}
+	return stream;
+}
+
+static bool viewMatches(const PaletteView_t& view, const std::vector<int>& stream){
+	if (view.nColors*PALETTE_COLOR_INTS != (int)stream.size()){
+		return false;
+	}
+	for (int i = 0; i < view.nColors; i++){
+		const int* c = &stream[i*PALETTE_COLOR_INTS];
+		if (view.colors[i].R != c[0] || view.colors[i].G != c[1] || view.colors[i].B != c[2]){
+			return false;
+		}
+	}
+	return true;
+}
+
+static void checkFirstView(){
+	const int nThreads = 8;
+	PaletteView_t views[nThreads];
+	std::atomic<int> ready(0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < nThreads; t++){
+		threads.push_back(std::thread([&, t](){
+			ready++;
+			while (ready.load() < nThreads){
+				std::this_thread::yield();
+			}
+			getPaletteView(&views[t]);
+		}));
+	}
+	for (int t = 0; t < nThreads; t++){
+		threads[t].join();
+	}
+	for (int t = 0; t < nThreads; t++){
+		CHECK(views[t].generation == 1, "thread %d: first generation %u", t, views[t].generation);
+		CHECK(views[t].colors == dataManagerPalette && views[t].nColors == 3,
+				"thread %d: the first view is not the DataManager palette", t);
+	}
+
+	PaletteView_t view;
+	CHECK(view.generation == 0 && view.colors == NULL && view.nColors == 0, "a new view is not empty");
+	CHECK(refreshPaletteView(&view), "an empty view is not refreshed");
+	CHECK(view.generation == 1 && view.colors == dataManagerPalette, "refreshed to generation %u", view.generation);
+	CHECK(!refreshPaletteView(&view), "a current view is refreshed");
+	CHECK(nNotifications == 0, "the plugin is notified without an update");
+}
+
+static void checkUpdates(){
+	PaletteView_t view;
+	getPaletteView(&view);
+	std::vector<int> first = makeStream(5, 1);
+	CHECK(passColorPaletteUpdate(first.data(), 5) == 0, "the update is not taken");
+	CHECK(nNotifications == 1, "%d notifications", nNotifications);
+	CHECK(notifiedView.generation == 2 && viewMatches(notifiedView, first), "notified generation %u",
+			notifiedView.generation);
+	CHECK(view.colors == dataManagerPalette, "an update changes an existing view");
+	CHECK(refreshPaletteView(&view), "the view is not refreshed after an update");
+	CHECK(view.generation == 2 && viewMatches(view, first), "refreshed to generation %u", view.generation);
+	CHECK(!refreshPaletteView(&view), "the view is refreshed twice");
+
+	//the colors of a view stay valid while the next palette is written
+	PaletteView_t previous = view;
+	std::vector<int> second = makeStream(7, 2);
+	passColorPaletteUpdate(second.data(), 7);
+	CHECK(viewMatches(previous, first), "the previous palette changed with the next update");
+	CHECK(refreshPaletteView(&view) && view.generation == 3 && viewMatches(view, second), "generation %u",
+			view.generation);
+
+	//a palette no larger than the previous ones of its slot reuses the buffer
+	std::vector<int> third = makeStream(4, 3);
+	passColorPaletteUpdate(third.data(), 4);
+	CHECK(refreshPaletteView(&view) && view.generation == 4 && viewMatches(view, third), "generation %u",
+			view.generation);
+	CHECK(view.colors == previous.colors, "a smaller palette is not written into the spare buffer");
+
+	//however many updates arrive before the view is refreshed, its colors stay valid
+	PaletteView_t held = view;
+	for (int u = 0; u < 5; u++){
+		std::vector<int> next = makeStream(3 + u, 10 + u);
+		passColorPaletteUpdate(next.data(), 3 + u);
+		CHECK(viewMatches(held, third), "update %d overwrote the palette of a view that was not refreshed", u);
+	}
+	std::vector<int> last = makeStream(6, 20);
+	passColorPaletteUpdate(last.data(), 6);
+	CHECK(refreshPaletteView(&view) && view.generation == 10 && viewMatches(view, last), "generation %u",
+			view.generation);
+
+	std::vector<int> empty;
+	passColorPaletteUpdate(empty.data(), 0);
+	CHECK(refreshPaletteView(&view) && view.generation == 11 && view.nColors == 0, "empty palette: %d colors",
+			view.nColors);
+	CHECK(nNotifications == 10, "%d notifications", nNotifications);
+}
+
+static void checkConcurrentReader(){
+	const int nUpdates = 2000;
+	std::atomic<unsigned int> acknowledged(0);
+	std::atomic<int> nTorn(0);
+	std::vector<std::vector<int> > streams;
+	for (int u = 0; u < nUpdates; u++){
+		streams.push_back(makeStream(1 + u % 13, u));
+	}
+	PaletteView_t start;
+	getPaletteView(&start);
+	unsigned int firstGeneration = start.generation + 1;
+
+	//the reader waits for each generation and checks it sees the palette published with it
+	std::thread reader([&](){
+		PaletteView_t view = start;
+		for (int u = 0; u < nUpdates; u++){
+			while (!refreshPaletteView(&view)){
+				std::this_thread::yield();
+			}
+			if (view.generation != firstGeneration + u || !viewMatches(view, streams[u])){
+				nTorn++;
+			}
+			acknowledged.store(view.generation, std::memory_order_release);
+		}
+	});
+	for (int u = 0; u < nUpdates; u++){
+		passColorPaletteUpdate(streams[u].data(), streams[u].size()/PALETTE_COLOR_INTS);
+		while (acknowledged.load(std::memory_order_acquire) != firstGeneration + u){
+			std::this_thread::yield();
+		}
+	}
+	reader.join();
+	CHECK(nTorn == 0, "the reader saw %d incomplete or skipped palettes", nTorn.load());
+}
+
+static void checkUnsynchronizedReader(){
+	const int nUpdates = 2000;
+	std::vector<std::vector<int> > streams;
+	for (int u = 0; u < nUpdates; u++){
+		streams.push_back(makeStream(1 + u % 13, u));
+	}
+	PaletteView_t start;
+	getPaletteView(&start);
+	unsigned int firstGeneration = start.generation + 1;
+	std::atomic<bool> isHostDone(false);
+	std::atomic<int> nTorn(0), nRefreshes(0);
+
+	//the reader refreshes whenever it likes and rereads its view after letting the host run
+	std::thread reader([&](){
+		PaletteView_t view = start;
+		for (bool isLast = false; !isLast;){
+			isLast = isHostDone.load();
+			if (refreshPaletteView(&view)){
+				nRefreshes++;
+			}
+			unsigned int u = view.generation - firstGeneration;
+			for (int pass = 0; pass < 2 && view.generation >= firstGeneration; pass++){
+				if (u >= (unsigned int)nUpdates || !viewMatches(view, streams[u])){
+					nTorn++;
+				}
+				std::this_thread::yield();
+			}
+		}
+	});
+	for (int u = 0; u < nUpdates; u++){
+		passColorPaletteUpdate(streams[u].data(), streams[u].size()/PALETTE_COLOR_INTS);
+		if (u % 3 == 0){
+			std::this_thread::yield();
+		}
+	}
+	isHostDone = true;
+	reader.join();
+	CHECK(nTorn == 0, "the reader saw %d incomplete or overwritten palettes", nTorn.load());
+	CHECK(nRefreshes > 0, "the reader never saw an update");
+}
+
+int main(){
+	setStubColorPalette(dataManagerPalette, 3);
+	checkFirstView();
+	checkUpdates();
+	checkConcurrentReader();
+	checkUnsynchronizedReader();
+	return CHECK_RESULT();
+}
@@ -0,0 +1,82 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PanelHitTestBench.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Check.h"
+#include "PanelHitTest.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * Times PanelHitTester::getPanelIndices over a raster of a large rotated wall, as an effect rendering a picture onto
+ * the panels does, against looking the same points up one at a time and against scattered points
+ */
+
+#define BENCH_PANELS 300
+#define BENCH_STEP 6.0f
+
+int main(){
+	LayoutData* layout = NULL;
+	generateLayoutData(LAYOUT_GENERATOR_MIXED, BENCH_PANELS, 1, &layout);
+	int angle = 30;
+	rotateAuroraPanels(layout, &angle);
+	PanelHitTester tester(layout);
+
+	float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+	for (int i = 0; i < layout->nPanels; i++){
+		Point c = layout->panels[i].shape->getCentroid();
+		minX = fminf(minX, c.x);
+		maxX = fmaxf(maxX, c.x);
+		minY = fminf(minY, c.y);
+		maxY = fmaxf(maxY, c.y);
+	}
+	std::vector<float> x, y, scatteredX, scatteredY;
+	for (float py = minY; py <= maxY; py += BENCH_STEP){
+		for (float px = minX; px <= maxX; px += BENCH_STEP){
+			x.push_back(px);
+			y.push_back(py);
+		}
+	}
+	int nPoints = x.size();
+	srand(1);
+	for (int i = 0; i < nPoints; i++){
+		scatteredX.push_back(minX + (maxX - minX)*rand()/(float)RAND_MAX);
+		scatteredY.push_back(minY + (maxY - minY)*rand()/(float)RAND_MAX);
+	}
+	std::vector<int> indices(nPoints);
+
+	double rasterUs = timePerCall([&](){ tester.getPanelIndices(x.data(), y.data(), nPoints, indices.data()); }, 50);
+	double singleUs = timePerCall([&](){
+		for (int i = 0; i < nPoints; i++){
+			tester.getPanelIndices(&x[i], &y[i], 1, &indices[i]);
+		}
+	}, 50);
+	double scatteredUs = timePerCall([&](){
+		tester.getPanelIndices(scatteredX.data(), scatteredY.data(), nPoints, indices.data());
+	}, 50);
+
+	printf("%d panels, %d points: raster %9.1f us, raster one at a time %9.1f us, scattered %9.1f us\n",
+			layout->nPanels, nPoints, rasterUs, singleUs, scatteredUs);
+	freeLayoutData(layout);
+	return 0;
+}
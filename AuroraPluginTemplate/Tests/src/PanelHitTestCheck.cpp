@@ -0,0 +1,139 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PanelHitTestCheck.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Check.h"
+#include "PanelHitTest.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * PanelHitTester::getPanelIndices on generated layouts, straight and rotated, against a brute force test of every
+ * point against every panel with isPointInsidePanel. The points are the rows of a raster over the layout, whose
+ * consecutive points mostly share a grid cell and take the vectorized path, and scattered random points, which mostly
+ * do not. Points closer to an edge than EDGE_MARGIN are skipped, float rounding may put them on either side.
+ * Looking the points up one at a time (the scalar path) must give exactly the same panels
+ */
+
+#define EDGE_MARGIN 1e-2
+#define RASTER_STEP 7.3				/*at least, large layouts get RASTER_ROW_POINTS points per row*/
+#define RASTER_ROW_POINTS 61
+
+static bool isNearEdge(LayoutData* layout, float x, float y){
+	for (int i = 0; i < layout->nPanels; i++){
+		Shape* shape = layout->panels[i].shape;
+		for (int k = 0; k < shape->nVertices; k++){
+			const Point& a = shape->vertices[k];
+			const Point& b = shape->vertices[(k + 1) % shape->nVertices];
+			double dx = b.x - a.x, dy = b.y - a.y;
+			double t = ((x - a.x)*dx + (y - a.y)*dy)/(dx*dx + dy*dy);
+			t = (t < 0) ? 0 : (t > 1) ? 1 : t;
+			if (hypot(a.x + t*dx - x, a.y + t*dy - y) < EDGE_MARGIN){
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+static void checkPoints(LayoutData* layout, PanelHitTester& tester, const std::vector<float>& x,
+		const std::vector<float>& y, const char* what){
+	int nPoints = x.size();
+	std::vector<int> indices(nPoints);
+	tester.getPanelIndices(x.data(), y.data(), nPoints, indices.data());
+	int nWrong = 0, nHits = 0, nDiffer = 0;
+	for (int i = 0; i < nPoints; i++){
+		int single;
+		tester.getPanelIndices(&x[i], &y[i], 1, &single);
+		nDiffer += (single != indices[i]);
+		if (isNearEdge(layout, x[i], y[i])){
+			continue;
+		}
+		int expected = -1;
+		for (int p = 0; p < layout->nPanels && expected < 0; p++){
+			if (isPointInsidePanel(&layout->panels[p], Point(x[i], y[i]))){
+				expected = p;
+			}
+		}
+		nWrong += (indices[i] != expected);
+		nHits += (expected >= 0);
+	}
+	CHECK(nWrong == 0, "%s: %d of %d points in the wrong panel", what, nWrong, nPoints);
+	CHECK(nDiffer == 0, "%s: %d points differ from a lookup one at a time", what, nDiffer);
+	CHECK(nHits > 0 || layout->nPanels == 0, "%s: no point hit a panel", what);
+}
+
+static void checkLayout(int shapeType, int nPanels, int angle, const char* name){
+	LayoutData* layout = NULL;
+	generateLayoutData(shapeType, nPanels, 7, &layout);
+	rotateAuroraPanels(layout, &angle);
+	PanelHitTester tester(layout);
+
+	double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+	for (int i = 0; i < layout->nPanels; i++){
+		Shape* shape = layout->panels[i].shape;
+		for (int k = 0; k < shape->nVertices; k++){
+			minX = fmin(minX, shape->vertices[k].x);
+			maxX = fmax(maxX, shape->vertices[k].x);
+			minY = fmin(minY, shape->vertices[k].y);
+			maxY = fmax(maxY, shape->vertices[k].y);
+		}
+	}
+	char what[64];
+
+	//raster rows reaching a little past the layout, with a width that is not a multiple of the vector width
+	std::vector<float> x, y;
+	double step = fmax(RASTER_STEP, (maxX - minX + 40)/RASTER_ROW_POINTS);
+	for (double py = minY - 20; py <= maxY + 20; py += step){
+		for (double px = minX - 20; px <= maxX + 20; px += step){
+			x.push_back(px);
+			y.push_back(py);
+		}
+	}
+	snprintf(what, sizeof(what), "%s %d at %d, raster", name, nPanels, angle);
+	checkPoints(layout, tester, x, y, what);
+
+	x.clear();
+	y.clear();
+	srand(nPanels + angle);
+	for (int i = 0; i < 1001; i++){
+		x.push_back(minX - 20 + (maxX - minX + 40)*rand()/(double)RAND_MAX);
+		y.push_back(minY - 20 + (maxY - minY + 40)*rand()/(double)RAND_MAX);
+	}
+	snprintf(what, sizeof(what), "%s %d at %d, scattered", name, nPanels, angle);
+	checkPoints(layout, tester, x, y, what);
+	freeLayoutData(layout);
+}
+
+int main(){
+	const int sizes[] = {1, 17, 120};
+	const int angles[] = {0, 30, 90};
+	for (int size : sizes){
+		for (int angle : angles){
+			checkLayout(SHAPE_TRIANGLE, size, angle, "triangles");
+			checkLayout(SHAPE_SQUARE, size, angle, "squares");
+			checkLayout(LAYOUT_GENERATOR_MIXED, size, angle, "mixed");
+		}
+	}
+	return CHECK_RESULT();
+}
@@ -0,0 +1,173 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PanelTraversalCheck.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Check.h"
+#include "PanelHitTest.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * PanelHitTester::traverseLine on generated layouts against clipping the line, in double precision, with every panel
+ * whose edges are pushed out by halfWidth. Lines, rays and thick rays of several widths start inside and outside the
+ * layout in many directions. Every panel the clip says is crossed must be reported once, with the same entry and exit
+ * distances, no other panel may be reported, and the hits must come in the order the line enters them. Panels the
+ * line only grazes (a crossing shorter than GRAZE_TOLERANCE) may go either way
+ */
+
+#define GRAZE_TOLERANCE 1e-2
+#define DISTANCE_TOLERANCE 1e-2
+
+/*clips the line with the shape grown by halfWidth, returns false if it misses*/
+static bool clipPanel(const Shape* shape, double x0, double y0, double dx, double dy, double length, double halfWidth,
+		double* tEnter, double* tExit){
+	double signedArea = 0;
+	for (int k = 0; k < shape->nVertices; k++){
+		const Point& a = shape->vertices[k];
+		const Point& b = shape->vertices[(k + 1) % shape->nVertices];
+		signedArea += a.x*b.y - b.x*a.y;
+	}
+	double winding = (signedArea >= 0) ? 1 : -1;
+	double tMin = 0, tMax = length;
+	for (int k = 0; k < shape->nVertices; k++){
+		const Point& v1 = shape->vertices[k];
+		const Point& v2 = shape->vertices[(k + 1) % shape->nVertices];
+		double a = -(v2.y - v1.y)*winding, b = (v2.x - v1.x)*winding;
+		double f0 = a*(x0 - v1.x) + b*(y0 - v1.y) + halfWidth*sqrt(a*a + b*b);
+		double fd = a*dx + b*dy;
+		if (fd == 0){
+			if (f0 < 0){
+				return false;
+			}
+			continue;
+		}
+		double t = -f0/fd;
+		if (fd > 0){
+			tMin = fmax(tMin, t);
+		}
+		else {
+			tMax = fmin(tMax, t);
+		}
+	}
+	*tEnter = tMin;
+	*tExit = tMax;
+	return tMin <= tMax;
+}
+
+static void checkLine(LayoutData* layout, PanelHitTester& tester, double x0, double y0, double angle, double length,
+		double halfWidth, const char* what, int* nWrong, int* nHits){
+	double dx = cos(angle), dy = sin(angle);
+	std::vector<LineHit_t> hits;
+	int nFound = tester.traverseLine(x0, y0, 2*dx, 2*dy, length, halfWidth, &hits);
+	bool ok = (nFound == (int)hits.size());
+	for (unsigned int k = 1; k < hits.size(); k++){
+		ok = ok && (hits[k - 1].tEnter < hits[k].tEnter ||
+				(hits[k - 1].tEnter == hits[k].tEnter && hits[k - 1].panelIndex < hits[k].panelIndex));
+	}
+
+	std::vector<int> nReported(layout->nPanels, 0);
+	for (const LineHit_t& hit : hits){
+		ok = ok && hit.panelIndex >= 0 && hit.panelIndex < layout->nPanels &&
+				hit.panelId == layout->panels[hit.panelIndex].panelId;
+		if (hit.panelIndex >= 0 && hit.panelIndex < layout->nPanels){
+			nReported[hit.panelIndex]++;
+		}
+	}
+	double maxLength = (length >= 0) ? length : INFINITY;
+	for (int i = 0; i < layout->nPanels; i++){
+		double tEnter, tExit;
+		bool isCrossed = clipPanel(layout->panels[i].shape, x0, y0, dx, dy, maxLength, halfWidth, &tEnter, &tExit);
+		bool isGrazed = fabs(tExit - tEnter) < GRAZE_TOLERANCE;
+		if (nReported[i] > 1 || (!isGrazed && nReported[i] != (int)isCrossed)){
+			ok = false;
+			continue;
+		}
+		if (nReported[i] == 1 && !isGrazed){
+			for (const LineHit_t& hit : hits){
+				if (hit.panelIndex == i){
+					ok = ok && fabs(hit.tEnter - tEnter) < DISTANCE_TOLERANCE &&
+							(isinf(tExit) ? hit.tExit > 1e30 : fabs(hit.tExit - tExit) < DISTANCE_TOLERANCE);
+				}
+			}
+		}
+	}
+	if (!ok && *nWrong == 0){
+		printf("%s: first wrong line from (%g, %g) at %g rad, length %g, half width %g\n", what, x0, y0, angle, length,
+				halfWidth);
+	}
+	*nWrong += !ok;
+	*nHits += hits.size();
+}
+
+static void checkLayout(int shapeType, int nPanels, int angle, const char* name){
+	LayoutData* layout = NULL;
+	generateLayoutData(shapeType, nPanels, 13, &layout);
+	rotateAuroraPanels(layout, &angle);
+	PanelHitTester tester(layout);
+
+	double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+	for (int i = 0; i < layout->nPanels; i++){
+		Point c = layout->panels[i].shape->getCentroid();
+		minX = fmin(minX, c.x);
+		maxX = fmax(maxX, c.x);
+		minY = fmin(minY, c.y);
+		maxY = fmax(maxY, c.y);
+	}
+	double span = fmax(maxX - minX, maxY - minY) + LAYOUT_GENERATOR_SIDE;
+	char what[64];
+	snprintf(what, sizeof(what), "%s %d at %d", name, nPanels, angle);
+
+	const double halfWidths[] = {0, 20, 100, 400};
+	const double lengths[] = {-1, 0.5*span, 3*span};
+	int nWrong = 0, nHits = 0, nLines = 0;
+	srand(nPanels*7 + angle);
+	for (int k = 0; k < 40; k++){
+		double x0 = minX - span/2 + 2*span*rand()/(double)RAND_MAX;
+		double y0 = minY - span/2 + 2*span*rand()/(double)RAND_MAX;
+		double direction = 2*M_PI*rand()/(double)RAND_MAX;
+		//every fifth line runs exactly along an axis, through shared edges and corners
+		direction = (k % 5 == 0) ? (k/5 % 4)*M_PI/2 : direction;
+		for (double halfWidth : halfWidths){
+			for (double length : lengths){
+				checkLine(layout, tester, x0, y0, direction, length, halfWidth, what, &nWrong, &nHits);
+				nLines++;
+			}
+		}
+	}
+	CHECK(nWrong == 0, "%s: %d of %d lines differ from clipping every panel", what, nWrong, nLines);
+	CHECK(nHits > 0, "%s: no line crossed a panel", what);
+	freeLayoutData(layout);
+}
+
+int main(){
+	const int sizes[] = {1, 20, 150};
+	const int angles[] = {0, 30};
+	for (int size : sizes){
+		for (int angle : angles){
+			checkLayout(SHAPE_TRIANGLE, size, angle, "triangles");
+			checkLayout(SHAPE_SQUARE, size, angle, "squares");
+			checkLayout(LAYOUT_GENERATOR_MIXED, size, angle, "mixed");
+		}
+	}
+	return CHECK_RESULT();
+}
@@ -0,0 +1,97 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * RGB8Check.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "RGB8.h"
+#include <limits.h>
+#include <vector>
+
+/*
+ * Checks the packed arithmetic against plain int arithmetic on every pair of channel values, with different values in
+ * the other channels so a carry or borrow leaking into a neighbour shows up, and the array functions against the
+ * single color operators
+ */
+
+static int saturate(int x){
+	return (x < 0) ? 0 : ((x > 255) ? 255 : x);
+}
+
+static bool isColor(const RGB8_t& c, int r, int g, int b){
+	return c.R == r && c.G == g && c.B == b && c.pad == 0;
+}
+
+int main(){
+	int nFailures = 0;
+	for (int x = 0; x < 256 && nFailures < 10; x++){
+		for (int y = 0; y < 256 && nFailures < 10; y++){
+			RGB8_t a(x, y, 255 - x), b(y, x, 128);
+			RGB8_t sum = a + b, diff = a - b, scaled = scaleRGB8(a, y);
+			bool ok = isColor(sum, saturate(x + y), saturate(y + x), saturate(255 - x + 128)) &&
+					isColor(diff, saturate(x - y), saturate(y - x), saturate(255 - x - 128)) &&
+					isColor(scaled, (x*y*2 + 255)/510, (y*y*2 + 255)/510, ((255 - x)*y*2 + 255)/510);
+			nFailures += !ok;
+			CHECK(ok, "(%d, %d, %d) and (%d, %d, %d): sum (%d, %d, %d), difference (%d, %d, %d), scaled (%d, %d, %d)",
+					a.R, a.G, a.B, b.R, b.G, b.B, sum.R, sum.G, sum.B, diff.R, diff.G, diff.B, scaled.R, scaled.G,
+					scaled.B);
+		}
+	}
+
+	RGB8_t c(10, 100, 200);
+	CHECK(isColor(c*2, 20, 200, 255), "c*2");
+	CHECK(isColor(3*c, 30, 255, 255), "3*c");
+	CHECK(isColor(c*0, 0, 0, 0) && isColor(c*-5, 0, 0, 0), "c*0 and c*-5");
+	CHECK(isColor(c*INT_MAX, 255, 255, 255), "c*INT_MAX");
+	RGB8_t d = c;
+	d += RGB8_t(250, 0, 1);
+	d -= RGB8_t(0, 101, 0);
+	CHECK(isColor(d, 255, 0, 201), "+= and -=");
+
+	//conversions from RGB_t clamp every channel
+	RGB_t wide[] = {{-1, 0, 255}, {256, INT_MAX, INT_MIN}, {12, 34, 56}};
+	RGB8_t packed[3];
+	toRGB8(wide, packed, 3);
+	CHECK(isColor(packed[0], 0, 0, 255) && isColor(packed[1], 255, 255, 0) && isColor(packed[2], 12, 34, 56),
+			"toRGB8 does not clamp");
+	RGB_t back[3];
+	toRGB(packed, back, 3);
+	CHECK(back[2].R == 12 && back[2].G == 34 && back[2].B == 56 && back[1].G == 255, "toRGB");
+	CHECK(RGB8_t::fromPacked(packed[2].packed()) == packed[2], "packed round trip");
+
+	//the vector loops and their tails against the single color operators, for every length up to a few vectors
+	for (int n = 0; n <= 19; n++){
+		std::vector<RGB8_t> dst(n), src(n), added, subtracted, scaled;
+		for (int i = 0; i < n; i++){
+			dst[i] = RGB8_t(i*37, 255 - i*11, i*90);
+			src[i] = RGB8_t(i*53, i*7, 128);
+		}
+		added = subtracted = scaled = dst;
+		addRGB8(added.data(), src.data(), n);
+		subRGB8(subtracted.data(), src.data(), n);
+		scaleRGB8(scaled.data(), 77, n);
+		for (int i = 0; i < n; i++){
+			CHECK(added[i] == dst[i] + src[i], "addRGB8 of %d colors, color %d", n, i);
+			CHECK(subtracted[i] == dst[i] - src[i], "subRGB8 of %d colors, color %d", n, i);
+			CHECK(scaled[i] == scaleRGB8(dst[i], 77), "scaleRGB8 of %d colors, color %d", n, i);
+		}
+	}
+	return CHECK_RESULT();
+}
@@ -0,0 +1,104 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * SweepIndexCheck.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Check.h"
+#include "SweepIndex.h"
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <vector>
+
+/*
+ * SweepIndex::getBoundaryPanel from every panel of generated layouts, in directions on and between the quantized
+ * ones, for several lane widths and both ends, against a linear scan of all panels. The index is also built with a
+ * coarse quantization, where the cached order is far off the exact direction and the searched band has to make up
+ * for it
+ */
+
+/*the first or last panel whose centroid is within laneHalfWidth of the line, lowest index on ties*/
+static int scanBoundaryPanel(LayoutData* layout, int panelIndex, double dx, double dy, double laneHalfWidth,
+		bool last){
+	double length = sqrt(dx*dx + dy*dy);
+	dx /= length;
+	dy /= length;
+	Point from = layout->panels[panelIndex].shape->getCentroid();
+	int found = panelIndex;
+	double foundProjection = 0;
+	for (int i = 0; i < layout->nPanels; i++){
+		Point at = layout->panels[i].shape->getCentroid();
+		double rx = at.x - from.x, ry = at.y - from.y;
+		if (fabs(ry*dx - rx*dy) >= laneHalfWidth){
+			continue;
+		}
+		double projection = rx*dx + ry*dy;
+		if ((last ? projection > foundProjection : projection < foundProjection) ||
+				(projection == foundProjection && i < found)){
+			found = i;
+			foundProjection = projection;
+		}
+	}
+	return found;
+}
+
+static void checkLayout(int shapeType, int nPanels, int angle, int angleSteps, const char* name){
+	LayoutData* layout = NULL;
+	generateLayoutData(shapeType, nPanels, 3, &layout);
+	rotateAuroraPanels(layout, &angle);
+	SweepIndex index(layout, angleSteps);
+
+	const double directions[] = {0, 17.3, 30, 90, 135.25, 180, 259.9, 300};
+	const double laneHalfWidths[] = {1, 40, 75, 160};
+	int nWrong = 0, nMoved = 0, nQueries = 0;
+	for (double direction : directions){
+		double dx = cos(direction*M_PI/180), dy = sin(direction*M_PI/180);
+		for (double laneHalfWidth : laneHalfWidths){
+			for (int last = 0; last < 2; last++){
+				for (int i = 0; i < layout->nPanels; i++){
+					int found = index.getBoundaryPanel(i, 3*dx, 3*dy, laneHalfWidth, last);
+					int expected = scanBoundaryPanel(layout, i, dx, dy, laneHalfWidth, last);
+					nWrong += (found != expected);
+					nMoved += (expected != i);
+					nQueries++;
+				}
+			}
+		}
+	}
+	CHECK(nWrong == 0, "%s %d at %d, %d steps: %d of %d queries differ from the linear scan", name, nPanels, angle,
+			angleSteps, nWrong, nQueries);
+	CHECK(nMoved > 0 || nPanels == 1, "%s %d: no query left its panel", name, nPanels);
+	CHECK(index.getBoundaryPanel(-1, 1, 0, 10) == -1 && index.getBoundaryPanel(nPanels, 1, 0, 10) == -1,
+			"%s: a panel out of range was accepted", name);
+	CHECK(index.getBoundaryPanel(0, 0, 0, 10) == 0, "%s: a line without direction left its panel", name);
+	freeLayoutData(layout);
+}
+
+int main(){
+	const int sizes[] = {1, 16, 90};
+	const int angleSteps[] = {SWEEP_INDEX_DEFAULT_ANGLE_STEPS, 12};
+	for (int size : sizes){
+		for (int steps : angleSteps){
+			checkLayout(SHAPE_TRIANGLE, size, 0, steps, "triangles");
+			checkLayout(SHAPE_SQUARE, size, 30, steps, "squares");
+			checkLayout(LAYOUT_GENERATOR_MIXED, size, 90, steps, "mixed");
+		}
+	}
+	return CHECK_RESULT();
+}
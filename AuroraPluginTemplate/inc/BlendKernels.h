@@ -0,0 +1,86 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * BlendKernels.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_BLENDKERNELS_H_
+#define INC_BLENDKERNELS_H_
+
+#include <stdint.h>
+
+/**
+ * Blend kernels over whole channel buffers, e.g. the R, G and B values of all panels of a frame, so mixing N sources
+ * over P panels takes N vectorized passes instead of a scalar loop per panel, source and channel.
+ * Every kernel blends src into dst element by element: dst[i] = op(dst[i], src[i]). The buffers may hold one array
+ * per channel or interleaved channels, as long as src (and the blend factors) are laid out the same way.
+ * Full scale is 255 for uint8_t, 65535 for uint16_t and 1 for float buffers; it only matters for multiply, screen
+ * and the blend factors of lerp. Integer kernels round to nearest and saturate, float kernels do not clamp.
+ * uint8_t and uint16_t kernels are vectorized with SSE2 (AVX2 when compiled with -mavx2), float kernels with SSE
+ * (AVX when compiled with -mavx). The vector paths give the same results as the scalar fallback.
+ */
+
+/**
+ * @description: linear interpolation, dst = dst*(1 - t) + src*t
+ * @params dst: the buffer to blend into
+ * @params src: the buffer to blend in
+ * @params t: blend factor of every element, in full scale units
+ * @params n: number of elements
+ */
+void blendLerp(uint8_t* dst, const uint8_t* src, const uint8_t* t, int n);
+void blendLerp(uint16_t* dst, const uint16_t* src, const uint16_t* t, int n);
+void blendLerp(float* dst, const float* src, const float* t, int n);
+
+/**
+ * @description: linear interpolation towards a single value, dst = dst*(1 - t) + src*t, e.g. mixing the color of one
+ * source into all panels with a per panel factor
+ */
+void blendLerpConstant(uint8_t* dst, uint8_t src, const uint8_t* t, int n);
+void blendLerpConstant(uint16_t* dst, uint16_t src, const uint16_t* t, int n);
+void blendLerpConstant(float* dst, float src, const float* t, int n);
+
+/**
+ * @description: additive blend, dst = dst + src
+ */
+void blendAdd(uint8_t* dst, const uint8_t* src, int n);
+void blendAdd(uint16_t* dst, const uint16_t* src, int n);
+void blendAdd(float* dst, const float* src, int n);
+
+/**
+ * @description: lighten blend, dst = max(dst, src)
+ */
+void blendMax(uint8_t* dst, const uint8_t* src, int n);
+void blendMax(uint16_t* dst, const uint16_t* src, int n);
+void blendMax(float* dst, const float* src, int n);
+
+/**
+ * @description: multiply blend, dst = dst*src, both in full scale units
+ */
+void blendMultiply(uint8_t* dst, const uint8_t* src, int n);
+void blendMultiply(uint16_t* dst, const uint16_t* src, int n);
+void blendMultiply(float* dst, const float* src, int n);
+
+/**
+ * @description: screen blend, dst = 1 - (1 - dst)*(1 - src), both in full scale units
+ */
+void blendScreen(uint8_t* dst, const uint8_t* src, int n);
+void blendScreen(uint16_t* dst, const uint16_t* src, int n);
+void blendScreen(float* dst, const float* src, int n);
+
+#endif /* INC_BLENDKERNELS_H_ */
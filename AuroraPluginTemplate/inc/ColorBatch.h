@@ -0,0 +1,55 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * ColorBatch.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_COLORBATCH_H_
+#define INC_COLORBATCH_H_
+
+#include "ColorUtils.h"
+
+/**
+ * Batch color space conversions, for converting a whole frame or palette at once instead of calling HSVtoRGB or
+ * RGBtoHSV per color.
+ * H is in degrees (wrapped into [0, 360)), S and V in [0, 100], R, G and B in [0, 255]; out of range inputs are
+ * wrapped or clamped. Results are rounded to the nearest integer.
+ * The conversions are vectorized with SSE2 (AVX when compiled with -mavx). All intermediate values are integers
+ * small enough to be exact in float, so the vector paths give bit-identical results to the scalar fallback used on
+ * other targets and for the tail of the arrays.
+ */
+
+/**
+ * @description: converts an array of colors from HSV colorspace to RGB colorspace
+ * @params hsv: colors to convert from ...
+ * @params rgb: ... colors to convert to. May not alias hsv
+ * @params nColors: number of colors
+ */
+void HSVtoRGBBatch(const HSV_t* hsv, RGB_t* rgb, int nColors);
+
+/**
+ * @description: converts an array of colors from RGB colorspace to HSV colorspace. Grays get a hue and, for black,
+ * a saturation of 0
+ * @params rgb: colors to convert from ...
+ * @params hsv: ... colors to convert to. May not alias rgb
+ * @params nColors: number of colors
+ */
+void RGBtoHSVBatch(const RGB_t* rgb, HSV_t* hsv, int nColors);
+
+#endif /* INC_COLORBATCH_H_ */
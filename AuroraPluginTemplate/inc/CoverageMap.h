@@ -0,0 +1,87 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * CoverageMap.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_COVERAGEMAP_H_
+#define INC_COVERAGEMAP_H_
+
+#include "LayoutProcessingUtils.h"
+#include "AuroraPlugin.h"
+#include <stdint.h>
+#include <vector>
+
+#define COVERAGE_MAP_SUBSAMPLES 4	/*each pixel is sampled on a COVERAGE_MAP_SUBSAMPLES^2 grid to weigh partial coverage*/
+
+/**
+ * Precomputed mapping from the pixels of a raster laid over the layout to the panels, to drive panels from 2D content
+ * (gradients, noise, video frames) without any geometry test per frame.
+ * The raster covers the bounding box of the layout, with the y axis of the image pointing down (row 0 is the top of the
+ * layout). When built, every panel gets the list of pixels its shape covers, each with a weight proportional to the
+ * covered area, normalized so the weights of a panel sum to 1. Sampling an image is then a sparse weighted sum per
+ * panel, whose cost only depends on the number of covered pixels.
+ * The map must be rebuilt after the layout has been rotated or changed.
+ */
+class CoverageMap {
+	CoverageMap(const CoverageMap&) = delete;
+	CoverageMap& operator=(const CoverageMap&) = delete;
+
+	int width, height;
+	int nPanels;
+	std::vector<int> panelIds;
+	std::vector<int> offsets;			/*pixels of panel i are pixels[offsets[i]] ... pixels[offsets[i+1] - 1]*/
+	std::vector<uint32_t> pixels;		/*pixel index, row*width + column*/
+	std::vector<uint16_t> weights;		/*weight of the pixel in 1/65535 of the panel*/
+
+public:
+	/**
+	 * @description: builds the coverage of the layout for a raster of width x height pixels
+	 * @params layoutData: the layout, in its current orientation
+	 * @params width, height: resolution of the images that will be sampled
+	 */
+	CoverageMap(LayoutData* layoutData, int width, int height);
+
+	/**
+	 * @description: rebuilds the coverage, e.g. after rotating the layout or to change the resolution
+	 */
+	void rebuild(LayoutData* layoutData, int width, int height);
+
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+
+	/**
+	 * @description: computes the color of every panel as the weighted average of the pixels it covers and writes one
+	 * Frame_t per panel, in layout order
+	 * @params rgb: the image, width*height pixels of 3 bytes (R, G, B), row after row, top row first
+	 * @params transTime: the transition time written in every frame
+	 * @params frames: the buffer to write to, with room for one frame per panel
+	 * @return: the number of frames written, i.e. the number of panels
+	 */
+	int sampleImage(const uint8_t* rgb, int transTime, Frame_t* frames) const;
+
+	/**
+	 * @description: same as sampleImage for a single channel image, e.g. a noise or intensity field
+	 * @params image: width*height values, row after row, top row first
+	 * @params values: filled with the weighted average for every panel, in layout order
+	 */
+	void sampleChannel(const float* image, float* values) const;
+};
+
+#endif /* INC_COVERAGEMAP_H_ */
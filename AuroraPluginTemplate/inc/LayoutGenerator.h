@@ -0,0 +1,62 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutGenerator.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_LAYOUTGENERATOR_H_
+#define INC_LAYOUTGENERATOR_H_
+
+#include "LayoutProcessingUtils.h"
+#include <vector>
+
+#define LAYOUT_GENERATOR_MIXED -1			/*squares with triangles attached on top, see generateLayoutByteStream*/
+
+/*the layout byte stream holds, for every panel: panelId, x, y, orientation, shapeType, i.e. the fields of an entry of
+ *positionData in the same order*/
+#define LAYOUT_STREAM_INTS_PER_PANEL 5
+
+#define LAYOUT_GENERATOR_SIDE 150			/*side of both shapes, parseLayoutData uses the single Shape::sideLength*/
+
+/**
+ * @description: generates a random, edge connected layout, to benchmark layout utilities and plugins on sizes that
+ * are not available as hardware. The layout grows from a single panel by repeatedly attaching a panel to a random free
+ * edge, so the result is a compact, irregular blob. The same seed always gives the same layout.
+ * For LAYOUT_GENERATOR_MIXED, the lower half of the panels are squares and the rest are triangles above them. Both
+ * have the same side, and the triangle columns line up with the square columns: every up triangle of the lowest
+ * triangle row stands exactly on the top edge of the square below it, if there is one. The triangles grow from the
+ * one standing on square (0, 0), so every panel shares a full edge with at least one other panel.
+ *
+ * @params shapeType: SHAPE_TRIANGLE, SHAPE_SQUARE or LAYOUT_GENERATOR_MIXED
+ * @params nPanels: number of panels to generate
+ * @params seed: seed of the random generator
+ * @params stream: filled with LAYOUT_STREAM_INTS_PER_PANEL ints per panel, as consumed by parseLayoutData.
+ * panelIds are 1 ... nPanels, in the order the panels were attached
+ * @return: the number of panels generated, -1 if shapeType is not supported
+ */
+int generateLayoutByteStream(int shapeType, int nPanels, unsigned int seed, std::vector<int>* stream);
+
+/**
+ * @description: generates a random layout as in generateLayoutByteStream and parses it with parseLayoutData
+ * @params layoutData: filled with the parsed layout. Deallocate with freeLayoutData
+ * @return: the number of panels generated, -1 if shapeType is not supported
+ */
+int generateLayoutData(int shapeType, int nPanels, unsigned int seed, LayoutData** layoutData);
+
+#endif /* INC_LAYOUTGENERATOR_H_ */
@@ -0,0 +1,158 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutUpdates.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_LAYOUTUPDATES_H_
+#define INC_LAYOUTUPDATES_H_
+
+#include "LayoutProcessingUtils.h"
+#include <mutex>
+#include <vector>
+
+#define LAYOUT_DELTA_ADD 0
+#define LAYOUT_DELTA_REMOVE 1
+#define LAYOUT_DELTA_MOVE 2
+
+#define LAYOUT_DELTA_INTS 6			/*ints per delta in the delta byte stream, in the order of the LayoutDelta_t fields*/
+
+#define LAYOUT_UPDATE_NOT_HANDLED 1		/*the plugin has no pluginLayoutChanged, the host has to restart it*/
+#define LAYOUT_UPDATE_ERROR_PANEL_NO_EXIST -20
+#define LAYOUT_UPDATE_ERROR_PANEL_EXISTS -21
+#define LAYOUT_UPDATE_ERROR_WRONG_DELTA_TYPE -22
+
+/**
+ * A single change to the layout, as sent by the host. Positions and orientations are raw positionData values, in the
+ * coordinates of the layout byte stream, i.e. before any rotateAuroraPanels of the plugin. Use
+ * getLayoutDeltaCentroid to get a position in the coordinates of the (rotated) LayoutData
+ */
+struct LayoutDelta_t {
+	int type;			/*LAYOUT_DELTA_ADD, LAYOUT_DELTA_REMOVE or LAYOUT_DELTA_MOVE*/
+	int panelId;		/*the panel that is added, removed or moved*/
+	int x, y;			/*new centroid, ignored for LAYOUT_DELTA_REMOVE*/
+	int orientation;	/*new orientation, ignored for LAYOUT_DELTA_REMOVE*/
+	int shapeType;		/*shape of an added panel, as defined in Shape.h*/
+};
+
+/**
+ * @description: returns the centroid of an added or moved panel in the coordinates of the layout. rotateAuroraPanels
+ * turns every centroid around layoutGeometricCenter, so the raw position is turned the same way by the total rotation
+ * @params layoutData: the layout the delta applies to
+ * @params delta: the delta, with a raw position
+ * @params totalAuroraRotation: the angle the plugin has rotated the layout by since it got it, in degrees
+ * @return: the centroid the panel has in layoutData
+ */
+static inline Point getLayoutDeltaCentroid(const LayoutData* layoutData, const LayoutDelta_t& delta,
+		int totalAuroraRotation){
+	Point center = layoutData->layoutGeometricCenter;
+	Point offset(delta.x - center.x, delta.y - center.y);
+	return offset.rotate(totalAuroraRotation) + center;
+}
+
+/**
+ * @description: validates a list of deltas against the layout, in order, without changing anything
+ * @params layoutData: the layout the deltas apply to
+ * @params deltas: the changes
+ * @params nDeltas: number of deltas
+ * @return: 0 if applyLayoutDeltas would accept them, else the LAYOUT_UPDATE_ERROR_* it would return
+ */
+int validateLayoutDeltas(LayoutData* layoutData, const LayoutDelta_t* deltas, int nDeltas);
+
+/**
+ * @description: applies a list of deltas to the layout in place, instead of re-parsing the whole layout.
+ * All deltas are validated before any is applied, so on error the layout is left untouched.
+ * Removed panels are taken out without changing the order of the other panels, added panels are appended at the end.
+ * Positions are converted with getLayoutDeltaCentroid and orientations turned by the same rotation, so the new panels
+ * line up with the rest of the rotated layout. layoutGeometricCenter is left as it is: it stays the point the layout
+ * is rotated around, so later deltas and rotations keep using the same frame
+ * @params layoutData: the layout to update
+ * @params deltas: the changes, with raw positions, applied in order
+ * @params nDeltas: number of deltas
+ * @params totalAuroraRotation: the angle the plugin has rotated the layout by since it got it, in degrees
+ * @return: 0 on success, LAYOUT_UPDATE_ERROR_* if a delta refers to a missing panel, adds an existing one or has an
+ * unknown type
+ */
+int applyLayoutDeltas(LayoutData* layoutData, const LayoutDelta_t* deltas, int nDeltas, int totalAuroraRotation);
+
+/**
+ * Hands deltas from the host thread, where pluginLayoutChanged runs, to the thread that calls getPluginFrame. The
+ * callback pushes the deltas it gets, getPluginFrame takes everything pushed since its last call before it reads the
+ * layout, applies it with applyLayoutDeltas and updates what is derived from the layout
+ */
+class LayoutDeltaQueue {
+	LayoutDeltaQueue(const LayoutDeltaQueue&) = delete;
+	LayoutDeltaQueue& operator=(const LayoutDeltaQueue&) = delete;
+
+	std::mutex mutex;
+	std::vector<LayoutDelta_t> pending;
+
+public:
+	LayoutDeltaQueue(){}
+
+	/**
+	 * @description: appends deltas, called from pluginLayoutChanged
+	 */
+	void push(const LayoutDelta_t* deltas, int nDeltas);
+
+	/**
+	 * @description: moves every delta pushed since the last call into deltas, in the order they were pushed
+	 * @params deltas: replaced with the pending deltas. Its storage is swapped with the queue's, so a plugin that
+	 * keeps the same vector from frame to frame does not allocate once both have grown
+	 * @return: the number of deltas taken, 0 if the layout did not change
+	 */
+	int take(std::vector<LayoutDelta_t>* deltas);
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+	 * @description: entry point for the host when panels are added, removed or moved while the plugin runs.
+	 * If the plugin implements pluginLayoutChanged, the deltas are validated and handed to the plugin. Otherwise
+	 * nothing is changed and the host falls back to restarting the plugin. The plugin applies deltas later, on the
+	 * frame thread, so they are validated against the panels the lists accepted before leave, not against the layout
+	 * of the DataManager, which may not have caught up yet and may be changing
+	 * @params deltaByteStream: LAYOUT_DELTA_INTS ints per delta
+	 * @params nDeltas: number of deltas
+	 * @return: 0 if the plugin took the update, LAYOUT_UPDATE_NOT_HANDLED or LAYOUT_UPDATE_ERROR_* if it has to be
+	 * restarted
+	 */
+	int passLayoutDeltas(int* deltaByteStream, int nDeltas);
+
+	/**
+	 * @description: optional plugin callback, called with deltas that have been validated. Defining it tells the
+	 * host the plugin keeps running on layout changes instead of being restarted; plugins that do not define it are
+	 * restarted, as before. It runs on the host thread while getPluginFrame may be running, so it must not touch the
+	 * layout or anything derived from it: it pushes the deltas into a LayoutDeltaQueue. At the top of getPluginFrame
+	 * the plugin takes them and, since only it knows how far it has rotated the layout, applies them with
+	 * applyLayoutDeltas(layoutData, deltas, nDeltas, totalAuroraRotation), then updates anything derived from the
+	 * layout (frame slices, indexes, ...)
+	 * @params layoutData: the layout the deltas are for, the same object getLayoutData returns
+	 * @params deltas: the changes, with raw positions
+	 * @params nDeltas: number of deltas
+	 */
+	void pluginLayoutChanged(LayoutData* layoutData, const LayoutDelta_t* deltas, int nDeltas) __attribute__((weak));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LAYOUTUPDATES_H_ */
@@ -0,0 +1,90 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * OKLab.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_OKLAB_H_
+#define INC_OKLAB_H_
+
+#include "ColorUtils.h"
+
+/**
+ * OKLab, a perceptual color space: equal steps look about equally large, so interpolating in it gives even
+ * gradients without the dark or grey midpoints of interpolating R, G and B. OKLCh is its polar form, lightness,
+ * chroma and hue, which keeps saturated midpoints between colors of different hue.
+ * The conversions use pow and cbrt, they are meant for building tables (e.g. buildPaletteGradient) when a palette is
+ * loaded, not for per frame use.
+ * RGB_t is taken as sRGB, with channels in [0, 255]
+ */
+struct OKLab_t {
+	double L;		/*lightness, 0 for black, 1 for white*/
+	double a, b;	/*green-red and blue-yellow axes*/
+};
+
+struct OKLCh_t {
+	double L;		/*lightness, 0 for black, 1 for white*/
+	double C;		/*chroma, 0 for greys*/
+	double h;		/*hue in degrees, [0, 360)*/
+};
+
+/**
+ * @description: Convert Color from RGB colorspace to OKLab colorspace
+ * @params rgb: color to convert from, channels are clamped into [0, 255] ...
+ * @params lab: ... color to convert to
+ */
+void RGBtoOKLab(RGB_t rgb, OKLab_t* lab);
+
+/**
+ * @description: Convert Color from OKLab colorspace to RGB colorspace. Colors outside of sRGB are clamped per channel
+ * @params lab: color to convert from ...
+ * @params rgb: ... color to convert to, rounded to the nearest integer
+ */
+void OKLabtoRGB(OKLab_t lab, RGB_t* rgb);
+
+/**
+ * @description: Convert Color from OKLab colorspace to its polar form
+ */
+void OKLabtoOKLCh(OKLab_t lab, OKLCh_t* lch);
+
+/**
+ * @description: Convert Color from OKLCh colorspace to OKLab colorspace
+ */
+void OKLChtoOKLab(OKLCh_t lch, OKLab_t* lab);
+
+/**
+ * @description: interpolates linearly between two OKLab colors
+ * @params from: the color at fraction 0
+ * @params to: the color at fraction 1
+ * @params fraction: position between the colors, in [0, 1]
+ * @return: the interpolated color
+ */
+OKLab_t mixOKLab(const OKLab_t& from, const OKLab_t& to, double fraction);
+
+/**
+ * @description: interpolates between two OKLCh colors, the hue along the shorter way around the hue circle. If
+ * one of the colors is grey, the hue of the other is kept, so fading to white or black does not sweep through hues
+ * @params from: the color at fraction 0
+ * @params to: the color at fraction 1
+ * @params fraction: position between the colors, in [0, 1]
+ * @return: the interpolated color
+ */
+OKLCh_t mixOKLCh(const OKLCh_t& from, const OKLCh_t& to, double fraction);
+
+#endif /* INC_OKLAB_H_ */
@@ -0,0 +1,123 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * OutputStage.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_OUTPUTSTAGE_H_
+#define INC_OUTPUTSTAGE_H_
+
+#include "AuroraPlugin.h"
+#include "LayoutProcessingUtils.h"
+#include <stdint.h>
+
+#define OUTPUT_STAGE_ERROR_PANEL_NO_EXIST -30
+
+/**
+ * Output stage applied to the frames just before they are handed over: a gamma curve for the installation, a global
+ * brightness and a per panel calibration (gain of every channel, for white balance between panels).
+ * All three are folded into one 256 entry lookup table per panel and channel, rebuilt only when a setting changes, so
+ * fades and white balance cost a table lookup per channel and no floating point work per frame.
+ * Tables are in the order of layoutData->panels, followed by one uncalibrated table for panels not in the layout
+ */
+struct OutputStage_t {
+	int nPanels;			/*number of panels*/
+	int* panelIds;			/*panelId of every panel*/
+	float* calibration;		/*R, G and B gain of every panel, 1 by default*/
+	float gamma;			/*exponent of the gamma curve, 1 for linear output*/
+	float brightness;		/*global scale, 1 for full brightness*/
+	uint8_t* luts;			/*(nPanels + 1)*3 tables of 256 entries, see getOutputLut*/
+	int* sortedIds;			/*panelIds sorted, to find the table of a frame*/
+	int* sortedIndices;		/*index of every entry of sortedIds*/
+	int capacity;
+	OutputStage_t(const OutputStage_t&) = delete;
+	OutputStage_t(){
+		nPanels = 0;
+		panelIds = NULL;
+		calibration = NULL;
+		gamma = 1;
+		brightness = 1;
+		luts = NULL;
+		sortedIds = NULL;
+		sortedIndices = NULL;
+		capacity = 0;
+	}
+	~OutputStage_t(){
+		delete [] panelIds;
+		delete [] calibration;
+		delete [] luts;
+		delete [] sortedIds;
+		delete [] sortedIndices;
+	}
+};
+
+/**
+ * @description: the lookup table of a channel of a panel
+ * @params outputStage: the output stage
+ * @params panelIndex: index into layoutData->panels, nPanels for the uncalibrated table
+ * @params channel: 0, 1 or 2 for R, G or B
+ * @return: 256 output values, indexed by the input value
+ */
+inline const uint8_t* getOutputLut(const OutputStage_t* outputStage, int panelIndex, int channel){
+	return outputStage->luts + (panelIndex*3 + channel)*256;
+}
+
+/**
+ * @description: sets the output stage up for the layout, with linear gamma, full brightness and no calibration.
+ * No allocation happens if it already has enough capacity. Call again after the layout changed, calibrations are
+ * reset
+ * @params layoutData: the layout the frames are for
+ * @params outputStage: the output stage to set up
+ */
+void getOutputStage(LayoutData* layoutData, OutputStage_t* outputStage);
+
+/**
+ * @description: sets the gamma curve of the installation, out = in^gamma on the [0, 1] scale, and rebuilds the tables
+ * @params outputStage: the output stage
+ * @params gamma: the exponent, e.g. 2.2. Values <= 0 are ignored
+ */
+void setOutputGamma(OutputStage_t* outputStage, float gamma);
+
+/**
+ * @description: sets the global brightness and rebuilds the tables
+ * @params outputStage: the output stage
+ * @params brightness: scale of all channels, 0 for black, 1 for full brightness. Negative values are taken as 0
+ */
+void setOutputBrightness(OutputStage_t* outputStage, float brightness);
+
+/**
+ * @description: sets the calibration of a panel and rebuilds its tables
+ * @params outputStage: the output stage
+ * @params panelId: the panel to calibrate
+ * @params r, g, b: gain of every channel, applied after gamma and brightness. Outputs are clamped to 255
+ * @return: 0 on success, OUTPUT_STAGE_ERROR_PANEL_NO_EXIST if the panel is not in the layout
+ */
+int setPanelCalibration(OutputStage_t* outputStage, int panelId, float r, float g, float b);
+
+/**
+ * @description: applies the output stage to the frames in place, in one pass. Channels are clamped into [0, 255]
+ * before the lookup. Frames in the order of the layout (as written by writeFrames) find their table directly,
+ * others by a binary search on the panelId
+ * @params outputStage: the output stage
+ * @params frames: the frames to correct
+ * @params nFrames: number of frames
+ */
+void applyOutputStage(const OutputStage_t* outputStage, Frame_t* frames, int nFrames);
+
+#endif /* INC_OUTPUTSTAGE_H_ */
@@ -0,0 +1,100 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PaletteGradient.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_PALETTEGRADIENT_H_
+#define INC_PALETTEGRADIENT_H_
+
+#include "ColorUtils.h"
+#include <stddef.h>
+
+#define PALETTE_GRADIENT_DEFAULT_SIZE 1024
+
+#define PALETTE_INTERPOLATION_RGB 0		/*linear in R, G and B, as the getRGB helpers*/
+#define PALETTE_INTERPOLATION_OKLAB 1	/*linear in OKLab, perceptually even steps*/
+#define PALETTE_INTERPOLATION_OKLCH 2	/*OKLCh, also keeps the saturation between colors of different hue*/
+
+/**
+ * A palette sampled into a lookup table, so picking a color anywhere between the palette colors is a single indexed
+ * read instead of an interpolation per call.
+ * Colors are addressed in palette units, as in the getRGB helpers of the examples: 0 is the first palette color,
+ * nColors - 1 the last one, and values in between interpolate between neighbouring palette colors
+ */
+struct PaletteGradient_t {
+	int size;				/*number of entries*/
+	RGB_t* colors;			/*the sampled gradient*/
+	float scale;			/*entries per palette unit*/
+	int capacity;
+	PaletteGradient_t(const PaletteGradient_t&) = delete;
+	PaletteGradient_t(){
+		size = 0;
+		colors = NULL;
+		scale = 0;
+		capacity = 0;
+	}
+	~PaletteGradient_t(){
+		delete [] colors;
+	}
+};
+
+/**
+ * @description: samples a palette into a gradient lookup table. With PALETTE_INTERPOLATION_RGB entries interpolate
+ * linearly between neighbouring palette colors and are truncated to integers, as getRGB does. The perceptual modes
+ * interpolate in OKLab or OKLCh (see OKLab.h) and round; the color space math only runs here, reading the table
+ * costs the same in every mode. An empty palette gives half white, a single color palette a constant gradient.
+ * No allocation happens if the table already has enough capacity
+ * @params palette: the palette colors
+ * @params nColors: number of palette colors
+ * @params size: number of entries in the table, at least 2
+ * @params gradient: the table to fill
+ * @params mode: PALETTE_INTERPOLATION_*
+ */
+void buildPaletteGradient(const RGB_t* palette, int nColors, int size, PaletteGradient_t* gradient,
+		int mode = PALETTE_INTERPOLATION_RGB);
+
+/**
+ * @description: builds the gradient of the palette from the DataManager (getColorPalette)
+ */
+void getPaletteGradient(PaletteGradient_t* gradient, int size = PALETTE_GRADIENT_DEFAULT_SIZE,
+		int mode = PALETTE_INTERPOLATION_RGB);
+
+/**
+ * @description: returns the gradient color at a position of the palette, in constant time
+ * @params gradient: the gradient to read
+ * @params colour: position in palette units, clamped to [0, nColors - 1]
+ * @return: the nearest entry of the gradient
+ */
+inline const RGB_t& getGradientColor(const PaletteGradient_t* gradient, float colour){
+	int index = (int)(colour*gradient->scale + 0.5f);
+	index = (index < 0) ? 0 : ((index >= gradient->size) ? gradient->size - 1 : index);
+	return gradient->colors[index];
+}
+
+/**
+ * @description: looks up the gradient colors of many positions at once, e.g. one per panel of a frame
+ * @params gradient: the gradient to read
+ * @params colours: positions in palette units
+ * @params rgb: filled with the colors
+ * @params n: number of positions
+ */
+void getGradientColors(const PaletteGradient_t* gradient, const float* colours, RGB_t* rgb, int n);
+
+#endif /* INC_PALETTEGRADIENT_H_ */
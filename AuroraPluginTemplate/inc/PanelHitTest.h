@@ -0,0 +1,125 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PanelHitTest.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_PANELHITTEST_H_
+#define INC_PANELHITTEST_H_
+
+#include "LayoutProcessingUtils.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * A panel crossed by a line, see PanelHitTester::traverseLine
+ */
+struct LineHit_t {
+	int panelIndex;		/*index into layoutData->panels*/
+	int panelId;
+	float tEnter;		/*distance along the line where it enters the panel, clamped to 0*/
+	float tExit;		/*distance along the line where it leaves the panel, clamped to the length of the line*/
+};
+
+/**
+ * Batched point-in-panel tests, as a faster replacement for calling isPointInsidePanel or pointInsideWhichPanel once
+ * per point.
+ * Every panel is flattened once into up to four edge half-planes plus its bounding box, so the tests need no virtual
+ * calls. Axis aligned squares are tested against their bounding box only, triangles and rotated squares against their
+ * half-planes. The per panel tests are vectorized over the points with SSE2 (AVX when compiled with -mavx), with a
+ * scalar fallback for other targets. Points are looked up through a uniform grid, so finding the panel of a point
+ * only tests the few panels around it; a vector of consecutive points that fall into the same cell is tested against
+ * the panels of that cell at once.
+ * The same grid and half-planes answer line and thick ray traversals (traverseLine).
+ * Call rebuild after the layout has been rotated or changed.
+ */
+class PanelHitTester {
+	PanelHitTester(const PanelHitTester&) = delete;
+	PanelHitTester& operator=(const PanelHitTester&) = delete;
+
+	struct PanelPlanes {
+		float a[4], b[4], c[4];		/*the point (x, y) is inside if a*x + b*y + c >= 0 for all four planes*/
+		float minX, minY, maxX, maxY;	/*bounding box*/
+		int isBox;					/*1 if the bounding box is the exact shape (axis aligned square)*/
+		int isValid;				/*0 for shapes that cannot be hit, e.g. rhythm modules without vertices*/
+	};
+
+	std::vector<PanelPlanes> panels;
+	std::vector<int> panelIds;
+	float originX, originY, cellSize;
+	int gridWidth, gridHeight;
+	std::vector<int> cellOffsets;		/*panels overlapping cell c are cellPanels[cellOffsets[c]] ... [cellOffsets[c+1] - 1]*/
+	std::vector<int> cellPanels;
+	std::vector<unsigned int> visitStamps;	/*marks the panels already tested by the current traversal*/
+	unsigned int visitStamp;
+
+	static bool isInside(const PanelPlanes& p, float x, float y);
+	static int getInsideBits(const PanelPlanes& p, const float* x, const float* y);
+	int getCell(float x, float y) const;
+	int getPointPanelIndex(float x, float y) const;
+	static bool clipLine(const PanelPlanes& p, float x0, float y0, float dx, float dy, float tMin, float tMax,
+			float halfWidth, float* tEnter, float* tExit);
+	void traverseLane(float x0, float y0, float dx, float dy, float tMin, float tMax, float lineX0, float lineY0,
+			float length, float halfWidth, std::vector<LineHit_t>* hits);
+
+public:
+	PanelHitTester(LayoutData* layoutData);
+
+	/**
+	 * @description: recomputes the half-planes and the grid from the current geometry of the layout
+	 */
+	void rebuild(LayoutData* layoutData);
+
+	/**
+	 * @description: finds, for every point, the panel it is inside
+	 * @params x, y: coordinates of the points
+	 * @params nPoints: number of points
+	 * @params panelIndices: filled with the index into layoutData->panels of the panel each point is inside, -1 if the
+	 * point is not inside any panel. A point on an edge shared by two panels is reported in one of them.
+	 * Fastest when consecutive points are close to each other, e.g. the rows of a raster or the samples along a line
+	 */
+	void getPanelIndices(const float* x, const float* y, int nPoints, int* panelIndices) const;
+
+	/**
+	 * @description: tests all points against a single panel
+	 * @params panelIndex: index into layoutData->panels of the panel to test
+	 * @params x, y: coordinates of the points
+	 * @params nPoints: number of points
+	 * @params mask: filled with 1 for every point inside the panel, 0 otherwise
+	 * @return: the number of points inside the panel
+	 */
+	int getPanelMask(int panelIndex, const float* x, const float* y, int nPoints, uint8_t* mask) const;
+
+	/**
+	 * @description: finds the panels a line or thick ray passes through, in the order it enters them.
+	 * Only the grid cells along the line are visited (a DDA walk, one lane per cell width of thickness), so the cost
+	 * grows with the number of panels crossed rather than with the size of the layout.
+	 * A thick ray hits a panel if it hits the panel with its edges pushed out by halfWidth, which slightly overestimates
+	 * the panel near its corners
+	 * @params x0, y0: start of the line
+	 * @params dx, dy: direction of the line, need not be normalized
+	 * @params length: length of the line, a negative value for a ray that runs to the end of the layout
+	 * @params halfWidth: half the thickness of the ray, 0 for a plain line
+	 * @params hits: filled with the panels crossed, sorted by increasing tEnter, then by panel index
+	 * @return: the number of panels crossed
+	 */
+	int traverseLine(float x0, float y0, float dx, float dy, float length, float halfWidth, std::vector<LineHit_t>* hits);
+};
+
+#endif /* INC_PANELHITTEST_H_ */
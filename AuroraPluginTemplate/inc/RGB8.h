@@ -0,0 +1,164 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * RGB8.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_RGB8_H_
+#define INC_RGB8_H_
+
+#include "ColorUtils.h"
+#include <stdint.h>
+
+/**
+ * Packed 8 bit color, 4 bytes instead of the 12 of RGB_t, so four times as many colors fit in a cache line.
+ * The arithmetic saturates at 0 and 255, so mixes need no limitRGB afterwards. It converts implicitly from RGB_t
+ * (clamping every channel into [0, 255]) and to RGB_t, so it can be passed wherever an RGB_t is expected, e.g. to
+ * fillFramesFromSlice.
+ * The single color operators work on all channels of the packed color at once, the array functions below are
+ * vectorized with SSE2.
+ */
+struct RGB8_t {
+	uint8_t R, G, B;
+	uint8_t pad;		/*always 0, keeps the color 4 bytes wide*/
+
+	RGB8_t() : R(0), G(0), B(0), pad(0) {}
+	RGB8_t(uint8_t r, uint8_t g, uint8_t b) : R(r), G(g), B(b), pad(0) {}
+	RGB8_t(const RGB_t& c) : R(clampChannel(c.R)), G(clampChannel(c.G)), B(clampChannel(c.B)), pad(0) {}
+
+	operator RGB_t() const {
+		RGB_t c = {R, G, B};
+		return c;
+	}
+
+	static uint8_t clampChannel(int x){
+		return (x < 0) ? 0 : ((x > 255) ? 255 : x);
+	}
+
+	//one byte per channel in a 32 bit word, compiles to a single load or store
+	uint32_t packed() const {
+		return R | (G << 8) | (B << 16) | ((uint32_t)pad << 24);
+	}
+
+	static RGB8_t fromPacked(uint32_t p){
+		RGB8_t c(p, p >> 8, p >> 16);
+		c.pad = p >> 24;
+		return c;
+	}
+};
+
+/**
+ * Saturating add and subtract of every channel. The four bytes are added as one 32 bit word with the high bit of
+ * every byte masked off, so no carry crosses into the next channel, then the carries and borrows out of every byte
+ * are turned into all 1 or all 0 bytes
+ */
+inline RGB8_t operator+ (const RGB8_t& l, const RGB8_t& r){
+	uint32_t a = l.packed(), b = r.packed();
+	uint32_t low = (a & 0x7F7F7F7F) + (b & 0x7F7F7F7F);
+	uint32_t sum = low ^ ((a ^ b) & 0x80808080);
+	uint32_t carry = ((a & b) | ((a | b) & ~sum)) & 0x80808080;
+	return RGB8_t::fromPacked(sum | ((carry >> 7)*0xFF));
+}
+
+inline RGB8_t operator- (const RGB8_t& l, const RGB8_t& r){
+	uint32_t a = l.packed(), b = r.packed();
+	uint32_t low = (a | 0x80808080) - (b & 0x7F7F7F7F);
+	uint32_t diff = low ^ ((a ^ b ^ 0x80808080) & 0x80808080);
+	uint32_t borrow = ((~a & b) | (~(a ^ b) & diff)) & 0x80808080;
+	return RGB8_t::fromPacked(diff & ~((borrow >> 7)*0xFF));
+}
+
+inline RGB8_t& operator+= (RGB8_t& l, const RGB8_t& r){
+	return l = l + r;
+}
+
+inline RGB8_t& operator-= (RGB8_t& l, const RGB8_t& r){
+	return l = l - r;
+}
+
+/**
+ * Saturating multiply of every channel by an integer, negative factors give black
+ */
+inline RGB8_t operator* (const RGB8_t& l, int m){
+	if (m <= 0){
+		return RGB8_t();
+	}
+	if (m > 255){
+		m = 255;	//any channel above 0 saturates anyway
+	}
+	return RGB8_t(RGB8_t::clampChannel(l.R*m), RGB8_t::clampChannel(l.G*m), RGB8_t::clampChannel(l.B*m));
+}
+
+inline RGB8_t operator* (int m, const RGB8_t& l){
+	return l*m;
+}
+
+inline bool operator== (const RGB8_t& l, const RGB8_t& r){
+	return l.packed() == r.packed();
+}
+
+inline bool operator!= (const RGB8_t& l, const RGB8_t& r){
+	return l.packed() != r.packed();
+}
+
+/**
+ * @description: scales every channel by factor/255, rounded to nearest. The fixed point replacement of
+ * (c*x)/255, e.g. for fading a color or mixing two colors with weights that add up to 255
+ * @params c: the color to scale
+ * @params factor: 0 gives black, 255 the color itself
+ * @return: the scaled color
+ */
+inline RGB8_t scaleRGB8(const RGB8_t& c, uint8_t factor){
+	//x/255 rounded, exact for x up to 255*255
+	uint32_t r = c.R*factor + 128, g = c.G*factor + 128, b = c.B*factor + 128;
+	return RGB8_t((r + (r >> 8)) >> 8, (g + (g >> 8)) >> 8, (b + (b >> 8)) >> 8);
+}
+
+/**
+ * @description: converts an array of colors to packed colors, clamping every channel into [0, 255]
+ * @params src: colors to convert from ...
+ * @params dst: ... packed colors to convert to
+ * @params nColors: number of colors
+ */
+void toRGB8(const RGB_t* src, RGB8_t* dst, int nColors);
+
+/**
+ * @description: converts an array of packed colors back to RGB_t
+ * @params src: packed colors to convert from ...
+ * @params dst: ... colors to convert to
+ * @params nColors: number of colors
+ */
+void toRGB(const RGB8_t* src, RGB_t* dst, int nColors);
+
+/**
+ * @description: saturating add of two arrays of colors, dst[i] = dst[i] + src[i]
+ */
+void addRGB8(RGB8_t* dst, const RGB8_t* src, int nColors);
+
+/**
+ * @description: saturating subtract of two arrays of colors, dst[i] = dst[i] - src[i]
+ */
+void subRGB8(RGB8_t* dst, const RGB8_t* src, int nColors);
+
+/**
+ * @description: scales an array of colors in place by factor/255, the same as scaleRGB8 on every color
+ */
+void scaleRGB8(RGB8_t* colors, uint8_t factor, int nColors);
+
+#endif /* INC_RGB8_H_ */
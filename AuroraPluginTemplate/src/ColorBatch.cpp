@@ -0,0 +1,228 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * ColorBatch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ColorBatch.h"
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * HSV to RGB works on x = V*((100 - S)*60 + S*f), f being the position of the hue within its 60 degree sector.
+ * x is at most 600000 and the channel value is x*255/600000 = x*17/40000, rounded. RGB to HSV only divides values
+ * below 2^18. Every intermediate value is an integer below 2^24, so float arithmetic is exact, and the floor of an
+ * exact float quotient is the integer quotient.
+ */
+
+static inline int clampInt(int x, int min, int max){
+	return (x < min) ? min : ((x > max) ? max : x);
+}
+
+static inline int wrapHue(int h){
+	h %= 360;
+	return (h < 0) ? h + 360 : h;
+}
+
+static inline int scaleToByte(int x){
+	return (17*x + 20000)/40000;
+}
+
+static inline int maxInt(int a, int b){
+	return (a > b) ? a : b;
+}
+
+static void hsvToRgb(const HSV_t& hsv, RGB_t* rgb){
+	int h = wrapHue(hsv.H), s = clampInt(hsv.S, 0, 100), v = clampInt(hsv.V, 0, 100);
+	int region = h/60;
+	int f = h - 60*region;
+	int base = (100 - s)*60;
+	int max = scaleToByte(v*6000);
+	int min = scaleToByte(v*base);
+	int up = scaleToByte(v*(base + s*f));
+	int down = scaleToByte(v*(base + s*(60 - f)));
+	switch (region){
+	case 0: *rgb = {max, up, min}; break;
+	case 1: *rgb = {down, max, min}; break;
+	case 2: *rgb = {min, max, up}; break;
+	case 3: *rgb = {min, down, max}; break;
+	case 4: *rgb = {up, min, max}; break;
+	default: *rgb = {max, min, down}; break;
+	}
+}
+
+static void rgbToHsv(const RGB_t& rgb, HSV_t* hsv){
+	int r = clampInt(rgb.R, 0, 255), g = clampInt(rgb.G, 0, 255), b = clampInt(rgb.B, 0, 255);
+	int max = maxInt(r, maxInt(g, b));
+	int min = -maxInt(-r, maxInt(-g, -b));
+	int c = max - min;
+	//offset by a multiple of c so the numerator stays positive, the hue is wrapped back below
+	int n = (max == r) ? 360*c + 60*(g - b) : ((max == g) ? 120*c + 60*(b - r) : 240*c + 60*(r - g));
+	int h = (2*n + c)/maxInt(2*c, 1);
+	hsv->H = (h >= 360) ? h - 360 : h;
+	hsv->S = (200*c + max)/maxInt(2*max, 1);
+	hsv->V = (200*max + 255)/510;
+}
+
+#if defined(__AVX__) || defined(__SSE2__)
+
+#if defined(__AVX__)
+#define COLOR_LANES 8
+typedef __m256 vfloat;
+static inline vfloat vset(float x){ return _mm256_set1_ps(x); }
+static inline vfloat vload(const float* p){ return _mm256_loadu_ps(p); }
+static inline void vstore(float* p, vfloat x){ _mm256_storeu_ps(p, x); }
+static inline vfloat vadd(vfloat a, vfloat b){ return _mm256_add_ps(a, b); }
+static inline vfloat vsub(vfloat a, vfloat b){ return _mm256_sub_ps(a, b); }
+static inline vfloat vmul(vfloat a, vfloat b){ return _mm256_mul_ps(a, b); }
+static inline vfloat vmax(vfloat a, vfloat b){ return _mm256_max_ps(a, b); }
+static inline vfloat vmin(vfloat a, vfloat b){ return _mm256_min_ps(a, b); }
+static inline vfloat veq(vfloat a, vfloat b){ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+static inline vfloat vor(vfloat a, vfloat b){ return _mm256_or_ps(a, b); }
+static inline vfloat vselect(vfloat mask, vfloat a, vfloat b){ return _mm256_blendv_ps(b, a, mask); }
+static inline vfloat vfloorDiv(vfloat n, vfloat d){ return _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_div_ps(n, d))); }
+static inline vfloat vless(vfloat a, vfloat b){ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static inline bool vany(vfloat mask){ return _mm256_movemask_ps(mask) != 0; }
+/*every third int from p, i.e. one field of consecutive HSV_t or RGB_t*/
+static inline vfloat vloadField(const int* p){
+	return _mm256_cvtepi32_ps(_mm256_set_epi32(p[21], p[18], p[15], p[12], p[9], p[6], p[3], p[0]));
+}
+static inline void vstoreInts(int* p, vfloat x){ _mm256_storeu_si256((__m256i*)p, _mm256_cvttps_epi32(x)); }
+#else
+#define COLOR_LANES 4
+typedef __m128 vfloat;
+static inline vfloat vset(float x){ return _mm_set1_ps(x); }
+static inline vfloat vload(const float* p){ return _mm_loadu_ps(p); }
+static inline void vstore(float* p, vfloat x){ _mm_storeu_ps(p, x); }
+static inline vfloat vadd(vfloat a, vfloat b){ return _mm_add_ps(a, b); }
+static inline vfloat vsub(vfloat a, vfloat b){ return _mm_sub_ps(a, b); }
+static inline vfloat vmul(vfloat a, vfloat b){ return _mm_mul_ps(a, b); }
+static inline vfloat vmax(vfloat a, vfloat b){ return _mm_max_ps(a, b); }
+static inline vfloat vmin(vfloat a, vfloat b){ return _mm_min_ps(a, b); }
+static inline vfloat veq(vfloat a, vfloat b){ return _mm_cmpeq_ps(a, b); }
+static inline vfloat vor(vfloat a, vfloat b){ return _mm_or_ps(a, b); }
+static inline vfloat vselect(vfloat mask, vfloat a, vfloat b){ return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+static inline vfloat vfloorDiv(vfloat n, vfloat d){ return _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(n, d))); }
+static inline vfloat vless(vfloat a, vfloat b){ return _mm_cmplt_ps(a, b); }
+static inline bool vany(vfloat mask){ return _mm_movemask_ps(mask) != 0; }
+static inline vfloat vloadField(const int* p){ return _mm_cvtepi32_ps(_mm_set_epi32(p[9], p[6], p[3], p[0])); }
+static inline void vstoreInts(int* p, vfloat x){ _mm_storeu_si128((__m128i*)p, _mm_cvttps_epi32(x)); }
+#endif
+
+/*hues of this magnitude and above are wrapped by the scalar code, below it h/360 is exact enough to truncate*/
+#define VECTOR_HUE_LIMIT 4194304.0f
+
+static inline vfloat vclamp(vfloat x, float min, float max){
+	return vmin(vmax(x, vset(min)), vset(max));
+}
+
+static inline vfloat vscaleToByte(vfloat x){
+	return vfloorDiv(vadd(vmul(x, vset(17)), vset(20000)), vset(40000));
+}
+
+/**
+ * @description: converts COLOR_LANES colors with the vector functions. Returns false, without writing anything, if a
+ * hue is too large to be wrapped exactly in float
+ */
+static bool hsvToRgbLanes(const HSV_t* hsv, RGB_t* rgb){
+	vfloat vh = vloadField(&hsv[0].H);
+	vfloat limit = vset(VECTOR_HUE_LIMIT);
+	if (vany(vless(limit, vmax(vh, vsub(vset(0), vh))))){
+		return false;
+	}
+	//truncating division leaves a remainder in (-360, 360), negative ones are moved up by a turn
+	vh = vsub(vh, vmul(vfloorDiv(vh, vset(360)), vset(360)));
+	vh = vadd(vh, vselect(vless(vh, vset(0)), vset(360), vset(0)));
+	vfloat vs = vclamp(vloadField(&hsv[0].S), 0, 100), vv = vclamp(vloadField(&hsv[0].V), 0, 100);
+
+	vfloat region = vfloorDiv(vh, vset(60));
+	vfloat f = vsub(vh, vmul(region, vset(60)));
+	vfloat base = vmul(vsub(vset(100), vs), vset(60));
+	vfloat max = vscaleToByte(vmul(vv, vset(6000)));
+	vfloat min = vscaleToByte(vmul(vv, base));
+	vfloat up = vscaleToByte(vmul(vv, vadd(base, vmul(vs, f))));
+	vfloat down = vscaleToByte(vmul(vv, vadd(base, vmul(vs, vsub(vset(60), f)))));
+	vfloat r0 = veq(region, vset(0)), r1 = veq(region, vset(1)), r2 = veq(region, vset(2));
+	vfloat r3 = veq(region, vset(3)), r4 = veq(region, vset(4)), r5 = veq(region, vset(5));
+	int r[COLOR_LANES], g[COLOR_LANES], b[COLOR_LANES];
+	vstoreInts(r, vselect(vor(r0, r5), max, vselect(r1, down, vselect(r4, up, min))));
+	vstoreInts(g, vselect(vor(r1, r2), max, vselect(r0, up, vselect(r3, down, min))));
+	vstoreInts(b, vselect(vor(r3, r4), max, vselect(r2, up, vselect(r5, down, min))));
+	for (int k = 0; k < COLOR_LANES; k++){
+		rgb[k] = {r[k], g[k], b[k]};
+	}
+	return true;
+}
+
+/**
+ * @description: converts COLOR_LANES colors with the vector functions
+ */
+static void rgbToHsvLanes(const RGB_t* rgb, HSV_t* hsv){
+	vfloat vr = vclamp(vloadField(&rgb[0].R), 0, 255);
+	vfloat vg = vclamp(vloadField(&rgb[0].G), 0, 255);
+	vfloat vb = vclamp(vloadField(&rgb[0].B), 0, 255);
+	vfloat max = vmax(vr, vmax(vg, vb));
+	vfloat c = vsub(max, vmin(vr, vmin(vg, vb)));
+	vfloat sixty = vset(60);
+	vfloat n = vselect(veq(max, vr), vadd(vmul(vset(360), c), vmul(sixty, vsub(vg, vb))),
+			vselect(veq(max, vg), vadd(vmul(vset(120), c), vmul(sixty, vsub(vb, vr))),
+					vadd(vmul(vset(240), c), vmul(sixty, vsub(vr, vg)))));
+	vfloat hue = vfloorDiv(vadd(vadd(n, n), c), vmax(vadd(c, c), vset(1)));
+	vfloat wrap = veq(vmin(hue, vset(360)), vset(360));
+	int h[COLOR_LANES], s[COLOR_LANES], v[COLOR_LANES];
+	vstoreInts(h, vsub(hue, vselect(wrap, vset(360), vset(0))));
+	vstoreInts(s, vfloorDiv(vadd(vmul(vset(200), c), max), vmax(vadd(max, max), vset(1))));
+	vstoreInts(v, vfloorDiv(vadd(vmul(vset(200), max), vset(255)), vset(510)));
+	for (int k = 0; k < COLOR_LANES; k++){
+		hsv[k] = {h[k], s[k], v[k]};
+	}
+}
+
+#endif
+
+void HSVtoRGBBatch(const HSV_t* hsv, RGB_t* rgb, int nColors){
+	int i = 0;
+#ifdef COLOR_LANES
+	for (; i + COLOR_LANES <= nColors; i += COLOR_LANES){
+		if (!hsvToRgbLanes(&hsv[i], &rgb[i])){
+			for (int k = 0; k < COLOR_LANES; k++){
+				hsvToRgb(hsv[i + k], &rgb[i + k]);
+			}
+		}
+	}
+#endif
+	for (; i < nColors; i++){
+		hsvToRgb(hsv[i], &rgb[i]);
+	}
+}
+
+void RGBtoHSVBatch(const RGB_t* rgb, HSV_t* hsv, int nColors){
+	int i = 0;
+#ifdef COLOR_LANES
+	for (; i + COLOR_LANES <= nColors; i += COLOR_LANES){
+		rgbToHsvLanes(&rgb[i], &hsv[i]);
+	}
+#endif
+	for (; i < nColors; i++){
+		rgbToHsv(rgb[i], &hsv[i]);
+	}
+}
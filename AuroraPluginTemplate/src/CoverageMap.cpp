@@ -0,0 +1,159 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * CoverageMap.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "CoverageMap.h"
+#include <math.h>
+
+#define WEIGHT_ONE 65535
+
+CoverageMap::CoverageMap(LayoutData* layoutData, int width, int height){
+	rebuild(layoutData, width, height);
+}
+
+void CoverageMap::rebuild(LayoutData* layoutData, int width, int height){
+	this->width = (width > 0) ? width : 1;
+	this->height = (height > 0) ? height : 1;
+	nPanels = layoutData->nPanels;
+	panelIds.resize(nPanels);
+	offsets.assign(1, 0);
+	pixels.clear();
+	weights.clear();
+	if (nPanels == 0){
+		return;
+	}
+
+	//the raster spans the bounding box of all vertices (centroids for shapes without vertices)
+	double minX = 0, minY = 0, maxX = 0, maxY = 0;
+	bool first = true;
+	for (int i = 0; i < nPanels; i++){
+		Shape* shape = layoutData->panels[i].shape;
+		int n = (shape->nVertices > 0) ? shape->nVertices : 1;
+		for (int k = 0; k < n; k++){
+			const Point& p = (shape->nVertices > 0) ? shape->vertices[k] : shape->getCentroid();
+			minX = (first || p.x < minX) ? p.x : minX;
+			maxX = (first || p.x > maxX) ? p.x : maxX;
+			minY = (first || p.y < minY) ? p.y : minY;
+			maxY = (first || p.y > maxY) ? p.y : maxY;
+			first = false;
+		}
+	}
+	double pixelWidth = (maxX > minX) ? (maxX - minX)/this->width : 1;
+	double pixelHeight = (maxY > minY) ? (maxY - minY)/this->height : 1;
+
+	std::vector<int> counts;
+	for (int i = 0; i < nPanels; i++){
+		Shape* shape = layoutData->panels[i].shape;
+		panelIds[i] = layoutData->panels[i].panelId;
+		size_t start = pixels.size();
+		counts.clear();
+		int total = 0;
+
+		if (shape->nVertices > 0){
+			double sMinX = shape->vertices[0].x, sMaxX = sMinX, sMinY = shape->vertices[0].y, sMaxY = sMinY;
+			for (int k = 1; k < shape->nVertices; k++){
+				const Point& p = shape->vertices[k];
+				sMinX = (p.x < sMinX) ? p.x : sMinX;
+				sMaxX = (p.x > sMaxX) ? p.x : sMaxX;
+				sMinY = (p.y < sMinY) ? p.y : sMinY;
+				sMaxY = (p.y > sMaxY) ? p.y : sMaxY;
+			}
+			int c0 = (int)floor((sMinX - minX)/pixelWidth), c1 = (int)floor((sMaxX - minX)/pixelWidth);
+			int r0 = (int)floor((maxY - sMaxY)/pixelHeight), r1 = (int)floor((maxY - sMinY)/pixelHeight);
+			c0 = (c0 < 0) ? 0 : c0;
+			r0 = (r0 < 0) ? 0 : r0;
+			c1 = (c1 >= this->width) ? this->width - 1 : c1;
+			r1 = (r1 >= this->height) ? this->height - 1 : r1;
+			for (int r = r0; r <= r1; r++){
+				for (int c = c0; c <= c1; c++){
+					int covered = 0;
+					for (int sy = 0; sy < COVERAGE_MAP_SUBSAMPLES; sy++){
+						for (int sx = 0; sx < COVERAGE_MAP_SUBSAMPLES; sx++){
+							Point p(minX + (c + (sx + 0.5)/COVERAGE_MAP_SUBSAMPLES)*pixelWidth,
+									maxY - (r + (sy + 0.5)/COVERAGE_MAP_SUBSAMPLES)*pixelHeight);
+							covered += shape->isPointInsideShape(p) ? 1 : 0;
+						}
+					}
+					if (covered > 0){
+						pixels.push_back(r*this->width + c);
+						counts.push_back(covered);
+						total += covered;
+					}
+				}
+			}
+		}
+
+		if (total == 0){
+			//the shape is smaller than the subsampling grid (or has no vertices), use the pixel under its centroid
+			const Point& centroid = shape->getCentroid();
+			int c = (int)floor((centroid.x - minX)/pixelWidth);
+			int r = (int)floor((maxY - centroid.y)/pixelHeight);
+			c = (c < 0) ? 0 : ((c >= this->width) ? this->width - 1 : c);
+			r = (r < 0) ? 0 : ((r >= this->height) ? this->height - 1 : r);
+			pixels.push_back(r*this->width + c);
+			counts.push_back(1);
+			total = 1;
+		}
+
+		//normalize to WEIGHT_ONE, handing the rounding remainder to the largest weight so the sum is exact
+		int sum = 0, largest = 0;
+		for (unsigned int k = 0; k < counts.size(); k++){
+			int w = (int)(((int64_t)counts[k]*WEIGHT_ONE)/total);
+			weights.push_back(w);
+			sum += w;
+			if (counts[k] > counts[largest]){
+				largest = k;
+			}
+		}
+		weights[start + largest] += WEIGHT_ONE - sum;
+		offsets.push_back(pixels.size());
+	}
+}
+
+int CoverageMap::sampleImage(const uint8_t* rgb, int transTime, Frame_t* frames) const {
+	for (int i = 0; i < nPanels; i++){
+		uint32_t r = 0, g = 0, b = 0;
+		for (int k = offsets[i]; k < offsets[i + 1]; k++){
+			const uint8_t* px = rgb + 3*pixels[k];
+			uint32_t w = weights[k];
+			r += w*px[0];
+			g += w*px[1];
+			b += w*px[2];
+		}
+		frames[i].panelId = panelIds[i];
+		frames[i].r = (r + WEIGHT_ONE/2)/WEIGHT_ONE;
+		frames[i].g = (g + WEIGHT_ONE/2)/WEIGHT_ONE;
+		frames[i].b = (b + WEIGHT_ONE/2)/WEIGHT_ONE;
+		frames[i].transTime = transTime;
+	}
+	return nPanels;
+}
+
+void CoverageMap::sampleChannel(const float* image, float* values) const {
+	const float scale = 1.0f/WEIGHT_ONE;
+	for (int i = 0; i < nPanels; i++){
+		float sum = 0;
+		for (int k = offsets[i]; k < offsets[i + 1]; k++){
+			sum += weights[k]*image[pixels[k]];
+		}
+		values[i] = sum*scale;
+	}
+}
@@ -0,0 +1,148 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutGenerator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "LayoutGenerator.h"
+#include <math.h>
+#include <limits.h>
+#include <stdint.h>
+#include <random>
+#include <unordered_set>
+
+/*
+ * Triangles live on a lattice of cells (i, j): j is the row, i the position in the row. Cell (i, j) points up when
+ * i + j is even and down otherwise. Its neighbours are (i - 1, j), (i + 1, j) and, through its horizontal edge, the
+ * cell below it if it points up or the cell above it if it points down.
+ * Squares live on a plain grid with four neighbours.
+ * Triangle (i, j) is centered at x = i*side/2 and square (i, j) at x = i*side, so the up triangles of a row (even i in
+ * row 0) are centered over square columns i/2.
+ */
+struct Cell {
+	int i, j;
+};
+
+static inline int64_t cellKey(int i, int j){
+	return (int64_t)(((uint64_t)(uint32_t)i << 32) | (uint32_t)j);
+}
+
+static inline bool isTriangleUp(int i, int j){
+	return ((i + j) & 1) == 0;
+}
+
+/**
+ * @description: grows nCells connected cells from (0, 0), by repeatedly occupying a random cell next to the grown ones.
+ * Only rows jMin ... jMax are used
+ */
+static void growCells(int shapeType, int nCells, int jMin, int jMax, std::mt19937& rng, std::vector<Cell>& cells){
+	std::unordered_set<int64_t> occupied;
+	std::vector<Cell> frontier;
+	frontier.push_back(Cell{0, 0});
+	cells.clear();
+	while ((int)cells.size() < nCells && !frontier.empty()){
+		//the modulo keeps the sequence identical on every standard library, unlike std::uniform_int_distribution
+		size_t pick = rng() % frontier.size();
+		Cell cell = frontier[pick];
+		frontier[pick] = frontier.back();
+		frontier.pop_back();
+		if (cell.j < jMin || cell.j > jMax || !occupied.insert(cellKey(cell.i, cell.j)).second){
+			continue;
+		}
+		cells.push_back(cell);
+		frontier.push_back(Cell{cell.i - 1, cell.j});
+		frontier.push_back(Cell{cell.i + 1, cell.j});
+		if (shapeType == SHAPE_SQUARE){
+			frontier.push_back(Cell{cell.i, cell.j - 1});
+			frontier.push_back(Cell{cell.i, cell.j + 1});
+		}
+		else {
+			frontier.push_back(Cell{cell.i, isTriangleUp(cell.i, cell.j) ? cell.j - 1 : cell.j + 1});
+		}
+	}
+}
+
+static void emitSquares(const std::vector<Cell>& cells, std::vector<int>* stream){
+	for (unsigned int k = 0; k < cells.size(); k++){
+		stream->push_back(stream->size()/LAYOUT_STREAM_INTS_PER_PANEL + 1);
+		stream->push_back(cells[k].i*LAYOUT_GENERATOR_SIDE);
+		stream->push_back(cells[k].j*LAYOUT_GENERATOR_SIDE);
+		stream->push_back(0);
+		stream->push_back(SHAPE_SQUARE);
+	}
+}
+
+/**
+ * @description: appends the triangles, row 0 having its bottom at yBase
+ */
+static void emitTriangles(const std::vector<Cell>& cells, double yBase, std::vector<int>* stream){
+	const double rowHeight = LAYOUT_GENERATOR_SIDE*sqrt(3.0)/2;
+	const double inradius = rowHeight/3;
+	for (unsigned int k = 0; k < cells.size(); k++){
+		bool up = isTriangleUp(cells[k].i, cells[k].j);
+		double y = yBase + cells[k].j*rowHeight + (up ? inradius : 2*inradius);
+		stream->push_back(stream->size()/LAYOUT_STREAM_INTS_PER_PANEL + 1);
+		stream->push_back(cells[k].i*LAYOUT_GENERATOR_SIDE/2);
+		stream->push_back((int)lround(y));
+		stream->push_back(up ? 0 : 60);
+		stream->push_back(SHAPE_TRIANGLE);
+	}
+}
+
+int generateLayoutByteStream(int shapeType, int nPanels, unsigned int seed, std::vector<int>* stream){
+	std::mt19937 rng(seed);
+	std::vector<Cell> cells;
+	stream->clear();
+	if (nPanels <= 0){
+		return 0;
+	}
+	stream->reserve(nPanels*LAYOUT_STREAM_INTS_PER_PANEL);
+
+	switch (shapeType){
+	case SHAPE_TRIANGLE:
+		growCells(SHAPE_TRIANGLE, nPanels, INT_MIN, INT_MAX, rng, cells);
+		emitTriangles(cells, 0, stream);
+		break;
+	case SHAPE_SQUARE:
+		growCells(SHAPE_SQUARE, nPanels, INT_MIN, INT_MAX, rng, cells);
+		emitSquares(cells, stream);
+		break;
+	case LAYOUT_GENERATOR_MIXED:
+		//squares fill rows 0 and below, triangles rows 0 and above, starting with the up triangle standing on the
+		//top edge of square (0, 0). Triangle row 0 starts at the top of square row 0
+		growCells(SHAPE_SQUARE, (nPanels + 1)/2, INT_MIN, 0, rng, cells);
+		emitSquares(cells, stream);
+		growCells(SHAPE_TRIANGLE, nPanels/2, 0, INT_MAX, rng, cells);
+		emitTriangles(cells, LAYOUT_GENERATOR_SIDE/2, stream);
+		break;
+	default:
+		return -1;
+	}
+	return stream->size()/LAYOUT_STREAM_INTS_PER_PANEL;
+}
+
+int generateLayoutData(int shapeType, int nPanels, unsigned int seed, LayoutData** layoutData){
+	std::vector<int> stream;
+	int n = generateLayoutByteStream(shapeType, nPanels, seed, &stream);
+	if (n < 0){
+		return -1;
+	}
+	parseLayoutData(stream.data(), n, layoutData);
+	return n;
+}
@@ -0,0 +1,205 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutUpdates.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "LayoutUpdates.h"
+#include "DataManager.h"
+#include "Logger.h"
+#include <mutex>
+#include <set>
+#include <vector>
+
+struct PanelEntry {
+	int panelId;
+	Shape* shape;
+};
+
+/*
+ * The panel ids the layout has once every list accepted by passLayoutDeltas is applied. Seeded from the layout of the
+ * DataManager by the first update, before the plugin was handed any deltas, and only touched by the host after that
+ */
+static std::mutex hostPanelIdsMutex;
+static std::set<int> hostPanelIds;
+static bool isHostPanelIdsSeeded = false;
+
+/**
+ * @description: validates deltas in order against a set of panel ids, updating it as they would
+ */
+static int validateDeltas(std::set<int>* panelIds, const LayoutDelta_t* deltas, int nDeltas){
+	for (int i = 0; i < nDeltas; i++){
+		switch (deltas[i].type){
+		case LAYOUT_DELTA_ADD:
+			if (!panelIds->insert(deltas[i].panelId).second){
+				return LAYOUT_UPDATE_ERROR_PANEL_EXISTS;
+			}
+			break;
+		case LAYOUT_DELTA_REMOVE:
+			if (panelIds->erase(deltas[i].panelId) == 0){
+				return LAYOUT_UPDATE_ERROR_PANEL_NO_EXIST;
+			}
+			break;
+		case LAYOUT_DELTA_MOVE:
+			if (panelIds->count(deltas[i].panelId) == 0){
+				return LAYOUT_UPDATE_ERROR_PANEL_NO_EXIST;
+			}
+			break;
+		default:
+			return LAYOUT_UPDATE_ERROR_WRONG_DELTA_TYPE;
+		}
+	}
+	return 0;
+}
+
+static void getPanelIds(const LayoutData* layoutData, std::set<int>* panelIds){
+	panelIds->clear();
+	for (int i = 0; i < layoutData->nPanels; i++){
+		panelIds->insert(layoutData->panels[i].panelId);
+	}
+}
+
+int validateLayoutDeltas(LayoutData* layoutData, const LayoutDelta_t* deltas, int nDeltas){
+	std::set<int> panelIds;
+	getPanelIds(layoutData, &panelIds);
+	return validateDeltas(&panelIds, deltas, nDeltas);
+}
+
+void LayoutDeltaQueue::push(const LayoutDelta_t* deltas, int nDeltas){
+	std::lock_guard<std::mutex> lock(mutex);
+	pending.insert(pending.end(), deltas, deltas + nDeltas);
+}
+
+int LayoutDeltaQueue::take(std::vector<LayoutDelta_t>* deltas){
+	std::lock_guard<std::mutex> lock(mutex);
+	deltas->swap(pending);
+	pending.clear();
+	return deltas->size();
+}
+
+/**
+ * @description: creates the shape of an added panel. The concrete shape classes live in the utilities library, so the
+ * panel is parsed as a one panel layout and its shape is taken over. The centroid and orientation are then set
+ * explicitly, in case parsing moved the lone panel
+ */
+static Shape* createShape(const LayoutDelta_t& delta, const Point& centroid, int orientation){
+	int stream[] = {delta.panelId, delta.x, delta.y, delta.orientation, delta.shapeType};
+	LayoutData* parsed = NULL;
+	parseLayoutData(stream, 1, &parsed);
+	if (!parsed || parsed->nPanels != 1){
+		return NULL;
+	}
+	Shape* shape = parsed->panels[0].shape;
+	parsed->panels[0].shape = NULL;
+	freeLayoutData(parsed);
+
+	Point at = centroid;
+	shape->updateShape(&at, &orientation);
+	return shape;
+}
+
+static int findPanel(const std::vector<PanelEntry>& panels, int panelId){
+	for (unsigned int i = 0; i < panels.size(); i++){
+		if (panels[i].panelId == panelId){
+			return i;
+		}
+	}
+	return -1;
+}
+
+int applyLayoutDeltas(LayoutData* layoutData, const LayoutDelta_t* deltas, int nDeltas, int totalAuroraRotation){
+	int ret = validateLayoutDeltas(layoutData, deltas, nDeltas);
+	if (ret != 0){
+		return ret;
+	}
+
+	//work on a list of (panelId, shape) and only rebuild the panels array once at the end
+	std::vector<PanelEntry> panels(layoutData->nPanels);
+	for (int i = 0; i < layoutData->nPanels; i++){
+		panels[i].panelId = layoutData->panels[i].panelId;
+		panels[i].shape = layoutData->panels[i].shape;
+		layoutData->panels[i].shape = NULL;
+	}
+	for (int i = 0; i < nDeltas; i++){
+		const LayoutDelta_t& delta = deltas[i];
+		Point centroid = getLayoutDeltaCentroid(layoutData, delta, totalAuroraRotation);
+		int orientation = delta.orientation + totalAuroraRotation;
+		if (delta.type == LAYOUT_DELTA_ADD){
+			PanelEntry entry = {delta.panelId, createShape(delta, centroid, orientation)};
+			if (entry.shape){
+				panels.push_back(entry);
+			}
+			else {
+				PRINTLOG("Could not create the shape of panel %d\n", delta.panelId);
+			}
+			continue;
+		}
+		int index = findPanel(panels, delta.panelId);
+		if (index < 0){
+			continue;	//only possible if an earlier add failed
+		}
+		if (delta.type == LAYOUT_DELTA_REMOVE){
+			delete panels[index].shape;
+			panels.erase(panels.begin() + index);
+		}
+		else {
+			panels[index].shape->updateShape(&centroid, &orientation);
+		}
+	}
+
+	delete [] layoutData->panels;
+	layoutData->nPanels = panels.size();
+	layoutData->panels = panels.empty() ? NULL : new Panel[panels.size()];
+	for (unsigned int i = 0; i < panels.size(); i++){
+		layoutData->panels[i].panelId = panels[i].panelId;
+		layoutData->panels[i].shape = panels[i].shape;
+	}
+	return 0;
+}
+
+int passLayoutDeltas(int* deltaByteStream, int nDeltas){
+	if (!pluginLayoutChanged){
+		return LAYOUT_UPDATE_NOT_HANDLED;
+	}
+	std::vector<LayoutDelta_t> deltas(nDeltas);
+	for (int i = 0; i < nDeltas; i++){
+		const int* d = deltaByteStream + i*LAYOUT_DELTA_INTS;
+		deltas[i].type = d[0];
+		deltas[i].panelId = d[1];
+		deltas[i].x = d[2];
+		deltas[i].y = d[3];
+		deltas[i].orientation = d[4];
+		deltas[i].shapeType = d[5];
+	}
+	LayoutData* layoutData = getLayoutData();
+	std::lock_guard<std::mutex> lock(hostPanelIdsMutex);
+	if (!isHostPanelIdsSeeded){
+		getPanelIds(layoutData, &hostPanelIds);
+		isHostPanelIdsSeeded = true;
+	}
+	std::set<int> panelIds(hostPanelIds);
+	int ret = validateDeltas(&panelIds, deltas.data(), nDeltas);
+	if (ret != 0){
+		PRINTLOG("Layout update rejected (%d), restart required\n", ret);
+		return ret;
+	}
+	hostPanelIds.swap(panelIds);
+	pluginLayoutChanged(layoutData, deltas.data(), nDeltas);
+	return 0;
+}
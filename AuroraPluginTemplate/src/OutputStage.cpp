@@ -0,0 +1,141 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * OutputStage.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "OutputStage.h"
+#include <math.h>
+#include <algorithm>
+
+static void buildPanelLuts(OutputStage_t* outputStage, const float* curve, int panelIndex){
+	for (int c = 0; c < 3; c++){
+		float gain = (panelIndex < outputStage->nPanels) ? outputStage->calibration[panelIndex*3 + c] : 1.0f;
+		uint8_t* lut = outputStage->luts + (panelIndex*3 + c)*256;
+		for (int v = 0; v < 256; v++){
+			float out = curve[v]*gain + 0.5f;
+			lut[v] = (out < 255.0f) ? (int)out : 255;
+		}
+	}
+}
+
+//the gamma curve and brightness, in [0, 255 * brightness]
+static void buildCurve(const OutputStage_t* outputStage, float* curve){
+	for (int v = 0; v < 256; v++){
+		curve[v] = 255.0f*outputStage->brightness*powf(v/255.0f, outputStage->gamma);
+	}
+}
+
+static void buildLuts(OutputStage_t* outputStage){
+	float curve[256];
+	buildCurve(outputStage, curve);
+	for (int i = 0; i <= outputStage->nPanels; i++){
+		buildPanelLuts(outputStage, curve, i);
+	}
+}
+
+void getOutputStage(LayoutData* layoutData, OutputStage_t* outputStage){
+	int n = layoutData->nPanels;
+	if (n > outputStage->capacity || !outputStage->luts){
+		delete [] outputStage->panelIds;
+		delete [] outputStage->calibration;
+		delete [] outputStage->luts;
+		delete [] outputStage->sortedIds;
+		delete [] outputStage->sortedIndices;
+		outputStage->panelIds = new int[n];
+		outputStage->calibration = new float[n*3];
+		outputStage->luts = new uint8_t[(n + 1)*3*256];
+		outputStage->sortedIds = new int[n];
+		outputStage->sortedIndices = new int[n];
+		outputStage->capacity = n;
+	}
+	outputStage->nPanels = n;
+	outputStage->gamma = 1;
+	outputStage->brightness = 1;
+
+	for (int i = 0; i < n; i++){
+		outputStage->panelIds[i] = layoutData->panels[i].panelId;
+		outputStage->sortedIndices[i] = i;
+		outputStage->calibration[i*3] = 1;
+		outputStage->calibration[i*3 + 1] = 1;
+		outputStage->calibration[i*3 + 2] = 1;
+	}
+	const int* ids = outputStage->panelIds;
+	std::sort(outputStage->sortedIndices, outputStage->sortedIndices + n,
+			[ids](int l, int r){ return ids[l] < ids[r]; });
+	for (int i = 0; i < n; i++){
+		outputStage->sortedIds[i] = ids[outputStage->sortedIndices[i]];
+	}
+	buildLuts(outputStage);
+}
+
+void setOutputGamma(OutputStage_t* outputStage, float gamma){
+	if (gamma <= 0){
+		return;
+	}
+	outputStage->gamma = gamma;
+	buildLuts(outputStage);
+}
+
+void setOutputBrightness(OutputStage_t* outputStage, float brightness){
+	outputStage->brightness = (brightness > 0) ? brightness : 0;
+	buildLuts(outputStage);
+}
+
+static int findPanel(const OutputStage_t* outputStage, int panelId){
+	const int* begin = outputStage->sortedIds;
+	const int* end = begin + outputStage->nPanels;
+	const int* it = std::lower_bound(begin, end, panelId);
+	if (it == end || *it != panelId){
+		return -1;
+	}
+	return outputStage->sortedIndices[it - begin];
+}
+
+int setPanelCalibration(OutputStage_t* outputStage, int panelId, float r, float g, float b){
+	int index = findPanel(outputStage, panelId);
+	if (index < 0){
+		return OUTPUT_STAGE_ERROR_PANEL_NO_EXIST;
+	}
+	outputStage->calibration[index*3] = (r > 0) ? r : 0;
+	outputStage->calibration[index*3 + 1] = (g > 0) ? g : 0;
+	outputStage->calibration[index*3 + 2] = (b > 0) ? b : 0;
+	float curve[256];
+	buildCurve(outputStage, curve);
+	buildPanelLuts(outputStage, curve, index);
+	return 0;
+}
+
+static inline int clampChannel(int x){
+	return (x < 0) ? 0 : ((x > 255) ? 255 : x);
+}
+
+void applyOutputStage(const OutputStage_t* outputStage, Frame_t* frames, int nFrames){
+	int n = outputStage->nPanels;
+	for (int i = 0; i < nFrames; i++){
+		Frame_t& frame = frames[i];
+		int index = (i < n && outputStage->panelIds[i] == frame.panelId) ? i : findPanel(outputStage, frame.panelId);
+		if (index < 0){
+			index = n;
+		}
+		frame.r = getOutputLut(outputStage, index, 0)[clampChannel(frame.r)];
+		frame.g = getOutputLut(outputStage, index, 1)[clampChannel(frame.g)];
+		frame.b = getOutputLut(outputStage, index, 2)[clampChannel(frame.b)];
+	}
+}
@@ -0,0 +1,419 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PanelHitTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "PanelHitTest.h"
+#include <math.h>
+#include <string.h>
+#include <float.h>
+#include <algorithm>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*edges whose direction is within this fraction of the side length from an axis count as axis aligned*/
+#define AXIS_ALIGNED_TOLERANCE 1e-3
+
+/*points tested at once against a panel*/
+#if defined(__AVX__)
+#define HIT_TEST_LANES 8
+#elif defined(__SSE2__)
+#define HIT_TEST_LANES 4
+#else
+#define HIT_TEST_LANES 1
+#endif
+
+PanelHitTester::PanelHitTester(LayoutData* layoutData){
+	rebuild(layoutData);
+}
+
+void PanelHitTester::rebuild(LayoutData* layoutData){
+	int n = layoutData->nPanels;
+	panels.assign(n, PanelPlanes());
+	panelIds.resize(n);
+	visitStamps.assign(n, 0);
+	visitStamp = 0;
+	float maxSize = 0;
+	bool first = true;
+	originX = originY = 0;
+	for (int i = 0; i < n; i++){
+		Shape* shape = layoutData->panels[i].shape;
+		PanelPlanes& p = panels[i];
+		memset(&p, 0, sizeof(p));
+		panelIds[i] = layoutData->panels[i].panelId;
+		int nVertices = shape->nVertices;
+		if (nVertices < 3 || nVertices > 4){
+			continue;
+		}
+		p.isValid = 1;
+
+		//orient the edges counter clockwise, whatever the winding of the vertices
+		double signedArea = 0;
+		for (int k = 0; k < nVertices; k++){
+			const Point& v1 = shape->vertices[k];
+			const Point& v2 = shape->vertices[(k + 1) % nVertices];
+			signedArea += v1.x*v2.y - v2.x*v1.y;
+		}
+		double winding = (signedArea >= 0) ? 1 : -1;
+
+		bool isBox = (nVertices == 4);
+		p.minX = p.maxX = shape->vertices[0].x;
+		p.minY = p.maxY = shape->vertices[0].y;
+		for (int k = 0; k < nVertices; k++){
+			const Point& v1 = shape->vertices[k];
+			const Point& v2 = shape->vertices[(k + 1) % nVertices];
+			double dx = v2.x - v1.x, dy = v2.y - v1.y;
+			double a = -dy*winding, b = dx*winding;
+			p.a[k] = a;
+			p.b[k] = b;
+			p.c[k] = -(a*v1.x + b*v1.y);
+			double length = sqrt(dx*dx + dy*dy);
+			if (fabs(dx) > AXIS_ALIGNED_TOLERANCE*length && fabs(dy) > AXIS_ALIGNED_TOLERANCE*length){
+				isBox = false;
+			}
+			p.minX = (v1.x < p.minX) ? v1.x : p.minX;
+			p.maxX = (v1.x > p.maxX) ? v1.x : p.maxX;
+			p.minY = (v1.y < p.minY) ? v1.y : p.minY;
+			p.maxY = (v1.y > p.maxY) ? v1.y : p.maxY;
+		}
+		//triangles get an always true fourth plane, so every panel is tested against four planes
+		for (int k = nVertices; k < 4; k++){
+			p.a[k] = 0;
+			p.b[k] = 0;
+			p.c[k] = 1;
+		}
+		p.isBox = isBox;
+
+		float size = (p.maxX - p.minX > p.maxY - p.minY) ? p.maxX - p.minX : p.maxY - p.minY;
+		maxSize = (size > maxSize) ? size : maxSize;
+		originX = (first || p.minX < originX) ? p.minX : originX;
+		originY = (first || p.minY < originY) ? p.minY : originY;
+		first = false;
+	}
+
+	//uniform grid with cells at least as large as any panel, so every panel overlaps at most four cells
+	cellSize = (maxSize > 0) ? maxSize : 1;
+	float maxX = originX, maxY = originY;
+	for (int i = 0; i < n; i++){
+		if (panels[i].isValid){
+			maxX = (panels[i].maxX > maxX) ? panels[i].maxX : maxX;
+			maxY = (panels[i].maxY > maxY) ? panels[i].maxY : maxY;
+		}
+	}
+	gridWidth = (n == 0) ? 0 : (int)((maxX - originX)/cellSize) + 1;
+	gridHeight = (n == 0) ? 0 : (int)((maxY - originY)/cellSize) + 1;
+	cellOffsets.assign(gridWidth*gridHeight + 1, 0);
+	for (int pass = 0; pass < 2; pass++){
+		std::vector<int> cursor(cellOffsets.begin(), cellOffsets.end() - 1);
+		for (int i = 0; i < n; i++){
+			const PanelPlanes& p = panels[i];
+			if (!p.isValid){
+				continue;
+			}
+			int x0 = (int)((p.minX - originX)/cellSize), x1 = (int)((p.maxX - originX)/cellSize);
+			int y0 = (int)((p.minY - originY)/cellSize), y1 = (int)((p.maxY - originY)/cellSize);
+			for (int cy = y0; cy <= y1 && cy < gridHeight; cy++){
+				for (int cx = x0; cx <= x1 && cx < gridWidth; cx++){
+					int c = cy*gridWidth + cx;
+					if (pass == 0){
+						cellOffsets[c + 1]++;
+					}
+					else {
+						cellPanels[cursor[c]++] = i;
+					}
+				}
+			}
+		}
+		if (pass == 0){
+			for (unsigned int c = 1; c < cellOffsets.size(); c++){
+				cellOffsets[c] += cellOffsets[c - 1];
+			}
+			cellPanels.resize(cellOffsets.back());
+		}
+	}
+}
+
+inline bool PanelHitTester::isInside(const PanelPlanes& p, float x, float y){
+	if (x < p.minX || x > p.maxX || y < p.minY || y > p.maxY){
+		return false;
+	}
+	if (p.isBox){
+		return true;
+	}
+	bool inside = true;
+	for (int k = 0; k < 4; k++){
+		inside &= (p.a[k]*x + p.b[k]*y + p.c[k] >= 0);
+	}
+	return inside;
+}
+
+/**
+ * @description: tests HIT_TEST_LANES points against a panel
+ * @return: bit j is set if point j is inside the panel
+ */
+inline int PanelHitTester::getInsideBits(const PanelPlanes& p, const float* x, const float* y){
+#if defined(__AVX__)
+	__m256 px = _mm256_loadu_ps(x);
+	__m256 py = _mm256_loadu_ps(y);
+	__m256 in = _mm256_and_ps(
+			_mm256_and_ps(_mm256_cmp_ps(px, _mm256_set1_ps(p.minX), _CMP_GE_OQ),
+					_mm256_cmp_ps(px, _mm256_set1_ps(p.maxX), _CMP_LE_OQ)),
+			_mm256_and_ps(_mm256_cmp_ps(py, _mm256_set1_ps(p.minY), _CMP_GE_OQ),
+					_mm256_cmp_ps(py, _mm256_set1_ps(p.maxY), _CMP_LE_OQ)));
+	if (!p.isBox){
+		for (int k = 0; k < 4; k++){
+			__m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.a[k]), px),
+					_mm256_mul_ps(_mm256_set1_ps(p.b[k]), py)), _mm256_set1_ps(p.c[k]));
+			in = _mm256_and_ps(in, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+	}
+	return _mm256_movemask_ps(in);
+#elif defined(__SSE2__)
+	__m128 px = _mm_loadu_ps(x);
+	__m128 py = _mm_loadu_ps(y);
+	__m128 in = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(px, _mm_set1_ps(p.minX)), _mm_cmple_ps(px, _mm_set1_ps(p.maxX))),
+			_mm_and_ps(_mm_cmpge_ps(py, _mm_set1_ps(p.minY)), _mm_cmple_ps(py, _mm_set1_ps(p.maxY))));
+	if (!p.isBox){
+		for (int k = 0; k < 4; k++){
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.a[k]), px), _mm_mul_ps(_mm_set1_ps(p.b[k]), py)),
+					_mm_set1_ps(p.c[k]));
+			in = _mm_and_ps(in, _mm_cmpge_ps(d, _mm_setzero_ps()));
+		}
+	}
+	return _mm_movemask_ps(in);
+#else
+	return isInside(p, x[0], y[0]);
+#endif
+}
+
+/**
+ * @description: finds the grid cell of a point
+ * @return: the index of the cell, -1 if the point is outside the grid
+ */
+inline int PanelHitTester::getCell(float x, float y) const {
+	int cx = (int)floorf((x - originX)/cellSize);
+	int cy = (int)floorf((y - originY)/cellSize);
+	if (cx < 0 || cy < 0 || cx >= gridWidth || cy >= gridHeight){
+		return -1;
+	}
+	return cy*gridWidth + cx;
+}
+
+inline int PanelHitTester::getPointPanelIndex(float x, float y) const {
+	int c = getCell(x, y);
+	if (c < 0){
+		return -1;
+	}
+	for (int k = cellOffsets[c]; k < cellOffsets[c + 1]; k++){
+		if (isInside(panels[cellPanels[k]], x, y)){
+			return cellPanels[k];
+		}
+	}
+	return -1;
+}
+
+void PanelHitTester::getPanelIndices(const float* x, const float* y, int nPoints, int* panelIndices) const {
+	const int allLanes = (1 << HIT_TEST_LANES) - 1;
+	int i = 0;
+	for (; i + HIT_TEST_LANES <= nPoints; i += HIT_TEST_LANES){
+		int c = getCell(x[i], y[i]);
+		bool isSameCell = (c >= 0);
+		for (int j = 1; j < HIT_TEST_LANES && isSameCell; j++){
+			isSameCell = (getCell(x[i + j], y[i + j]) == c);
+		}
+		if (!isSameCell){
+			for (int j = 0; j < HIT_TEST_LANES; j++){
+				panelIndices[i + j] = getPointPanelIndex(x[i + j], y[i + j]);
+			}
+			continue;
+		}
+		//every point takes the first panel of the cell it is inside, as getPointPanelIndex does
+		int found = 0;
+		for (int j = 0; j < HIT_TEST_LANES; j++){
+			panelIndices[i + j] = -1;
+		}
+		for (int k = cellOffsets[c]; k < cellOffsets[c + 1] && found != allLanes; k++){
+			int bits = getInsideBits(panels[cellPanels[k]], x + i, y + i) & ~found;
+			found |= bits;
+			for (; bits != 0; bits &= bits - 1){
+				panelIndices[i + __builtin_ctz(bits)] = cellPanels[k];
+			}
+		}
+	}
+	for (; i < nPoints; i++){
+		panelIndices[i] = getPointPanelIndex(x[i], y[i]);
+	}
+}
+
+int PanelHitTester::getPanelMask(int panelIndex, const float* x, const float* y, int nPoints, uint8_t* mask) const {
+	const PanelPlanes& p = panels[panelIndex];
+	if (!p.isValid){
+		memset(mask, 0, nPoints);
+		return 0;
+	}
+	int count = 0;
+	int i = 0;
+	for (; i + HIT_TEST_LANES <= nPoints; i += HIT_TEST_LANES){
+		int bits = getInsideBits(p, x + i, y + i);
+		for (int j = 0; j < HIT_TEST_LANES; j++){
+			mask[i + j] = (bits >> j) & 1;
+		}
+		count += __builtin_popcount(bits);
+	}
+	for (; i < nPoints; i++){
+		mask[i] = isInside(p, x[i], y[i]);
+		count += mask[i];
+	}
+	return count;
+}
+
+inline bool PanelHitTester::clipLine(const PanelPlanes& p, float x0, float y0, float dx, float dy, float tMin, float tMax,
+		float halfWidth, float* tEnter, float* tExit){
+	for (int k = 0; k < 4; k++){
+		float f0 = p.a[k]*x0 + p.b[k]*y0 + p.c[k] + halfWidth*sqrtf(p.a[k]*p.a[k] + p.b[k]*p.b[k]);
+		float fd = p.a[k]*dx + p.b[k]*dy;
+		if (fd == 0){
+			if (f0 < 0){
+				return false;
+			}
+			continue;
+		}
+		float t = -f0/fd;
+		if (fd > 0){
+			tMin = (t > tMin) ? t : tMin;
+		}
+		else {
+			tMax = (t < tMax) ? t : tMax;
+		}
+	}
+	*tEnter = tMin;
+	*tExit = tMax;
+	return tMin <= tMax;
+}
+
+/**
+ * @description: walks the cells along one lane of a traversal, from tMin to tMax, and tests the panels of every cell
+ * next to the lane against the line itself
+ */
+void PanelHitTester::traverseLane(float x0, float y0, float dx, float dy, float tMin, float tMax, float lineX0,
+		float lineY0, float length, float halfWidth, std::vector<LineHit_t>* hits){
+	//clip the lane to the grid plus a border of one cell, whose neighbours can still be inside the grid
+	float boxMin[2] = {originX - cellSize, originY - cellSize};
+	float boxMax[2] = {originX + (gridWidth + 1)*cellSize, originY + (gridHeight + 1)*cellSize};
+	float start[2] = {x0, y0}, direction[2] = {dx, dy};
+	for (int axis = 0; axis < 2; axis++){
+		if (direction[axis] == 0){
+			if (start[axis] < boxMin[axis] || start[axis] > boxMax[axis]){
+				return;
+			}
+			continue;
+		}
+		float t0 = (boxMin[axis] - start[axis])/direction[axis];
+		float t1 = (boxMax[axis] - start[axis])/direction[axis];
+		tMin = std::max(tMin, std::min(t0, t1));
+		tMax = std::min(tMax, std::max(t0, t1));
+	}
+	if (tMin > tMax){
+		return;
+	}
+
+	//Amanatides & Woo grid walk
+	float px = x0 + tMin*dx, py = y0 + tMin*dy;
+	int cx = (int)floorf((px - originX)/cellSize), cy = (int)floorf((py - originY)/cellSize);
+	int stepX = (dx > 0) ? 1 : -1, stepY = (dy > 0) ? 1 : -1;
+	float tNextX = (dx == 0) ? FLT_MAX : tMin + (originX + (cx + (stepX > 0))*cellSize - px)/dx;
+	float tNextY = (dy == 0) ? FLT_MAX : tMin + (originY + (cy + (stepY > 0))*cellSize - py)/dy;
+	float tDeltaX = (dx == 0) ? FLT_MAX : cellSize/fabsf(dx);
+	float tDeltaY = (dy == 0) ? FLT_MAX : cellSize/fabsf(dy);
+	int nSteps = gridWidth + gridHeight + 6;
+	for (int step = 0; step < nSteps; step++){
+		for (int ny = cy - 1; ny <= cy + 1; ny++){
+			for (int nx = cx - 1; nx <= cx + 1; nx++){
+				if (nx < 0 || ny < 0 || nx >= gridWidth || ny >= gridHeight){
+					continue;
+				}
+				int c = ny*gridWidth + nx;
+				for (int k = cellOffsets[c]; k < cellOffsets[c + 1]; k++){
+					int i = cellPanels[k];
+					if (visitStamps[i] == visitStamp){
+						continue;
+					}
+					visitStamps[i] = visitStamp;
+					LineHit_t hit;
+					if (clipLine(panels[i], lineX0, lineY0, dx, dy, 0, length, halfWidth, &hit.tEnter, &hit.tExit)){
+						hit.panelIndex = i;
+						hit.panelId = panelIds[i];
+						hits->push_back(hit);
+					}
+				}
+			}
+		}
+		if (tNextX < tNextY){
+			if (tNextX > tMax){
+				break;
+			}
+			cx += stepX;
+			tNextX += tDeltaX;
+		}
+		else {
+			if (tNextY > tMax){
+				break;
+			}
+			cy += stepY;
+			tNextY += tDeltaY;
+		}
+	}
+}
+
+int PanelHitTester::traverseLine(float x0, float y0, float dx, float dy, float length, float halfWidth,
+		std::vector<LineHit_t>* hits){
+	hits->clear();
+	float norm = sqrtf(dx*dx + dy*dy);
+	if (norm == 0 || gridWidth == 0){
+		return 0;
+	}
+	dx /= norm;
+	dy /= norm;
+	halfWidth = (halfWidth > 0) ? halfWidth : 0;
+	length = (length >= 0) ? length : FLT_MAX;
+	if (++visitStamp == 0){
+		std::fill(visitStamps.begin(), visitStamps.end(), 0);
+		visitStamp = 1;
+	}
+
+	//with the edges pushed out by halfWidth, a panel can be hit from up to twice halfWidth away (at the corners of
+	//triangles). Lanes at most a cell apart cover that band, and every point of it is then less than a cell away from
+	//a lane, i.e. in one of the cells around a cell the lane walks through
+	float reach = 2*halfWidth;
+	int nLanes = (int)ceilf(2*reach/cellSize) + 1;
+	for (int lane = 0; lane < nLanes; lane++){
+		float offset = (nLanes == 1) ? 0 : -reach + 2*reach*lane/(nLanes - 1);
+		float tMax = (length == FLT_MAX) ? FLT_MAX : length + reach;
+		traverseLane(x0 - offset*dy, y0 + offset*dx, dx, dy, -reach, tMax, x0, y0, length, halfWidth, hits);
+	}
+
+	std::sort(hits->begin(), hits->end(), [](const LineHit_t& l, const LineHit_t& r){
+		return (l.tEnter < r.tEnter) || (l.tEnter == r.tEnter && l.panelIndex < r.panelIndex);
+	});
+	return hits->size();
+}
@@ -0,0 +1,96 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * RGB8.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "RGB8.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void toRGB8(const RGB_t* src, RGB8_t* dst, int nColors){
+	for (int i = 0; i < nColors; i++){
+		dst[i] = src[i];
+	}
+}
+
+void toRGB(const RGB8_t* src, RGB_t* dst, int nColors){
+	for (int i = 0; i < nColors; i++){
+		dst[i] = src[i];
+	}
+}
+
+/*
+ * The vector loops handle 4 colors (16 bytes) per iteration. The padding bytes are 0 and stay 0 under every
+ * operation, so the arrays are processed as plain byte arrays.
+ */
+
+void addRGB8(RGB8_t* dst, const RGB8_t* src, int nColors){
+	int i = 0;
+#if defined(__SSE2__)
+	for (; i + 4 <= nColors; i += 4){
+		__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		__m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_adds_epu8(d, s));
+	}
+#endif
+	for (; i < nColors; i++){
+		dst[i] += src[i];
+	}
+}
+
+void subRGB8(RGB8_t* dst, const RGB8_t* src, int nColors){
+	int i = 0;
+#if defined(__SSE2__)
+	for (; i + 4 <= nColors; i += 4){
+		__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		__m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_subs_epu8(d, s));
+	}
+#endif
+	for (; i < nColors; i++){
+		dst[i] -= src[i];
+	}
+}
+
+#if defined(__SSE2__)
+//x/255 rounded on 16 bit lanes, the same formula as scaleRGB8
+static inline __m128i div255(__m128i x){
+	x = _mm_add_epi16(x, _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+#endif
+
+void scaleRGB8(RGB8_t* colors, uint8_t factor, int nColors){
+	int i = 0;
+#if defined(__SSE2__)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i f = _mm_set1_epi16(factor);
+	for (; i + 4 <= nColors; i += 4){
+		__m128i c = _mm_loadu_si128((const __m128i*)(colors + i));
+		__m128i lo = div255(_mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), f));
+		__m128i hi = div255(_mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), f));
+		_mm_storeu_si128((__m128i*)(colors + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < nColors; i++){
+		colors[i] = scaleRGB8(colors[i], factor);
+	}
+}
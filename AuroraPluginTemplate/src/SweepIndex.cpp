@@ -0,0 +1,241 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * SweepIndex.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "SweepIndex.h"
+#include <math.h>
+#include <algorithm>
+
+SweepIndex::SweepIndex(LayoutData* layoutData, int angleSteps){
+	this->angleSteps = (angleSteps > 0) ? angleSteps : SWEEP_INDEX_DEFAULT_ANGLE_STEPS;
+	rebuild(layoutData);
+}
+
+SweepIndex::~SweepIndex(){
+	clearCache();
+}
+
+void SweepIndex::rebuild(LayoutData* layoutData){
+	clearCache();
+	orders.assign(angleSteps, NULL);
+	x.resize(layoutData->nPanels);
+	y.resize(layoutData->nPanels);
+	panelIds.resize(layoutData->nPanels);
+	minX = minY = maxX = maxY = 0;
+	for (int i = 0; i < layoutData->nPanels; i++){
+		const Point& centroid = layoutData->panels[i].shape->getCentroid();
+		x[i] = centroid.x;
+		y[i] = centroid.y;
+		panelIds[i] = layoutData->panels[i].panelId;
+		if (i == 0){
+			minX = maxX = x[i];
+			minY = maxY = y[i];
+		}
+		growBounds(x[i], y[i]);
+	}
+}
+
+void SweepIndex::growBounds(double x, double y){
+	minX = (x < minX) ? x : minX;
+	maxX = (x > maxX) ? x : maxX;
+	minY = (y < minY) ? y : minY;
+	maxY = (y > maxY) ? y : maxY;
+}
+
+void SweepIndex::clearCache(){
+	for (unsigned int i = 0; i < orders.size(); i++){
+		delete orders[i];
+		orders[i] = NULL;
+	}
+}
+
+int SweepIndex::quantizeAngle(degrees angle) const {
+	double step = fmod(angle, 360.0)*angleSteps/360.0;
+	int quantized = (int)floor(step + 0.5) % angleSteps;
+	return (quantized < 0) ? quantized + angleSteps : quantized;
+}
+
+const SweepIndex::SweepOrder& SweepIndex::getOrder(int step){
+	if (orders[step]){
+		return *orders[step];
+	}
+
+	radians a = 2*M_PI*step/angleSteps;
+	double c = cos(a), s = sin(a);
+	int n = (int)panelIds.size();
+	std::vector<double> projection(n);
+	std::vector<int> order(n);
+	for (int i = 0; i < n; i++){
+		projection[i] = x[i]*c + y[i]*s;
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&projection](int l, int r){ return projection[l] < projection[r]; });
+
+	SweepOrder* sweepOrder = new SweepOrder;
+	sweepOrder->panelIds.resize(n);
+	sweepOrder->indices.resize(n);
+	sweepOrder->projections.resize(n);
+	for (int i = 0; i < n; i++){
+		sweepOrder->panelIds[i] = panelIds[order[i]];
+		sweepOrder->indices[i] = order[i];
+		sweepOrder->projections[i] = projection[order[i]];
+	}
+	orders[step] = sweepOrder;
+	return *sweepOrder;
+}
+
+int SweepIndex::getPanelsInRange(degrees angle, double from, double to, const int** panelIds, const double** projections){
+	const SweepOrder& sweepOrder = getOrder(quantizeAngle(angle));
+	const std::vector<double>& p = sweepOrder.projections;
+	int first = std::lower_bound(p.begin(), p.end(), from) - p.begin();
+	int last = std::lower_bound(p.begin() + first, p.end(), to) - p.begin();
+	*panelIds = sweepOrder.panelIds.data() + first;
+	if (projections){
+		*projections = p.data() + first;
+	}
+	return last - first;
+}
+
+void SweepIndex::getExtent(degrees angle, double* minProjection, double* maxProjection){
+	const SweepOrder& sweepOrder = getOrder(quantizeAngle(angle));
+	if (sweepOrder.projections.empty()){
+		*minProjection = *maxProjection = 0;
+		return;
+	}
+	*minProjection = sweepOrder.projections.front();
+	*maxProjection = sweepOrder.projections.back();
+}
+
+int SweepIndex::getBoundaryPanel(int panelIndex, double dx, double dy, double laneHalfWidth, bool last){
+	int n = (int)panelIds.size();
+	double length = sqrt(dx*dx + dy*dy);
+	if (panelIndex < 0 || panelIndex >= n){
+		return -1;
+	}
+	if (length == 0){
+		return panelIndex;
+	}
+	dx /= length;
+	dy /= length;
+
+	//the lane is a band of the projection onto the normal (-dy, dx) of the line. The cached order of the nearest
+	//quantized direction is off by a small angle, which moves a centroid at distance r from the panel by at most
+	//r*2*sin(angle/2) relative to the exact projection, so the band searched is widened by that much
+	int step = quantizeAngle(atan2(dx, -dy)*180/M_PI);
+	radians a = 2*M_PI*step/angleSteps;
+	double c = cos(a), s = sin(a);
+	double angleError = sqrt((c + dy)*(c + dy) + (s - dx)*(s - dx));
+	double farX = (maxX - x[panelIndex] > x[panelIndex] - minX) ? maxX - x[panelIndex] : x[panelIndex] - minX;
+	double farY = (maxY - y[panelIndex] > y[panelIndex] - minY) ? maxY - y[panelIndex] : y[panelIndex] - minY;
+	double band = laneHalfWidth + sqrt(farX*farX + farY*farY)*angleError*(1 + 1e-9) + 1e-9;
+
+	const SweepOrder& sweepOrder = getOrder(step);
+	const std::vector<double>& p = sweepOrder.projections;
+	double center = x[panelIndex]*c + y[panelIndex]*s;
+	int first = std::lower_bound(p.begin(), p.end(), center - band) - p.begin();
+	int end = std::upper_bound(p.begin() + first, p.end(), center + band) - p.begin();
+
+	int found = panelIndex;
+	double foundProjection = 0;
+	for (int k = first; k < end; k++){
+		int i = sweepOrder.indices[k];
+		double rx = x[i] - x[panelIndex], ry = y[i] - y[panelIndex];
+		if (fabs(ry*dx - rx*dy) >= laneHalfWidth){
+			continue;
+		}
+		double projection = rx*dx + ry*dy;
+		bool better = last ? (projection > foundProjection) : (projection < foundProjection);
+		if (better || (projection == foundProjection && i < found)){
+			found = i;
+			foundProjection = projection;
+		}
+	}
+	return found;
+}
+
+void SweepIndex::insertIntoOrders(int index){
+	for (int step = 0; step < angleSteps; step++){
+		SweepOrder* sweepOrder = orders[step];
+		if (!sweepOrder){
+			continue;
+		}
+		radians a = 2*M_PI*step/angleSteps;
+		double projection = x[index]*cos(a) + y[index]*sin(a);
+		std::vector<double>& p = sweepOrder->projections;
+		int at = std::upper_bound(p.begin(), p.end(), projection) - p.begin();
+		p.insert(p.begin() + at, projection);
+		sweepOrder->panelIds.insert(sweepOrder->panelIds.begin() + at, panelIds[index]);
+		sweepOrder->indices.insert(sweepOrder->indices.begin() + at, index);
+	}
+}
+
+void SweepIndex::eraseFromOrders(int index, bool renumber){
+	for (int step = 0; step < angleSteps; step++){
+		SweepOrder* sweepOrder = orders[step];
+		if (!sweepOrder){
+			continue;
+		}
+		std::vector<int>& indices = sweepOrder->indices;
+		int at = std::find(indices.begin(), indices.end(), index) - indices.begin();
+		if (at < (int)indices.size()){
+			indices.erase(indices.begin() + at);
+			sweepOrder->panelIds.erase(sweepOrder->panelIds.begin() + at);
+			sweepOrder->projections.erase(sweepOrder->projections.begin() + at);
+		}
+		for (unsigned int k = 0; renumber && k < indices.size(); k++){
+			indices[k] -= (indices[k] > index) ? 1 : 0;
+		}
+	}
+}
+
+void SweepIndex::applyLayoutDeltas(const LayoutData* layoutData, const LayoutDelta_t* deltas, int nDeltas,
+		int totalAuroraRotation){
+	for (int i = 0; i < nDeltas; i++){
+		const LayoutDelta_t& delta = deltas[i];
+		Point centroid = getLayoutDeltaCentroid(layoutData, delta, totalAuroraRotation);
+		int index = std::find(panelIds.begin(), panelIds.end(), delta.panelId) - panelIds.begin();
+		bool exists = index < (int)panelIds.size();
+		if (delta.type == LAYOUT_DELTA_ADD && !exists){
+			if (panelIds.empty()){
+				minX = maxX = centroid.x;
+				minY = maxY = centroid.y;
+			}
+			panelIds.push_back(delta.panelId);
+			x.push_back(centroid.x);
+			y.push_back(centroid.y);
+			growBounds(centroid.x, centroid.y);
+			insertIntoOrders(index);
+		}
+		else if (delta.type == LAYOUT_DELTA_REMOVE && exists){
+			eraseFromOrders(index, true);
+			panelIds.erase(panelIds.begin() + index);
+			x.erase(x.begin() + index);
+			y.erase(y.begin() + index);
+		}
+		else if (delta.type == LAYOUT_DELTA_MOVE && exists){
+			eraseFromOrders(index, false);
+			x[index] = centroid.x;
+			y[index] = centroid.y;
+			growBounds(centroid.x, centroid.y);
+			insertIntoOrders(index);
+		}
+	}
+}
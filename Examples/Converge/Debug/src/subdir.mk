@@ -4,13 +4,19 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/AuroraPlugin.cpp 
+../src/AuroraPlugin.cpp \
+../src/FrameSlicing.cpp \
+../src/ColorBatch.cpp 
 
 OBJS += \
-./src/AuroraPlugin.o 
+./src/AuroraPlugin.o \
+./src/FrameSlicing.o \
+./src/ColorBatch.o 
 
 CPP_DEPS += \
-./src/AuroraPlugin.d 
+./src/AuroraPlugin.d \
+./src/FrameSlicing.d \
+./src/ColorBatch.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -0,0 +1,233 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * ConstexprColor.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_CONSTEXPRCOLOR_H_
+#define INC_CONSTEXPRCOLOR_H_
+
+#include "ColorUtils.h"
+
+/**
+ * Color conversions and color tables evaluated by the compiler, so built in palettes and hue wheels cost nothing at
+ * startup and every lookup is a read from a constant table, e.g.
+ *
+ *     static constexpr HSV_t paletteHsv[] = {{227, 100, 99}, {182, 100, 100}, {125, 100, 93}};
+ *     static constexpr auto palette = makePaletteTable(paletteHsv);
+ *     static constexpr auto gradient = makeGradientTable<256>(palette.colors);
+ *
+ * The conversions round the same way as HSVtoRGBBatch and RGBtoHSVBatch, the gradient samples the same way as
+ * buildPaletteGradient with PALETTE_INTERPOLATION_RGB, so tables built here match the ones built at runtime.
+ * Everything is written as single expression constexpr functions, as C++11 requires
+ */
+
+inline constexpr int clampColorComponent(int x, int min, int max){
+	return (x < min) ? min : ((x > max) ? max : x);
+}
+
+inline constexpr int wrapColorHue(int h){
+	return (h % 360 < 0) ? h % 360 + 360 : h % 360;
+}
+
+inline constexpr int scaleColorToByte(int x){
+	return (17*x + 20000)/40000;
+}
+
+inline constexpr RGB_t hsvSectorToRGB(int region, int max, int min, int up, int down){
+	return (region == 0) ? RGB_t{max, up, min} :
+			(region == 1) ? RGB_t{down, max, min} :
+			(region == 2) ? RGB_t{min, max, up} :
+			(region == 3) ? RGB_t{min, down, max} :
+			(region == 4) ? RGB_t{up, min, max} : RGB_t{max, min, down};
+}
+
+inline constexpr RGB_t hsvComponentsToRGB(int h, int s, int v){
+	return hsvSectorToRGB(h/60, scaleColorToByte(v*6000), scaleColorToByte(v*(100 - s)*60),
+			scaleColorToByte(v*((100 - s)*60 + s*(h % 60))), scaleColorToByte(v*((100 - s)*60 + s*(60 - h % 60))));
+}
+
+/**
+ * @description: Convert Color from HSV colorspace to RGB colorspace at compile time. H is wrapped into [0, 360),
+ * S and V are clamped into [0, 100]
+ * @params hsv: color to convert from
+ * @return: the color in RGB colorspace
+ */
+inline constexpr RGB_t constexprHSVtoRGB(HSV_t hsv){
+	return hsvComponentsToRGB(wrapColorHue(hsv.H), clampColorComponent(hsv.S, 0, 100),
+			clampColorComponent(hsv.V, 0, 100));
+}
+
+inline constexpr HSV_t rgbRangeToHSV(int n, int c, int max){
+	return HSV_t{((2*n + c)/((c > 0) ? 2*c : 1)) % 360, (200*c + max)/((max > 0) ? 2*max : 1), (200*max + 255)/510};
+}
+
+//the hue numerator is offset by a multiple of c so it stays positive, the hue is wrapped back by rgbRangeToHSV
+inline constexpr HSV_t rgbMaxToHSV(int r, int g, int b, int max, int c){
+	return rgbRangeToHSV((max == r) ? 360*c + 60*(g - b) : ((max == g) ? 120*c + 60*(b - r) : 240*c + 60*(r - g)),
+			c, max);
+}
+
+inline constexpr int maxColorComponent(int r, int g, int b){
+	return (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+}
+
+inline constexpr int minColorComponent(int r, int g, int b){
+	return (r < g) ? ((r < b) ? r : b) : ((g < b) ? g : b);
+}
+
+inline constexpr HSV_t rgbComponentsToHSV(int r, int g, int b){
+	return rgbMaxToHSV(r, g, b, maxColorComponent(r, g, b), maxColorComponent(r, g, b) - minColorComponent(r, g, b));
+}
+
+/**
+ * @description: Convert Color from RGB colorspace to HSV colorspace at compile time. Channels are clamped into
+ * [0, 255]
+ * @params rgb: color to convert from
+ * @return: the color in HSV colorspace
+ */
+inline constexpr HSV_t constexprRGBtoHSV(RGB_t rgb){
+	return rgbComponentsToHSV(clampColorComponent(rgb.R, 0, 255), clampColorComponent(rgb.G, 0, 255),
+			clampColorComponent(rgb.B, 0, 255));
+}
+
+/**
+ * A list of indices 0 ... N - 1 to expand a table initializer over, built by halves so large tables do not run into
+ * the template instantiation depth limit
+ */
+template <int... I>
+struct ColorIndexList {};
+
+template <typename First, typename Second>
+struct ConcatColorIndexLists;
+
+template <int... I, int... J>
+struct ConcatColorIndexLists<ColorIndexList<I...>, ColorIndexList<J...>> {
+	typedef ColorIndexList<I..., (int)sizeof...(I) + J...> type;
+};
+
+template <int N>
+struct MakeColorIndexList {
+	typedef typename ConcatColorIndexLists<typename MakeColorIndexList<N/2>::type,
+			typename MakeColorIndexList<N - N/2>::type>::type type;
+};
+
+template <>
+struct MakeColorIndexList<0> {
+	typedef ColorIndexList<> type;
+};
+
+template <>
+struct MakeColorIndexList<1> {
+	typedef ColorIndexList<0> type;
+};
+
+/**
+ * A constant table of N colors
+ */
+template <int N>
+struct ColorTable_t {
+	RGB_t colors[N];
+};
+
+template <int N, int... I>
+constexpr ColorTable_t<N> makePaletteTable(const HSV_t (&palette)[N], ColorIndexList<I...>){
+	return ColorTable_t<N>{{constexprHSVtoRGB(palette[I])...}};
+}
+
+/**
+ * @description: converts a palette literal to an RGB table at compile time
+ * @params palette: the palette in HSV colorspace, e.g. as listed in the .opt file of a plugin
+ * @return: the palette in RGB colorspace
+ */
+template <int N>
+constexpr ColorTable_t<N> makePaletteTable(const HSV_t (&palette)[N]){
+	return makePaletteTable(palette, typename MakeColorIndexList<N>::type());
+}
+
+template <int N, int... I>
+constexpr ColorTable_t<N> makeHueTable(int saturation, int brightness, ColorIndexList<I...>){
+	return ColorTable_t<N>{{constexprHSVtoRGB(HSV_t{I*360/N, saturation, brightness})...}};
+}
+
+/**
+ * @description: builds a hue wheel at compile time, entry k has the hue k*360/N
+ * @params saturation: saturation of every entry, in [0, 100]
+ * @params brightness: brightness of every entry, in [0, 100]
+ * @return: the table
+ */
+template <int N>
+constexpr ColorTable_t<N> makeHueTable(int saturation, int brightness){
+	return makeHueTable<N>(saturation, brightness, typename MakeColorIndexList<N>::type());
+}
+
+/**
+ * A constant palette gradient of SIZE entries, the compile time counterpart of PaletteGradient_t
+ */
+template <int SIZE>
+struct GradientTable_t {
+	RGB_t colors[SIZE];
+	float scale;			/*entries per palette unit*/
+};
+
+inline constexpr RGB_t mixGradientColors(const RGB_t& c1, const RGB_t& c2, float fraction){
+	return RGB_t{(int)((1.0f - fraction)*c1.R + fraction*c2.R), (int)((1.0f - fraction)*c1.G + fraction*c2.G),
+			(int)((1.0f - fraction)*c1.B + fraction*c2.B)};
+}
+
+inline constexpr RGB_t gradientColorAt(const RGB_t* palette, int nColors, float colour){
+	return ((int)colour >= nColors - 1) ? palette[nColors - 1] :
+			mixGradientColors(palette[(int)colour], palette[(int)colour + 1], colour - (int)colour);
+}
+
+inline constexpr RGB_t gradientEntry(const RGB_t* palette, int nColors, int k, int size){
+	return (nColors == 0) ? RGB_t{128, 128, 128} :
+			(nColors == 1) ? palette[0] : gradientColorAt(palette, nColors, (float)k*(nColors - 1)/(size - 1));
+}
+
+template <int SIZE, int N, int... I>
+constexpr GradientTable_t<SIZE> makeGradientTable(const RGB_t (&palette)[N], ColorIndexList<I...>){
+	return GradientTable_t<SIZE>{{gradientEntry(palette, N, I, SIZE)...},
+			(N > 1) ? (float)(SIZE - 1)/(N - 1) : 0.0f};
+}
+
+/**
+ * @description: samples a palette into a gradient table at compile time, like buildPaletteGradient does at runtime
+ * @params palette: the palette colors, e.g. the colors of a makePaletteTable table
+ * @return: the gradient, SIZE entries (at least 2)
+ */
+template <int SIZE, int N>
+constexpr GradientTable_t<SIZE> makeGradientTable(const RGB_t (&palette)[N]){
+	static_assert(SIZE >= 2, "a gradient needs at least 2 entries");
+	return makeGradientTable<SIZE>(palette, typename MakeColorIndexList<SIZE>::type());
+}
+
+/**
+ * @description: returns the gradient color at a position of the palette, as getGradientColor does for a
+ * PaletteGradient_t
+ * @params gradient: the gradient to read
+ * @params colour: position in palette units, clamped to the table
+ * @return: the nearest entry of the gradient
+ */
+template <int SIZE>
+constexpr const RGB_t& getGradientColor(const GradientTable_t<SIZE>& gradient, float colour){
+	return gradient.colors[clampColorComponent((int)(colour*gradient.scale + 0.5f), 0, SIZE - 1)];
+}
+
+#endif /* INC_CONSTEXPRCOLOR_H_ */
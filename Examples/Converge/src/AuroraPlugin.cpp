@@ -18,7 +18,10 @@
 
 #include "AuroraPlugin.h"
 #include "LayoutProcessingUtils.h"
+#include "FrameSlicing.h"
 #include "ColorUtils.h"
+#include "ConstexprColor.h"
+#include "ColorBatch.h"
 #include "DataManager.h"
 #include "PluginFeatures.h"
 #include "Logger.h"
@@ -39,10 +42,16 @@ extern "C" {
 
 int hue = 0;
 
-FrameSlice_t* frameSlices = NULL;
+FrameSliceTable_t frameSlices;
 int nFrameSlices = 0;
 int transTime = 15;
 
+//every hue at 100% saturation and brightness, computed by the compiler
+static constexpr ColorTable_t<360> hueWheel = makeHueTable<360>(100, 100);
+//the wheel in use: hueWheel, or one converted at start for other saturation and brightness options
+static const RGB_t* wheelColors = hueWheel.colors;
+static RGB_t* optionWheel = NULL;
+
 /**
  * @description: Initialize the plugin. Called once, when the plugin is loaded.
  * This function can be used to enable rhythm or advanced features,
@@ -59,29 +68,35 @@ void initPlugin(){
     LayoutData* layoutData = getLayoutData();
 
     getOptionValue("transTime", transTime);
+    int saturation = 100;
+    int brightness = 100;
+    getOptionValue("saturation", saturation);
+    getOptionValue("brightness", brightness);
+    if (saturation != 100 || brightness != 100){
+        //the compiler only knows the default wheel, any other one is converted once, in a single batch
+        HSV_t hsv[360];
+        for (int h = 0; h < 360; h++){
+            hsv[h] = {h, saturation, brightness};
+        }
+        optionWheel = new RGB_t[360];
+        HSVtoRGBBatch(hsv, optionWheel, 360);
+        wheelColors = optionWheel;
+    }
     
     rotateAuroraPanels(layoutData, &layoutData->globalOrientation);
     
     //quantizes the layout into framelices. See SDK documentation for more information
-    getFrameSlicesFromLayoutForTriangle(layoutData, &frameSlices, &nFrameSlices, layoutData->globalOrientation);
+    getFrameSliceTableFromLayout(layoutData, &frameSlices);
+    nFrameSlices = frameSlices.nSlices;
 }
 
 /**
- * A helper function thats fills up the frame array at frameIndex with a specified framelices
- * and a specified hue. the color is the specified hue at 100% saturation and brightness.
- * Note that the FrameSlice_t structure is just a vector of panels at that frame slice
+ * A helper function thats fills up the frame array at frameIndex with a specified framelice
+ * and a specified hue. the color is the specified hue at the saturation and brightness of the options,
+ * read from the precomputed hue wheel
  */
-void fillUpFramesArray(FrameSlice_t* frameSlice, Frame_t* frame, int* frameIndex, int hue){
-    static RGB_t rgb;
-    for (unsigned int i = 0; i < frameSlice->panelIds.size(); i++){
-        frame[*frameIndex].panelId = frameSlice->panelIds[i];
-        HSVtoRGB((HSV_t){hue, 100, 100}, &rgb);
-        frame[*frameIndex].r = rgb.R;
-        frame[*frameIndex].g = rgb.G;
-        frame[*frameIndex].b = rgb.B;
-        frame[*frameIndex].transTime = transTime;
-        (*frameIndex)++;
-    }
+void fillUpFramesArray(int frameSlice, Frame_t* frame, int* frameIndex, int hue){
+    *frameIndex += fillFramesFromSlice(&frameSlices, frameSlice, wheelColors[hue], transTime, &frame[*frameIndex]);
 }
 
 /**
@@ -104,13 +119,13 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
     int spatialHue = hue;
     int hueStep = 15;
     if (nFrameSlices % 2 != 0){
-        fillUpFramesArray(&frameSlices[nFrameSlices/2], frames, &index, spatialHue%360);
+        fillUpFramesArray(nFrameSlices/2, frames, &index, spatialHue%360);
         spatialHue += hueStep;
     }
     
     for (int i = nFrameSlices/2 - 1; i >= 0; i--){
-        fillUpFramesArray(&frameSlices[i], frames, &index, spatialHue%360);
-        fillUpFramesArray(&frameSlices[nFrameSlices - 1 - i], frames, &index, spatialHue%360);
+        fillUpFramesArray(i, frames, &index, spatialHue%360);
+        fillUpFramesArray(nFrameSlices - 1 - i, frames, &index, spatialHue%360);
         spatialHue += hueStep;
     }
     
@@ -131,4 +146,7 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
  */
 void pluginCleanup(){
 	//do deallocation here
+    delete [] optionWheel;
+    optionWheel = NULL;
+    wheelColors = hueWheel.colors;
 }
@@ -0,0 +1,190 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FrameSlicing.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "FrameSlicing.h"
+#include <math.h>
+
+/*offsets smaller than this fraction of the side length are treated as zero, i.e. the neighbour is in the same slice*/
+#define SLICE_OFFSET_TOLERANCE 0.01
+/*lower bound on the spacing, as a fraction of the side length. Guards against near-degenerate angles producing
+ *a grid so fine that most slices end up empty*/
+#define SLICE_MIN_SPACING 0.25
+
+/**
+ * @description: the grid spacing contributed by a single shape. The centroid of the panel attached to an edge is the
+ * centroid mirrored through the midpoint of that edge, so its x offset is twice that of the edge midpoint.
+ * @return: the smallest non-zero x offset, or 0 if the shape has no usable edges
+ */
+static double shapeSliceSpacing(Shape* shape){
+	if (shape->nVertices < 3){
+		return 0;
+	}
+	double sideLength = Point::distance(shape->vertices[0], shape->vertices[1]);
+	double spacing = 0;
+	double cx = shape->getCentroid().x;
+	for (int i = 0; i < shape->nVertices; i++){
+		const Point& v1 = shape->vertices[i];
+		const Point& v2 = shape->vertices[(i + 1) % shape->nVertices];
+		double dx = fabs(v1.x + v2.x - 2*cx);
+		if (dx < SLICE_OFFSET_TOLERANCE*sideLength){
+			continue;
+		}
+		if (spacing == 0 || dx < spacing){
+			spacing = dx;
+		}
+	}
+	if (spacing != 0 && spacing < SLICE_MIN_SPACING*sideLength){
+		spacing = SLICE_MIN_SPACING*sideLength;
+	}
+	return spacing;
+}
+
+double getFrameSliceSpacing(LayoutData* layoutData){
+	double spacing = 0;
+	for (int i = 0; i < layoutData->nPanels; i++){
+		Shape* shape = layoutData->panels[i].shape;
+		if (shape->shapeType == SHAPE_RHYTHM){
+			continue;
+		}
+		double s = shapeSliceSpacing(shape);
+		if (s > 0 && (spacing == 0 || s < spacing)){
+			spacing = s;
+		}
+	}
+	if (spacing == 0 && layoutData->nPanels > 0){
+		//only rhythm modules or degenerate shapes, fall back to the triangle spacing
+		spacing = 0.5*Shape::sideLength;
+	}
+	return spacing;
+}
+
+/**
+ * @description: computes the slice grid of the layout: the x of the first slice, the spacing and the number of slices
+ * @return: false if the layout is empty
+ */
+static bool getSliceGrid(LayoutData* layoutData, double* minX, double* spacing, int* nSlices){
+	if (layoutData->nPanels == 0){
+		return false;
+	}
+	double maxX = *minX = layoutData->panels[0].shape->getCentroid().x;
+	for (int i = 1; i < layoutData->nPanels; i++){
+		double x = layoutData->panels[i].shape->getCentroid().x;
+		if (x < *minX){
+			*minX = x;
+		}
+		if (x > maxX){
+			maxX = x;
+		}
+	}
+	*spacing = getFrameSliceSpacing(layoutData);
+	*nSlices = (int)floor((maxX - *minX)/(*spacing) + 0.5) + 1;
+	return true;
+}
+
+static inline int getSliceIndex(Panel* panel, double minX, double spacing, int nSlices){
+	int slice = (int)floor((panel->shape->getCentroid().x - minX)/spacing + 0.5);
+	return (slice >= nSlices) ? nSlices - 1 : slice;
+}
+
+void getFrameSlicesFromLayout(LayoutData* layoutData, FrameSlice_t** frameSlices, int* nFrameSlices){
+	double minX, spacing;
+	int nSlices;
+	*frameSlices = NULL;
+	*nFrameSlices = 0;
+	if (!getSliceGrid(layoutData, &minX, &spacing, &nSlices)){
+		return;
+	}
+
+	FrameSlice_t* slices = new FrameSlice_t[nSlices];
+	for (int i = 0; i < layoutData->nPanels; i++){
+		int slice = getSliceIndex(&layoutData->panels[i], minX, spacing, nSlices);
+		slices[slice].panelIds.push_back(layoutData->panels[i].panelId);
+	}
+
+	*frameSlices = slices;
+	*nFrameSlices = nSlices;
+}
+
+void getFrameSliceTableFromLayout(LayoutData* layoutData, FrameSliceTable_t* table){
+	double minX, spacing;
+	int nSlices;
+	if (!getSliceGrid(layoutData, &minX, &spacing, &nSlices)){
+		nSlices = 0;
+	}
+
+	//offsets always has the nSlices + 1 entries, also for an empty layout
+	if (!table->offsets || table->slicesCapacity < nSlices){
+		delete [] table->offsets;
+		table->offsets = new int[nSlices + 1];
+		table->slicesCapacity = nSlices;
+	}
+	if (table->panelIdsCapacity < layoutData->nPanels){
+		delete [] table->panelIds;
+		delete [] table->panelSlices;
+		table->panelIds = new int[layoutData->nPanels];
+		table->panelSlices = new int[layoutData->nPanels];
+		table->panelIdsCapacity = layoutData->nPanels;
+	}
+	table->nSlices = nSlices;
+	table->nPanelIds = layoutData->nPanels;
+	table->offsets[0] = 0;
+	if (nSlices == 0){
+		return;
+	}
+
+	//counting sort of the panels into their slices. offsets[i + 1] first counts the panels of slice i,
+	//then, after the prefix sum, offsets[i] is used as the write cursor of slice i and ends up as the end of slice i.
+	//The slice of every panel is computed once and kept in panelSlices for the second pass
+	for (int i = 0; i <= nSlices; i++){
+		table->offsets[i] = 0;
+	}
+	for (int i = 0; i < layoutData->nPanels; i++){
+		int slice = getSliceIndex(&layoutData->panels[i], minX, spacing, nSlices);
+		table->panelSlices[i] = slice;
+		table->offsets[slice + 1]++;
+	}
+	for (int i = 1; i <= nSlices; i++){
+		table->offsets[i] += table->offsets[i - 1];
+	}
+	for (int i = 0; i < layoutData->nPanels; i++){
+		table->panelIds[table->offsets[table->panelSlices[i]]++] = layoutData->panels[i].panelId;
+	}
+	//shift the end positions back into start positions
+	for (int i = nSlices; i > 0; i--){
+		table->offsets[i] = table->offsets[i - 1];
+	}
+	table->offsets[0] = 0;
+}
+
+int fillFramesFromSlice(const FrameSliceTable_t* table, int slice, const RGB_t& color, int transTime, Frame_t* frames){
+	const int* panelIds = table->panelIds + table->offsets[slice];
+	int n = table->offsets[slice + 1] - table->offsets[slice];
+	int r = color.R, g = color.G, b = color.B;
+	for (int i = 0; i < n; i++){
+		frames[i].panelId = panelIds[i];
+		frames[i].r = r;
+		frames[i].g = g;
+		frames[i].b = b;
+		frames[i].transTime = transTime;
+	}
+	return n;
+}
@@ -0,0 +1,128 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * SweepIndex.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_SWEEPINDEX_H_
+#define INC_SWEEPINDEX_H_
+
+#include "LayoutProcessingUtils.h"
+#include "LayoutUpdates.h"
+#include <vector>
+
+#define SWEEP_INDEX_DEFAULT_ANGLE_STEPS 720	/*default quantization of the sweep direction, i.e. 0.5 degree steps*/
+
+/**
+ * Index of the panel centroids projected onto an arbitrary direction, for wipes and sweeps that are not limited to
+ * multiples of 30 degrees and do not need rotateAuroraPanels.
+ * The direction is quantized to angleSteps steps over 360 degrees. The first time a direction is used, the projections
+ * of all panel centroids onto it are computed and sorted (O(n log n)). The result is kept, so every later query on that
+ * direction is a binary search that returns a contiguous run of panels (O(log n)).
+ */
+class SweepIndex {
+	SweepIndex(const SweepIndex&) = delete;
+	SweepIndex& operator=(const SweepIndex&) = delete;
+
+	struct SweepOrder {
+		std::vector<int> panelIds;			/*panelIds sorted by increasing projection*/
+		std::vector<int> indices;			/*the matching indices into the layout*/
+		std::vector<double> projections;	/*the sorted projections*/
+	};
+
+	int angleSteps;
+	std::vector<double> x, y;				/*centroids captured from the layout, in layout order*/
+	std::vector<int> panelIds;
+	double minX, minY, maxX, maxY;			/*bounding box of the centroids, only ever grows between rebuilds*/
+	std::vector<SweepOrder*> orders;		/*one lazily built entry per quantized direction*/
+
+	int quantizeAngle(degrees angle) const;
+	const SweepOrder& getOrder(int step);
+	void growBounds(double x, double y);
+	void insertIntoOrders(int index);
+	void eraseFromOrders(int index, bool renumber);
+
+public:
+	/**
+	 * @description: captures the panel centroids of the layout. No direction is computed yet
+	 * @params layoutData: the layout to index
+	 * @params angleSteps: number of quantized directions over 360 degrees
+	 */
+	SweepIndex(LayoutData* layoutData, int angleSteps = SWEEP_INDEX_DEFAULT_ANGLE_STEPS);
+	~SweepIndex();
+
+	/**
+	 * @description: re-captures the centroids after the layout changed and drops all cached directions
+	 */
+	void rebuild(LayoutData* layoutData);
+
+	/**
+	 * @description: applies layout deltas to the captured centroids and patches every cached direction in place
+	 * (O(n) per delta and direction), instead of dropping the cache as rebuild does. Panels keep the same indices as
+	 * in the layout updated by applyLayoutDeltas
+	 * @params layoutData: the layout the deltas were applied to
+	 * @params deltas: the deltas passed to pluginLayoutChanged, with raw positions
+	 * @params nDeltas: number of deltas
+	 * @params totalAuroraRotation: the rotation passed to applyLayoutDeltas
+	 */
+	void applyLayoutDeltas(const LayoutData* layoutData, const LayoutDelta_t* deltas, int nDeltas,
+			int totalAuroraRotation);
+
+	/**
+	 * @description: returns the panels whose centroid projection onto the direction lies in [from, to)
+	 * The projection of a centroid (x, y) onto the direction at angle a is x*cos(a) + y*sin(a), so 0 degrees sweeps
+	 * left to right and 90 degrees sweeps bottom to top
+	 * @params angle: the direction, in degrees. Snapped to the nearest quantized direction
+	 * @params from, to: the range of projections
+	 * @params panelIds: filled with a pointer to the panelIds in range, ordered by increasing projection.
+	 * Owned by the index and valid until rebuild is called or the index is destroyed
+	 * @params projections: optional, filled with a pointer to the matching projections
+	 * @return: the number of panels in range
+	 */
+	int getPanelsInRange(degrees angle, double from, double to, const int** panelIds, const double** projections = NULL);
+
+	/**
+	 * @description: returns the smallest and largest projection of the layout onto a direction, i.e. the range a full
+	 * sweep in that direction has to cover
+	 */
+	void getExtent(degrees angle, double* minProjection, double* maxProjection);
+
+	/**
+	 * @description: finds where a straight line through a panel enters or leaves the layout, e.g. the panel at the
+	 * bottom of a column, or the panel a shooting star starts from. Only panels whose centroid lies within
+	 * laneHalfWidth of the line count as hit.
+	 * The line is looked up in the cached order of the nearest quantized direction, so after the first use of that
+	 * direction a query is a binary search plus a check of the few panels that lie close to the line
+	 * @params panelIndex: index, in the layout, of the panel the line passes through
+	 * @params dx, dy: direction of travel along the line, need not be normalized
+	 * @params laneHalfWidth: panels whose centroid is closer than this to the line are hit
+	 * @params last: false for the first panel hit travelling along the direction (smallest projection), true for the
+	 * last one. On equal projections the panel with the lowest index wins
+	 * @return: index, in the layout, of the panel found. panelIndex itself if no other panel is hit, -1 if panelIndex
+	 * is out of range
+	 */
+	int getBoundaryPanel(int panelIndex, double dx, double dy, double laneHalfWidth, bool last = false);
+
+	/**
+	 * @description: drops the cached direction orders to release memory. They are rebuilt on demand
+	 */
+	void clearCache();
+};
+
+#endif /* INC_SWEEPINDEX_H_ */
@@ -28,6 +28,7 @@
 
 #include "AuroraPlugin.h"
 #include "LayoutProcessingUtils.h"
+#include "SweepIndex.h"
 #include "ColorUtils.h"
 #include "DataManager.h"
 #include <stdlib.h>
@@ -90,6 +91,7 @@ typedef struct {
 static RGB_t* paletteColours = NULL; // this is our saved pointer to the colour palette
 static int nColours = 0;             // the number of colours in the palette
 static LayoutData *layoutData; // this is our saved pointer to the panel layout information
+static SweepIndex *sweepIndex = NULL; // projections of the panels, to find where a shooting star enters the layout
 static source_t sources[MAX_PALETTE_COLOURS]; // this is our array for sources
 static int nSources = 0;
 static freq_bin freq_bins[MAX_PALETTE_COLOURS]; // this is our array for frequency bin historical information.
@@ -131,6 +133,7 @@ void initPlugin() {
     }
     
     layoutData = getLayoutData(); // grab the layout data and store a pointer to it for later use
+    sweepIndex = new SweepIndex(layoutData);
   
     
     PRINTLOG("The layout has %d panels:\n", layoutData->nPanels);
@@ -164,27 +167,6 @@ float distance(float x1, float y1, float x2, float y2)
 }
 
 
-/** 
-  * @description: compute the distance from a point to a line
-  * @param: x1, y1 and x2, y2 are two points that define the line
-  *         x3, y3 is the point
-  * @return: dist is the computed distance from the point to the closest point on the line
-  *          u is a scalar representing how far along the line do we need to go to get near
-  *          to the point
-  */
-void point2line(float x3, float y3, float x1, float y1, float x2, float y2, float *dist, float *u) // x3,y3 is the point
-{
-    float px = x2 - x1;
-    float py = y2 - y1;
-    float magnitude_squared = px * px + py * py;
-    *u = ((x3 - x1) * px + (y3 - y1) * py) / magnitude_squared;
-    float x = x1 + (*u) * px;
-    float y = y1 + (*u) * py;
-    float dx = x - x3;
-    float dy = y - y3;
-    *dist = sqrt(dx * dx + dy * dy);
-}
-
 /** 
   * @description: Adds a light source to the list of light sources. The light source will have a particular colour
   * and intensity and will move at a particular speed.
@@ -195,7 +177,6 @@ void addSource(int paletteIndex, float intensity, float speed)
     float y;
     float vx = 0;
     float vy = 0;
-    int i;
 
     // we need at least two panels to do anything meaningful in here
     if(layoutData->nPanels < 2) {
@@ -226,25 +207,9 @@ void addSource(int paletteIndex, float intensity, float speed)
     vx *= normalization * speed * ADJACENT_PANEL_DISTANCE;
     vy *= normalization * speed * ADJACENT_PANEL_DISTANCE;
     
-    // iterate through all panels and find the one that is closest to the edge of the
-    // Aurora setup and near the line where the "shooting star" will traverse; this
-    // will be the starting point of the light source
-    float min_t = 1.0e20;
-    int min_t_idx = -1;
-    for(i = 0; i < layoutData->nPanels; i++) {
-        x = layoutData->panels[i].shape->getCentroid().x;
-        y = layoutData->panels[i].shape->getCentroid().y;
-        float dist;
-        float t;
-        point2line(x, y, x1, y1, x2, y2, &dist, &t);
-        dist *= ADJACENT_PANEL_DISTANCE;
-        if(dist < 1.0) {
-            if(t < min_t) {
-                min_t = t;
-                min_t_idx = i;
-            }
-        }
-    }
+    // find the panel that is closest to the edge of the Aurora setup and near the line
+    // where the "shooting star" will traverse; this will be the starting point of the light source
+    int min_t_idx = sweepIndex->getBoundaryPanel(n1, vx, vy, 1.0 / ADJACENT_PANEL_DISTANCE);
     x = layoutData->panels[min_t_idx].shape->getCentroid().x;
     y = layoutData->panels[min_t_idx].shape->getCentroid().y;
 
@@ -428,5 +393,7 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime) {
  * Do all deallocation for memory allocated in initplugin here
  */
 void pluginCleanup() {
-    // do deallocation here, but there is nothing to deallocate
+    // do deallocation here
+    delete sweepIndex;
+    sweepIndex = NULL;
 }
@@ -4,13 +4,25 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/AuroraPlugin.cpp 
+../src/AuroraPlugin.cpp \
+../src/PaletteGradient.cpp \
+../src/FrameBuffer.cpp \
+../src/OKLab.cpp \
+../src/PaletteUpdates.cpp 
 
 OBJS += \
-./src/AuroraPlugin.o 
+./src/AuroraPlugin.o \
+./src/PaletteGradient.o \
+./src/FrameBuffer.o \
+./src/OKLab.o \
+./src/PaletteUpdates.o 
 
 CPP_DEPS += \
-./src/AuroraPlugin.d 
+./src/AuroraPlugin.d \
+./src/PaletteGradient.d \
+./src/FrameBuffer.d \
+./src/OKLab.d \
+./src/PaletteUpdates.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
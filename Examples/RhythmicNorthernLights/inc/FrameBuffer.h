@@ -0,0 +1,83 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FrameBuffer.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_FRAMEBUFFER_H_
+#define INC_FRAMEBUFFER_H_
+
+#include "AuroraPlugin.h"
+#include "LayoutProcessingUtils.h"
+
+/**
+ * Float colors of every panel, one array per channel, for plugins to accumulate a frame into (e.g. with the blend
+ * kernels) without converting to int and clamping per panel and source. writeFrames quantizes and clamps the whole
+ * buffer in one pass at the end. Entries are in the order of layoutData->panels
+ */
+struct FrameBuffer_t {
+	int nPanels;			/*number of entries*/
+	int* panelIds;			/*panelId of every entry*/
+	float* r;				/*channels in [0, 255], values outside are clamped when the frames are written*/
+	float* g;
+	float* b;
+	int capacity;
+	FrameBuffer_t(const FrameBuffer_t&) = delete;
+	FrameBuffer_t(){
+		nPanels = 0;
+		panelIds = NULL;
+		r = NULL;
+		g = NULL;
+		b = NULL;
+		capacity = 0;
+	}
+	~FrameBuffer_t(){
+		delete [] panelIds;
+		delete [] r;
+		delete [] g;
+		delete [] b;
+	}
+};
+
+/**
+ * @description: sizes the buffer for the layout and clears it to black. No allocation happens if the buffer already
+ * has enough capacity. Call again after the layout changed
+ * @params layoutData: the layout to render
+ * @params frameBuffer: the buffer to set up
+ */
+void getFrameBuffer(LayoutData* layoutData, FrameBuffer_t* frameBuffer);
+
+/**
+ * @description: sets every panel of the buffer to the same color, e.g. the background before sources are mixed in
+ * @params frameBuffer: the buffer to clear
+ * @params r, g, b: the color
+ */
+void clearFrameBuffer(FrameBuffer_t* frameBuffer, float r, float g, float b);
+
+/**
+ * @description: fills the frames from the buffer. Every channel is clamped into [0, 255] and truncated, as (int)
+ * would, in one vectorized pass; NaN becomes 0
+ * @params frameBuffer: the rendered buffer
+ * @params frames: the frames to fill, at least frameBuffer->nPanels of them
+ * @params transTime: transition time of every frame, in multiples of 100ms
+ * @return: the number of frames written, frameBuffer->nPanels
+ */
+int writeFrames(const FrameBuffer_t* frameBuffer, Frame_t* frames, int transTime);
+
+#endif /* INC_FRAMEBUFFER_H_ */
@@ -21,6 +21,9 @@
 #include "AuroraPlugin.h"
 #include "LayoutProcessingUtils.h"
 #include "ColorUtils.h"
+#include "PaletteGradient.h"
+#include "PaletteUpdates.h"
+#include "FrameBuffer.h"
 #include "DataManager.h"
 #include "Logger.h"
 #include "PluginFeatures.h"
@@ -38,9 +41,12 @@
 #define N_FFT_BINS 32			// number of fft bins to request in the sound feature and beat detector
 
 
-static RGB_t* paletteColours = NULL; // this is our saved pointer to the colour palette
+static const RGB_t* paletteColours = NULL; // this is our saved pointer to the colour palette
 static int nColours = 0;             // the number of colours in the palette
+static PaletteGradient_t paletteGradient; // the palette sampled into a lookup table, see getGradientColor
+static PaletteView_t paletteView;      // the palette the colours above come from, see updatePalette
 static LayoutData *layoutData;       // this is our saved pointer to the panel layout information
+static FrameBuffer_t frameBuffer;    // the colour of every panel while a frame is rendered
 
 
 // Here we store the information associated with each light source like current
@@ -71,6 +77,19 @@ extern "C" {
 }
 #endif
 
+/**
+ * @description: takes the current palette if it changed since the last call, and rebuilds the gradient from it.
+ * Called from initPlugin and at the top of every frame, so the palette only changes between frames
+ */
+void updatePalette(){
+	if (!refreshPaletteView(&paletteView)) {
+		return;
+	}
+	paletteColours = paletteView.colors;
+	nColours = paletteView.nColors;
+	buildPaletteGradient(paletteColours, nColours, PALETTE_GRADIENT_DEFAULT_SIZE, &paletteGradient);
+}
+
 /**
  * @description: Initialize the plugin. Called once, when the plugin is loaded.
  * This function can be used to enable rhythm or advanced features,
@@ -80,7 +99,7 @@ extern "C" {
  *
  */
 void initPlugin(){
-	getColorPalette(&paletteColours, &nColours);  // grab the palette colours and store a pointer to them for later use
+	updatePalette(); // grab the palette colours, the same as getColorPalette until the host changes them
 	PRINTLOG("The palette has %d colours:\n", nColours);
 
 	for (int i = 0; i < nColours; i++) {
@@ -88,6 +107,7 @@ void initPlugin(){
 	}
 
 	layoutData = getLayoutData(); // grab the layour data and store a pointer to it for later use
+	getFrameBuffer(layoutData, &frameBuffer);
 
 	PRINTLOG("The layout has %d panels:\n", layoutData->nPanels);
 	for (int i = 0; i < layoutData->nPanels; i++) {
@@ -116,58 +136,6 @@ float distance(float x1, float y1, float x2, float y2)
     return sqrt(dx * dx + dy * dy);
 }
 
-/**
- * @description: Get a colour by interpolating in a linear way amongs the set of colours in the palette
- * @param colour The colour we want between 0 and nColours - 1. We interpolate in the palette to come up
- *               with a final colour somewhere in the palettes spectrum.
- */
-void getRGB(float colour, int *returnR, int *returnG, int *returnB)
-{
-    float R;
-    float G;
-    float B;
-
-	if(nColours == 0) {
-	    *returnR = 128; // in the case of no palette, use half white as default
-	    *returnG = 128;
-	    *returnB = 128;
-	}
-	else if(nColours == 1) {
-	    *returnR = paletteColours[0].R;
-	    *returnG = paletteColours[0].G;
-	    *returnB = paletteColours[0].B;
-	}
-	else {
-	    int idx = (int)colour;
-	    float fraction = colour - (float)idx;
-
-        if(colour <= 0) {
-            R = paletteColours[0].R;
-            G = paletteColours[0].G;
-            B = paletteColours[0].B;
-        }
-        else if(idx < nColours - 1) {
-            float R1 = paletteColours[idx].R;
-            float G1 = paletteColours[idx].G;
-            float B1 = paletteColours[idx].B;
-            float R2 = paletteColours[idx + 1].R;
-            float G2 = paletteColours[idx + 1].G;
-            float B2 = paletteColours[idx + 1].B;
-            R = (1.0 - fraction) * R1 + fraction * R2;
-            G = (1.0 - fraction) * G1 + fraction * G2;
-            B = (1.0 - fraction) * B1 + fraction * B2;
-        }
-        else {
-            R = paletteColours[nColours - 1].R;
-            G = paletteColours[nColours - 1].G;
-            B = paletteColours[nColours - 1].B;
-        }
-	    *returnR = (int)R;
-	    *returnG = (int)G;
-	    *returnB = (int)B;
-	}
-}
-
 /**
   * @description: Adds a light source to the list of light sources. The light source will have a particular
   * colour and intensity and be centred on a randomly chosen panel
@@ -179,10 +147,10 @@ void addSource(float colour, float intensity, float speed)
     float y = layoutData->panels[r].shape->getCentroid().y;
 
     // decide in the colour of this light source and factor in the intensity to arrive at an RGB value
-	int R;
-	int G;
-	int B;
-    getRGB(colour, &R, &G, &B);
+	const RGB_t& rgb = getGradientColor(&paletteGradient, colour);
+	int R = rgb.R;
+	int G = rgb.G;
+	int B = rgb.B;
     R *= intensity;
     G *= intensity;
     B *= intensity;
@@ -217,7 +185,7 @@ void addSource(float colour, float intensity, float speed)
   * @description: This function will render the colour of the given single panel given
   * the positions of all the lights in the light source list.
   */
-void renderPanel(Panel *panel, int *returnR, int *returnG, int *returnB)
+void renderPanel(Panel *panel, float *returnR, float *returnG, float *returnB)
 {
     float R = 0.0;
     float G = 0.0;
@@ -256,21 +224,10 @@ void renderPanel(Panel *panel, int *returnR, int *returnG, int *returnB)
         B = B * (1.0 - factor) + sources[i].B * factor;
     }
 
-    // prepare the values we will be returning
-    *returnR = (int)R;
-    *returnG = (int)G;
-    *returnB = (int)B;
-
-    // let's not exceed 255 for any of the channels
-    if(*returnR > 255) {
-        *returnR = 255;
-    }
-    if(*returnG > 255) {
-        *returnG = 255;
-    }
-    if(*returnB > 255) {
-        *returnB = 255;
-    }
+    // return the values as they are, writeFrames clamps them when the frame is written
+    *returnR = R;
+    *returnG = G;
+    *returnB = B;
 }
 
 /**
@@ -311,13 +268,12 @@ void diffuseSources(void)
  * @param sleepTime: specify interval after which this function is called again, NULL if sound visualization plugin
  */
 void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
-	int R;
-	int G;
-	int B;
 	int i;
 	static int maxBinIndexSum = 0;
 	static int n = 0;
 
+	updatePalette(); // take a new palette from the host, if any
+
 	PRINTLOG("%d %1.1f %d\n", getIsBeat(), getTempo(), getIsOnset());
 
 	// figure out what frequency is strongest
@@ -359,21 +315,23 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
 		addSource(0.0, 0.3, 0.8);
 	}
 
-	// iterate through all the panels and render each one
+	// iterate through all the panels and render each one, then quantize them into the frames
 	for(i = 0; i < layoutData->nPanels; i++) {
-		renderPanel(&layoutData->panels[i], &R, &G, &B);
-		frames[i].panelId = layoutData->panels[i].panelId;
-		frames[i].r = R;
-		frames[i].g = G;
-		frames[i].b = B;
-		frames[i].transTime = TRANSITION_TIME;
+		renderPanel(&layoutData->panels[i], &frameBuffer.r[i], &frameBuffer.g[i], &frameBuffer.b[i]);
 	}
+	// this algorithm renders every panel at every frame
+	*nFrames = writeFrames(&frameBuffer, frames, TRANSITION_TIME);
 
 	// diffuse all the light sources so they are ready for the next frame
 	diffuseSources();
+}
 
-	// this algorithm renders every panel at every frame
-	*nFrames = layoutData->nPanels;
+/**
+ * @description: called on the host thread when the palette changes while the plugin runs. Defining it keeps the
+ * plugin running instead of being restarted. The new palette is picked up by updatePalette in getPluginFrame, so
+ * nothing the frame reads changes under it
+ */
+void pluginPaletteChanged(const PaletteView_t* palette){
 }
 
 /**
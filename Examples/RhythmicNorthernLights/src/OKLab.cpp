@@ -0,0 +1,101 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * OKLab.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "OKLab.h"
+#include <math.h>
+
+//below this chroma a color is taken as grey and its hue as meaningless
+#define OKLCH_GREY_CHROMA 1e-4
+
+static double srgbToLinear(int c){
+	c = (c < 0) ? 0 : ((c > 255) ? 255 : c);
+	double x = c/255.0;
+	return (x <= 0.04045) ? x/12.92 : pow((x + 0.055)/1.055, 2.4);
+}
+
+static int linearToSrgb(double x){
+	x = (x < 0) ? 0 : ((x > 1) ? 1 : x);
+	double c = (x <= 0.0031308) ? 12.92*x : 1.055*pow(x, 1/2.4) - 0.055;
+	return (int)(c*255 + 0.5);
+}
+
+/*
+ * The matrices are the ones published with OKLab: linear sRGB to an LMS cone response, a cube root, then to
+ * L, a, b. The inverse runs the same steps backwards
+ */
+void RGBtoOKLab(RGB_t rgb, OKLab_t* lab){
+	double r = srgbToLinear(rgb.R), g = srgbToLinear(rgb.G), b = srgbToLinear(rgb.B);
+	double l = cbrt(0.4122214708*r + 0.5363325363*g + 0.0514459929*b);
+	double m = cbrt(0.2119034982*r + 0.6806995451*g + 0.1073969566*b);
+	double s = cbrt(0.0883024619*r + 0.2817188376*g + 0.6299787005*b);
+	lab->L = 0.2104542553*l + 0.7936177850*m - 0.0040720468*s;
+	lab->a = 1.9779984951*l - 2.4285922050*m + 0.4505937099*s;
+	lab->b = 0.0259040371*l + 0.7827717662*m - 0.8086757660*s;
+}
+
+void OKLabtoRGB(OKLab_t lab, RGB_t* rgb){
+	double l = lab.L + 0.3963377774*lab.a + 0.2158037573*lab.b;
+	double m = lab.L - 0.1055613458*lab.a - 0.0638541728*lab.b;
+	double s = lab.L - 0.0894841775*lab.a - 1.2914855480*lab.b;
+	l = l*l*l;
+	m = m*m*m;
+	s = s*s*s;
+	rgb->R = linearToSrgb(4.0767416621*l - 3.3077115913*m + 0.2309699292*s);
+	rgb->G = linearToSrgb(-1.2684380046*l + 2.6097574011*m - 0.3413193965*s);
+	rgb->B = linearToSrgb(-0.0041960863*l - 0.7034186147*m + 1.7076147010*s);
+}
+
+void OKLabtoOKLCh(OKLab_t lab, OKLCh_t* lch){
+	lch->L = lab.L;
+	lch->C = sqrt(lab.a*lab.a + lab.b*lab.b);
+	double h = atan2(lab.b, lab.a)*180/M_PI;
+	lch->h = (h < 0) ? h + 360 : h;
+	lch->h = (lch->h >= 360) ? 0 : lch->h;
+}
+
+void OKLChtoOKLab(OKLCh_t lch, OKLab_t* lab){
+	double h = lch.h*M_PI/180;
+	lab->L = lch.L;
+	lab->a = lch.C*cos(h);
+	lab->b = lch.C*sin(h);
+}
+
+OKLab_t mixOKLab(const OKLab_t& from, const OKLab_t& to, double fraction){
+	OKLab_t lab;
+	lab.L = from.L + (to.L - from.L)*fraction;
+	lab.a = from.a + (to.a - from.a)*fraction;
+	lab.b = from.b + (to.b - from.b)*fraction;
+	return lab;
+}
+
+OKLCh_t mixOKLCh(const OKLCh_t& from, const OKLCh_t& to, double fraction){
+	double fromHue = (from.C < OKLCH_GREY_CHROMA) ? to.h : from.h;
+	double toHue = (to.C < OKLCH_GREY_CHROMA) ? fromHue : to.h;
+	double dh = toHue - fromHue;
+	dh = (dh > 180) ? dh - 360 : ((dh < -180) ? dh + 360 : dh);
+	OKLCh_t lch;
+	lch.L = from.L + (to.L - from.L)*fraction;
+	lch.C = from.C + (to.C - from.C)*fraction;
+	lch.h = fromHue + dh*fraction;
+	lch.h = (lch.h < 0) ? lch.h + 360 : ((lch.h >= 360) ? lch.h - 360 : lch.h);
+	return lch;
+}
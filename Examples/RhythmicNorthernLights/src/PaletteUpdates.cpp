@@ -0,0 +1,136 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PaletteUpdates.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "PaletteUpdates.h"
+#include "DataManager.h"
+#include <atomic>
+#include <mutex>
+
+struct PaletteSlot {
+	const RGB_t* colors;
+	int nColors;
+	RGB_t* buffer;			/*owned storage of the slot, colors points here once the host sent a palette*/
+	int capacity;
+	PaletteSlot(){
+		colors = NULL;
+		nColors = 0;
+		buffer = NULL;
+		capacity = 0;
+	}
+	~PaletteSlot(){
+		delete [] buffer;
+	}
+};
+
+/*
+ * Three slots: the one published last, the one the frame thread holds a view of (often the same) and a spare the host
+ * writes the next palette into, so a view stays valid however many updates arrive before the frame refreshes it. The
+ * reader announces the slot it is about to use and checks it is still the published one before using it, the writer
+ * never picks the published or the announced slot. Generation 1 is the palette of the DataManager, loaded into slot 0
+ * once by whichever thread asks first
+ */
+#define PALETTE_SLOTS 3
+#define PALETTE_SLOT_BITS 2
+#define PALETTE_SLOT_MASK 3
+#define PALETTE_NO_SLOT -1
+
+static PaletteSlot slots[PALETTE_SLOTS];
+static std::atomic<unsigned int> published(0);			/*generation << PALETTE_SLOT_BITS | slot*/
+static std::atomic<int> readerSlot(PALETTE_NO_SLOT);	/*the slot of the last view the frame thread filled*/
+static std::once_flag dataManagerPaletteLoaded;
+static std::mutex updateMutex;							/*serializes updates, in case the host sends them from several threads*/
+
+static void loadDataManagerPalette(){
+	RGB_t* palette = NULL;
+	int nColors = 0;
+	getColorPalette(&palette, &nColors);
+	slots[0].colors = palette;
+	slots[0].nColors = nColors;
+	published.store(1 << PALETTE_SLOT_BITS);
+}
+
+static unsigned int getPublished(){
+	std::call_once(dataManagerPaletteLoaded, loadDataManagerPalette);
+	return published.load();
+}
+
+static void fillView(unsigned int current, PaletteView_t* view){
+	const PaletteSlot& slot = slots[current & PALETTE_SLOT_MASK];
+	view->colors = slot.colors;
+	view->nColors = slot.nColors;
+	view->generation = current >> PALETTE_SLOT_BITS;
+}
+
+void getPaletteView(PaletteView_t* view){
+	unsigned int current = getPublished();
+	for (;;){
+		readerSlot.store(current & PALETTE_SLOT_MASK);
+		unsigned int check = published.load();
+		if (check == current){
+			break;
+		}
+		current = check;
+	}
+	fillView(current, view);
+}
+
+bool refreshPaletteView(PaletteView_t* view){
+	if (view->generation != 0 && view->generation == getPublished() >> PALETTE_SLOT_BITS){
+		return false;
+	}
+	getPaletteView(view);
+	return true;
+}
+
+int passColorPaletteUpdate(int* colorByteStream, int nColors){
+	if (!pluginPaletteChanged){
+		return PALETTE_UPDATE_NOT_HANDLED;
+	}
+	std::lock_guard<std::mutex> lock(updateMutex);
+	unsigned int current = getPublished();
+	int held = readerSlot.load();
+	int spare = 0;
+	while (spare == (int)(current & PALETTE_SLOT_MASK) || spare == held){
+		spare++;
+	}
+	PaletteSlot& slot = slots[spare];
+	if (nColors > slot.capacity){
+		delete [] slot.buffer;
+		slot.buffer = new RGB_t[nColors];
+		slot.capacity = nColors;
+	}
+	for (int i = 0; i < nColors; i++){
+		const int* c = colorByteStream + i*PALETTE_COLOR_INTS;
+		slot.buffer[i] = {c[0], c[1], c[2]};
+	}
+	slot.colors = slot.buffer;
+	slot.nColors = nColors;
+	unsigned int next = (current >> PALETTE_SLOT_BITS) + 1;
+	next = (next >= (1u << (32 - PALETTE_SLOT_BITS))) ? 2 : next;	//skip 0 on wrap around, it marks an empty view
+	published.store(next << PALETTE_SLOT_BITS | spare);
+
+	//the frame thread's view is left alone, the plugin gets one of its own
+	PaletteView_t view;
+	fillView(next << PALETTE_SLOT_BITS | spare, &view);
+	pluginPaletteChanged(&view);
+	return 0;
+}
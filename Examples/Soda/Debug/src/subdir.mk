@@ -4,13 +4,31 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/AuroraPlugin.cpp 
+../src/AuroraPlugin.cpp \
+../src/SweepIndex.cpp \
+../src/PaletteGradient.cpp \
+../src/BlendKernels.cpp \
+../src/FrameBuffer.cpp \
+../src/OKLab.cpp \
+../src/PaletteUpdates.cpp 
 
 OBJS += \
-./src/AuroraPlugin.o 
+./src/AuroraPlugin.o \
+./src/SweepIndex.o \
+./src/PaletteGradient.o \
+./src/BlendKernels.o \
+./src/FrameBuffer.o \
+./src/OKLab.o \
+./src/PaletteUpdates.o 
 
 CPP_DEPS += \
-./src/AuroraPlugin.d 
+./src/AuroraPlugin.d \
+./src/SweepIndex.d \
+./src/PaletteGradient.d \
+./src/BlendKernels.d \
+./src/FrameBuffer.d \
+./src/OKLab.d \
+./src/PaletteUpdates.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -0,0 +1,95 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PaletteUpdates.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_PALETTEUPDATES_H_
+#define INC_PALETTEUPDATES_H_
+
+#include "ColorUtils.h"
+#include <stddef.h>
+
+#define PALETTE_COLOR_INTS 3			/*ints per color in the color byte stream, R, G and B*/
+
+#define PALETTE_UPDATE_NOT_HANDLED 1	/*the plugin has no pluginPaletteChanged, the host has to restart it*/
+
+/**
+ * A read only view of the current color palette. The generation changes every time the palette is replaced, so a
+ * plugin can keep tables derived from the palette (gradients, LUTs) and rebuild them only when it actually changed.
+ * Views are filled by a single thread, the one calling getPluginFrame. The colors of its view stay valid until it fills
+ * the next one, however many updates the host sends in between: the host never writes into the slot of that view
+ */
+struct PaletteView_t {
+	const RGB_t* colors;		/*the palette colors*/
+	int nColors;				/*number of colors*/
+	unsigned int generation;	/*increases with every palette update, 0 for a view that was never filled*/
+	PaletteView_t(){
+		colors = NULL;
+		nColors = 0;
+		generation = 0;
+	}
+};
+
+/**
+ * @description: fills the view with the current palette. Before the first update this is the palette of the
+ * DataManager (getColorPalette). No allocation, no copy of the colors
+ * @params view: the view to fill
+ */
+void getPaletteView(PaletteView_t* view);
+
+/**
+ * @description: refreshes the view if the palette changed since it was filled, e.g. once per frame before using
+ * tables derived from the palette
+ * @params view: the view to refresh
+ * @return: true if the view was refreshed (the palette changed or the view was never filled), false otherwise
+ */
+bool refreshPaletteView(PaletteView_t* view);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+	 * @description: entry point for the host when the palette changes while the plugin runs. passColorPalette of the
+	 * utilities library only sets the palette before initPlugin, this one updates it in place. If the plugin
+	 * implements pluginPaletteChanged, the colors are written in place into a palette buffer no view uses, published
+	 * with a new generation and the plugin is notified. Otherwise nothing is changed and the host falls back to restarting
+	 * the plugin. Buffers only grow, a palette no larger than the previous ones is taken without allocating
+	 * @params colorByteStream: PALETTE_COLOR_INTS ints per color
+	 * @params nColors: number of colors
+	 * @return: 0 if the plugin took the update, PALETTE_UPDATE_NOT_HANDLED if it has to be restarted
+	 */
+	int passColorPaletteUpdate(int* colorByteStream, int nColors);
+
+	/**
+	 * @description: optional plugin callback, called after a new palette was published. Defining it tells the host
+	 * the plugin keeps running on palette changes instead of being restarted; plugins that do not define it are
+	 * restarted, as before. It runs on the host thread while getPluginFrame may be running, so it must not touch
+	 * anything the frame reads: the plugin calls refreshPaletteView at the top of getPluginFrame and rebuilds what is
+	 * derived from the palette when that returns true
+	 * @params palette: view of the new palette, only valid during the call
+	 */
+	void pluginPaletteChanged(const PaletteView_t* palette) __attribute__((weak));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_PALETTEUPDATES_H_ */
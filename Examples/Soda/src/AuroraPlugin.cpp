@@ -21,7 +21,12 @@
 #include <stdio.h>
 #include "AuroraPlugin.h"
 #include "LayoutProcessingUtils.h"
+#include "SweepIndex.h"
 #include "ColorUtils.h"
+#include "PaletteGradient.h"
+#include "PaletteUpdates.h"
+#include "BlendKernels.h"
+#include "FrameBuffer.h"
 #include "DataManager.h"
 #include "PluginFeatures.h"
 #include "Logger.h"
@@ -47,8 +52,10 @@ extern "C" {
 #define N_FFT_BINS 32     // number of fft bins to request in the sound feature and beat detector
 #define BUBBLE_RADIUS 0.2       // the radius of the bubbles the flow across the Aurora
 
-static RGB_t* paletteColours = NULL; // this is our saved pointer to the colour palette
+static const RGB_t* paletteColours = NULL; // this is our saved pointer to the colour palette
 static int nColours = 0;             // the number of colours in the palette
+static PaletteGradient_t paletteGradient; // the palette sampled into a lookup table, see getGradientColor
+static PaletteView_t paletteView;      // the palette the colours above come from, see updatePalette
 static LayoutData *layoutData;       // this is our saved pointer to the panel layout information
 
 #define MAX_START_POINTS 30
@@ -71,6 +78,24 @@ typedef struct {
 static source_t sources[MAX_SOURCES];
 static int nSources = 0;
 
+// the colour of every panel while a frame is rendered, and the mixing factor of a source
+static FrameBuffer_t frameBuffer;
+static float *panelFactor = NULL;
+
+/**
+ * @description: takes the current palette if it changed since the last call, and rebuilds the gradient from it.
+ * Called from initPlugin and at the top of every frame, so the palette only changes between frames
+ */
+void updatePalette()
+{
+    if (!refreshPaletteView(&paletteView)) {
+        return;
+    }
+    paletteColours = paletteView.colors;
+    nColours = paletteView.nColors;
+    buildPaletteGradient(paletteColours, nColours, PALETTE_GRADIENT_DEFAULT_SIZE, &paletteGradient);
+}
+
 /** Compute cartesian distance between two points */
 float distance(float x1, float y1, float x2, float y2)
 {
@@ -79,28 +104,6 @@ float distance(float x1, float y1, float x2, float y2)
     return sqrt(dx * dx + dy * dy);
 }
 
-/** 
-  * @description: compute the distance from a point to a line
-  * @param: x1, y1 and x2, y2 are two points that define the line
-  *         x3, y3 is the point
-  * @return: dist is the computed distance from the point to the closest point on the line
-  *          u is a scalar representing how far along the line do we need to go to get near
-  *          to the point
-  */
-void point2line(float x3, float y3, float x1, float y1, float x2, float y2, float *dist, float *u) // x3,y3 is the point
-{
-    float px = x2 - x1;
-    float py = y2 - y1;
-    float magnitude_squared = px * px + py * py;
-    *u = ((x3 - x1) * px + (y3 - y1) * py) / magnitude_squared;
-    float x = x1 + (*u) * px;
-    float y = y1 + (*u) * py;
-    float dx = x - x3;
-    float dy = y - y3;
-    *dist = sqrt(dx * dx + dy * dy);
-}
-
-
 /** This function will analyse the layout and determine some points on the layout where the
   * bubbles will start when first placed on tha canvas
   */
@@ -114,35 +117,18 @@ void defineStartPoints(void)
     if(layoutData->nPanels < 1) {
         return;
     }
+    SweepIndex sweepIndex(layoutData);
 
     // iterate through all panels
     for (int n1 = 0; n1 < layoutData->nPanels; n1++) {
-        // find a vector pointing from the chosen panel upward
         float x1 = layoutData->panels[n1].shape->getCentroid().x;
         float y1 = layoutData->panels[n1].shape->getCentroid().y;
-        float x2 = x1;
-        float y2 = 1.0;
         PRINTLOG("Panel coords: %f %f\n", x1, y1);
 
-        // iterate through all panels and find the one that is closest to the bottom of the
-        // Aurora setup and near the line where the "bubble" will float up; this
-        // will help define the starting point of the light source
-        float min_t = -1.0e20;
-        int min_t_idx = -1;
-        for(i = 0; i < layoutData->nPanels; i++) {
-            x = layoutData->panels[i].shape->getCentroid().x;
-            y = layoutData->panels[i].shape->getCentroid().y;
-            float dist;
-            float t;
-            point2line(x, y, x1, y1, x2, y2, &dist, &t);
-            dist *= ADJACENT_PANEL_DISTANCE;
-            if(dist < 1.0) {
-                if(t > min_t) {
-                    min_t = t;
-                    min_t_idx = i;
-                }
-            }
-        }
+        // find the panel that is closest to the bottom of the Aurora setup and near the line where
+        // the "bubble" will float up; this will help define the starting point of the light source.
+        // The line points from the chosen panel towards y = 1, so below y = 1 it runs down instead
+        int min_t_idx = sweepIndex.getBoundaryPanel(n1, 0, (y1 > 1.0) ? 1.0 : -1.0, 1.0 / ADJACENT_PANEL_DISTANCE);
         x = layoutData->panels[min_t_idx].shape->getCentroid().x;
         y = layoutData->panels[min_t_idx].shape->getCentroid().y;
 
@@ -183,7 +169,7 @@ void initPlugin() {
     enableEnergy();
     enableFft(N_FFT_BINS);
     enableBeatFeatures();
-    getColorPalette(&paletteColours, &nColours);
+    updatePalette(); // grab the palette colours, the same as getColorPalette until the host changes them
     PRINTLOG("The palette has %d colours:\n", nColours);
 
     for (int i = 0; i < nColours; i++) {
@@ -198,6 +184,9 @@ void initPlugin() {
         layoutData->panels[i].shape->getCentroid().x, layoutData->panels[i].shape->getCentroid().y);
     }
     defineStartPoints();
+
+    getFrameBuffer(layoutData, &frameBuffer);
+    panelFactor = new float[layoutData->nPanels];
 }
 
 /** Removes a light source from the list of light sources */
@@ -207,58 +196,6 @@ void removeSource(int idx)
   nSources--;
 }
 
-/**
- * @description: Get a colour by interpolating in a linear way amongs the set of colours in the palette
- * @param colour The colour we want between 0 and nColours - 1. We interpolate in the palette to come up
- *               with a final colour somewhere in the palettes spectrum.
- */
-void getRGB(float colour, int *returnR, int *returnG, int *returnB)
-{
-    float R;
-    float G;
-    float B;
-    
-  if(nColours == 0) {
-      *returnR = 128; // in the case of no palette, use half white as default
-      *returnG = 128;
-      *returnB = 128;
-  }
-  else if(nColours == 1) {
-      *returnR = paletteColours[0].R;
-      *returnG = paletteColours[0].G;
-      *returnB = paletteColours[0].B;
-  }
-  else {
-      int idx = (int)colour;
-      float fraction = colour - (float)idx;
-
-        if(colour <= 0) {
-            R = paletteColours[0].R;
-            G = paletteColours[0].G;
-            B = paletteColours[0].B;
-        }
-        else if(idx < nColours - 1) {
-            float R1 = paletteColours[idx].R;
-            float G1 = paletteColours[idx].G;
-            float B1 = paletteColours[idx].B;
-            float R2 = paletteColours[idx + 1].R;
-            float G2 = paletteColours[idx + 1].G;
-            float B2 = paletteColours[idx + 1].B;
-            R = (1.0 - fraction) * R1 + fraction * R2;
-            G = (1.0 - fraction) * G1 + fraction * G2;
-            B = (1.0 - fraction) * B1 + fraction * B2;
-        }
-        else {
-            R = paletteColours[nColours - 1].R;
-            G = paletteColours[nColours - 1].G;
-            B = paletteColours[nColours - 1].B;
-        }
-      *returnR = (int)R;
-      *returnG = (int)G;
-      *returnB = (int)B;
-  }
-}
-
 /** 
   * @description: Adds a light source to the list of light sources. The light source will have a particular colour
   * and intensity and will move at a particular speed.
@@ -285,10 +222,10 @@ void addSource(float colour, float intensity, float speed, float radius)
     vy = speed * ADJACENT_PANEL_DISTANCE;
     
     // decide in the colour of this light source and factor in the intensity to arrive at an RGB value
-    int R;
-    int G;
-    int B;
-    getRGB(colour, &R, &G, &B);
+    const RGB_t& rgb = getGradientColor(&paletteGradient, colour);
+    int R = rgb.R;
+    int G = rgb.G;
+    int B = rgb.B;
     R *= intensity;
     G *= intensity;
     B *= intensity;
@@ -311,34 +248,34 @@ void addSource(float colour, float intensity, float speed, float radius)
 }
 
 /**
-  * @description: This function will render the colour of the given single panel given
-  * the positions of all the lights in the light source list.
+  * @description: This function will render the colours of all panels given the positions of all the lights
+  * in the light source list. Each source is mixed into the whole frame with one blend pass per colour channel.
   */
-void renderPanel(Panel *panel, int *returnR, int *returnG, int *returnB)
+void renderPanels(void)
 {
-    float R = BASE_COLOUR_R;
-    float G = BASE_COLOUR_G;
-    float B = BASE_COLOUR_B;
+    int nPanels = layoutData->nPanels;
     int i;
 
+    clearFrameBuffer(&frameBuffer, BASE_COLOUR_R, BASE_COLOUR_G, BASE_COLOUR_B);
+
     // Iterate through all the sources
-    // Depending how close the source is to the panel, we take some fraction of its colour and mix it into an
-    // accumulator. Newest sources have the most weight. Old sources die away until they are gone.
-    for(i = 0; i < nSources; i++) {
-        float d = distance(panel->shape->getCentroid().x, panel->shape->getCentroid().y, sources[i].x, sources[i].y);
-        d = d / ADJACENT_PANEL_DISTANCE;
-        d = d - sources[i].radius;
-        float d2 = d * d;
-        float factor = 1.0 / (d2 * 1.5 + 1.0); // determines how much of the source's colour we mix in (depends on distance)
-                                               // the formula is not based on physics, it is fudged to get a good effect
-                                               // the formula yields a number between 0 and 1
-        R = R * (1.0 - factor) + sources[i].R * factor;
-        G = G * (1.0 - factor) + sources[i].G * factor;
-        B = B * (1.0 - factor) + sources[i].B * factor;
+    // Depending how close the source is to a panel, we take some fraction of its colour and mix it into the
+    // panel's colour. Newest sources have the most weight. Old sources die away until they are gone.
+    for(int s = 0; s < nSources; s++) {
+        for(i = 0; i < nPanels; i++) {
+            Panel *panel = &layoutData->panels[i];
+            float d = distance(panel->shape->getCentroid().x, panel->shape->getCentroid().y, sources[s].x, sources[s].y);
+            d = d / ADJACENT_PANEL_DISTANCE;
+            d = d - sources[s].radius;
+            float d2 = d * d;
+            panelFactor[i] = 1.0 / (d2 * 1.5 + 1.0); // determines how much of the source's colour we mix in (depends on distance)
+                                                     // the formula is not based on physics, it is fudged to get a good effect
+                                                     // the formula yields a number between 0 and 1
+        }
+        blendLerpConstant(frameBuffer.r, (float)sources[s].R, panelFactor, nPanels);
+        blendLerpConstant(frameBuffer.g, (float)sources[s].G, panelFactor, nPanels);
+        blendLerpConstant(frameBuffer.b, (float)sources[s].B, panelFactor, nPanels);
     }
-    *returnR = (int)R;
-    *returnG = (int)G;
-    *returnB = (int)B;
 }
 
 /**
@@ -376,13 +313,12 @@ void propogateSources(void)
  * @param sleepTime: specify interval after which this function is called again, NULL if sound visualization plugin
  */
 void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
-    int R;
-    int G;
-    int B;
     int i;
     static int maxBinIndexSum = 0;
     static int n = 0;
 
+    updatePalette(); // take a new palette from the host, if any
+
     // figure out what frequency is strongest
     int maxBin = 0;
     int maxBinIndex = 0;
@@ -418,21 +354,21 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
         addSource(0.0, 0.3, 0.3, BUBBLE_RADIUS);
     }
     
-    // iterate through all the panels and render each one
-    for(i = 0; i < layoutData->nPanels; i++) {
-        renderPanel(&layoutData->panels[i], &R, &G, &B);
-        frames[i].panelId = layoutData->panels[i].panelId;
-        frames[i].r = R;
-        frames[i].g = G;
-        frames[i].b = B;
-        frames[i].transTime = TRANSITION_TIME;
-  }
+    // render all the panels, then quantize them into the frames
+    renderPanels();
+    // this algorithm renders every panel at every frame
+    *nFrames = writeFrames(&frameBuffer, frames, TRANSITION_TIME);
 
     // move all the light sources so they are ready for the next frame
     propogateSources();
+}
 
-    // this algorithm renders every panel at every frame
-    *nFrames = layoutData->nPanels;
+/**
+ * @description: called on the host thread when the palette changes while the plugin runs. Defining it keeps the
+ * plugin running instead of being restarted. The new palette is picked up by updatePalette in getPluginFrame, so
+ * nothing the frame reads changes under it
+ */
+void pluginPaletteChanged(const PaletteView_t* palette){
 }
 
 /**
@@ -441,4 +377,5 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
  */
 void pluginCleanup(){
 	//do deallocation here
+	delete [] panelFactor;
 }
@@ -0,0 +1,313 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * BlendKernels.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "BlendKernels.h"
+#include <stddef.h>
+#if defined(__AVX__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*the scalar float blends have to round every product like the vector ones, so they must not be fused into FMAs,
+ *which compilers do by default on targets that have them*/
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+/*
+ * Every kernel is a struct with a scalar blend and, when vectors are available, the same blend on a vector, plus the
+ * load/store helpers of its element type. runKernel runs the vector blend over the bulk of a buffer and the scalar
+ * blend over the tail (or over everything without vectors). Integer blends only use exact integer arithmetic, float
+ * blends the same operations in the same order, so both paths agree.
+ */
+
+/*rounded x/255 for x <= 65535 and rounded x/65535 for x <= 65535*65535, without a division*/
+static inline uint32_t div255(uint32_t x){
+	x += 128;
+	return (x + (x >> 8)) >> 8;
+}
+
+static inline uint32_t div65535(uint32_t x){
+	x += 32768;
+	return (x + (x >> 16)) >> 16;
+}
+
+#if defined(__SSE2__)
+#define BLEND_SIMD
+
+#if defined(__AVX2__)
+#define INT_VECTOR_BYTES 32
+typedef __m256i vint;
+static inline vint loadi(const void* p){ return _mm256_loadu_si256((const __m256i*)p); }
+static inline void storei(void* p, vint v){ _mm256_storeu_si256((__m256i*)p, v); }
+static inline vint set8(uint8_t x){ return _mm256_set1_epi8((char)x); }
+static inline vint set16(uint16_t x){ return _mm256_set1_epi16((short)x); }
+static inline vint set32(uint32_t x){ return _mm256_set1_epi32((int)x); }
+static inline vint zeroi(){ return _mm256_setzero_si256(); }
+static inline vint xori(vint a, vint b){ return _mm256_xor_si256(a, b); }
+static inline vint addsU8(vint a, vint b){ return _mm256_adds_epu8(a, b); }
+static inline vint addsU16(vint a, vint b){ return _mm256_adds_epu16(a, b); }
+static inline vint maxU8(vint a, vint b){ return _mm256_max_epu8(a, b); }
+static inline vint maxU16(vint a, vint b){ return _mm256_max_epu16(a, b); }
+static inline vint add16(vint a, vint b){ return _mm256_add_epi16(a, b); }
+static inline vint add32(vint a, vint b){ return _mm256_add_epi32(a, b); }
+static inline vint mullo16(vint a, vint b){ return _mm256_mullo_epi16(a, b); }
+static inline vint mulhiU16(vint a, vint b){ return _mm256_mulhi_epu16(a, b); }
+static inline vint shift16By8(vint a){ return _mm256_srli_epi16(a, 8); }
+static inline vint shift32By16(vint a){ return _mm256_srli_epi32(a, 16); }
+static inline vint unpackLo8(vint a, vint b){ return _mm256_unpacklo_epi8(a, b); }
+static inline vint unpackHi8(vint a, vint b){ return _mm256_unpackhi_epi8(a, b); }
+static inline vint unpackLo16(vint a, vint b){ return _mm256_unpacklo_epi16(a, b); }
+static inline vint unpackHi16(vint a, vint b){ return _mm256_unpackhi_epi16(a, b); }
+static inline vint packU16(vint a, vint b){ return _mm256_packus_epi16(a, b); }
+static inline vint packU32(vint a, vint b){ return _mm256_packus_epi32(a, b); }
+#else
+#define INT_VECTOR_BYTES 16
+typedef __m128i vint;
+static inline vint loadi(const void* p){ return _mm_loadu_si128((const __m128i*)p); }
+static inline void storei(void* p, vint v){ _mm_storeu_si128((__m128i*)p, v); }
+static inline vint set8(uint8_t x){ return _mm_set1_epi8((char)x); }
+static inline vint set16(uint16_t x){ return _mm_set1_epi16((short)x); }
+static inline vint set32(uint32_t x){ return _mm_set1_epi32((int)x); }
+static inline vint zeroi(){ return _mm_setzero_si128(); }
+static inline vint xori(vint a, vint b){ return _mm_xor_si128(a, b); }
+static inline vint addsU8(vint a, vint b){ return _mm_adds_epu8(a, b); }
+static inline vint addsU16(vint a, vint b){ return _mm_adds_epu16(a, b); }
+static inline vint maxU8(vint a, vint b){ return _mm_max_epu8(a, b); }
+static inline vint maxU16(vint a, vint b){ return _mm_add_epi16(_mm_subs_epu16(a, b), b); }
+static inline vint add16(vint a, vint b){ return _mm_add_epi16(a, b); }
+static inline vint add32(vint a, vint b){ return _mm_add_epi32(a, b); }
+static inline vint mullo16(vint a, vint b){ return _mm_mullo_epi16(a, b); }
+static inline vint mulhiU16(vint a, vint b){ return _mm_mulhi_epu16(a, b); }
+static inline vint shift16By8(vint a){ return _mm_srli_epi16(a, 8); }
+static inline vint shift32By16(vint a){ return _mm_srli_epi32(a, 16); }
+static inline vint unpackLo8(vint a, vint b){ return _mm_unpacklo_epi8(a, b); }
+static inline vint unpackHi8(vint a, vint b){ return _mm_unpackhi_epi8(a, b); }
+static inline vint unpackLo16(vint a, vint b){ return _mm_unpacklo_epi16(a, b); }
+static inline vint unpackHi16(vint a, vint b){ return _mm_unpackhi_epi16(a, b); }
+static inline vint packU16(vint a, vint b){ return _mm_packus_epi16(a, b); }
+//SSE2 only packs signed 32 bit values, so move 0 ... 65535 into the signed range and back
+static inline vint packU32(vint a, vint b){
+	const vint bias = set32(32768);
+	return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(a, bias), _mm_sub_epi32(b, bias)), set16(0x8000));
+}
+#endif
+
+#if defined(__AVX__)
+#define FLOAT_LANES 8
+typedef __m256 vfloat;
+static inline vfloat loadf(const float* p){ return _mm256_loadu_ps(p); }
+static inline void storef(float* p, vfloat v){ _mm256_storeu_ps(p, v); }
+static inline vfloat setf(float x){ return _mm256_set1_ps(x); }
+static inline vfloat addf(vfloat a, vfloat b){ return _mm256_add_ps(a, b); }
+static inline vfloat subf(vfloat a, vfloat b){ return _mm256_sub_ps(a, b); }
+static inline vfloat mulf(vfloat a, vfloat b){ return _mm256_mul_ps(a, b); }
+static inline vfloat maxf(vfloat a, vfloat b){ return _mm256_max_ps(a, b); }
+#else
+#define FLOAT_LANES 4
+typedef __m128 vfloat;
+static inline vfloat loadf(const float* p){ return _mm_loadu_ps(p); }
+static inline void storef(float* p, vfloat v){ _mm_storeu_ps(p, v); }
+static inline vfloat setf(float x){ return _mm_set1_ps(x); }
+static inline vfloat addf(vfloat a, vfloat b){ return _mm_add_ps(a, b); }
+static inline vfloat subf(vfloat a, vfloat b){ return _mm_sub_ps(a, b); }
+static inline vfloat mulf(vfloat a, vfloat b){ return _mm_mul_ps(a, b); }
+static inline vfloat maxf(vfloat a, vfloat b){ return _mm_max_ps(a, b); }
+#endif
+
+/*rounded x/255 on 16 bit lanes and rounded x/65535 on 32 bit lanes, as div255 and div65535*/
+static inline vint div255Lanes(vint x){
+	vint y = add16(x, set16(128));
+	return shift16By8(add16(y, shift16By8(y)));
+}
+
+static inline vint div65535Lanes(vint x){
+	vint y = add32(x, set32(32768));
+	return shift32By16(add32(y, shift32By16(y)));
+}
+
+/*a*b + c*d on 8 bit lanes, widened to two vectors of 16 bit lanes and divided by 255*/
+static inline vint mulAdd8(vint a, vint b, vint c, vint d){
+	vint z = zeroi();
+	vint lo = add16(mullo16(unpackLo8(a, z), unpackLo8(b, z)), mullo16(unpackLo8(c, z), unpackLo8(d, z)));
+	vint hi = add16(mullo16(unpackHi8(a, z), unpackHi8(b, z)), mullo16(unpackHi8(c, z), unpackHi8(d, z)));
+	return packU16(div255Lanes(lo), div255Lanes(hi));
+}
+
+/*a*b + c*d on 16 bit lanes, widened to two vectors of 32 bit lanes and divided by 65535*/
+static inline vint mulAdd16(vint a, vint b, vint c, vint d){
+	vint ab0 = mullo16(a, b), ab1 = mulhiU16(a, b);
+	vint cd0 = mullo16(c, d), cd1 = mulhiU16(c, d);
+	vint lo = add32(unpackLo16(ab0, ab1), unpackLo16(cd0, cd1));
+	vint hi = add32(unpackHi16(ab0, ab1), unpackHi16(cd0, cd1));
+	return packU32(div65535Lanes(lo), div65535Lanes(hi));
+}
+#endif
+
+struct Bytes {
+	typedef uint8_t T;
+#ifdef BLEND_SIMD
+	typedef vint V;
+	enum { N = INT_VECTOR_BYTES };
+	static V load(const T* p){ return loadi(p); }
+	static void store(T* p, V v){ storei(p, v); }
+	static V set(T x){ return set8(x); }
+#endif
+};
+
+struct Words {
+	typedef uint16_t T;
+#ifdef BLEND_SIMD
+	typedef vint V;
+	enum { N = INT_VECTOR_BYTES/2 };
+	static V load(const T* p){ return loadi(p); }
+	static void store(T* p, V v){ storei(p, v); }
+	static V set(T x){ return set16(x); }
+#endif
+};
+
+struct Floats {
+	typedef float T;
+#ifdef BLEND_SIMD
+	typedef vfloat V;
+	enum { N = FLOAT_LANES };
+	static V load(const T* p){ return loadf(p); }
+	static void store(T* p, V v){ storef(p, v); }
+	static V set(T x){ return setf(x); }
+#endif
+};
+
+#ifdef BLEND_SIMD
+#define VECTOR_BLEND(body) static V vector(V d, V s, V t){ (void)t; body }
+#else
+#define VECTOR_BLEND(body)
+#endif
+#define SCALAR_BLEND(body) static T scalar(T d, T s, T t){ (void)t; body }
+
+struct LerpU8 : Bytes {
+	SCALAR_BLEND(return div255(d*(255u - t) + s*t);)
+	VECTOR_BLEND(return mulAdd8(d, xori(t, set8(0xFF)), s, t);)
+};
+struct LerpU16 : Words {
+	SCALAR_BLEND(return div65535(d*(65535u - t) + (uint32_t)s*t);)
+	VECTOR_BLEND(return mulAdd16(d, xori(t, set16(0xFFFF)), s, t);)
+};
+struct LerpF : Floats {
+	SCALAR_BLEND(return d*(1.0f - t) + s*t;)
+	VECTOR_BLEND(return addf(mulf(d, subf(setf(1.0f), t)), mulf(s, t));)
+};
+struct AddU8 : Bytes {
+	SCALAR_BLEND(return (d + s > 255) ? 255 : d + s;)
+	VECTOR_BLEND(return addsU8(d, s);)
+};
+struct AddU16 : Words {
+	SCALAR_BLEND(return (d + s > 65535) ? 65535 : d + s;)
+	VECTOR_BLEND(return addsU16(d, s);)
+};
+struct AddF : Floats {
+	SCALAR_BLEND(return d + s;)
+	VECTOR_BLEND(return addf(d, s);)
+};
+struct MaxU8 : Bytes {
+	SCALAR_BLEND(return (d > s) ? d : s;)
+	VECTOR_BLEND(return maxU8(d, s);)
+};
+struct MaxU16 : Words {
+	SCALAR_BLEND(return (d > s) ? d : s;)
+	VECTOR_BLEND(return maxU16(d, s);)
+};
+struct MaxF : Floats {
+	SCALAR_BLEND(return (d > s) ? d : s;)
+	VECTOR_BLEND(return maxf(d, s);)
+};
+struct MultiplyU8 : Bytes {
+	SCALAR_BLEND(return div255(d*s);)
+	VECTOR_BLEND(return mulAdd8(d, s, zeroi(), zeroi());)
+};
+struct MultiplyU16 : Words {
+	SCALAR_BLEND(return div65535((uint32_t)d*s);)
+	VECTOR_BLEND(return mulAdd16(d, s, zeroi(), zeroi());)
+};
+struct MultiplyF : Floats {
+	SCALAR_BLEND(return d*s;)
+	VECTOR_BLEND(return mulf(d, s);)
+};
+struct ScreenU8 : Bytes {
+	SCALAR_BLEND(return 255 - div255((255u - d)*(255u - s));)
+	VECTOR_BLEND(const V ones = set8(0xFF); return xori(mulAdd8(xori(d, ones), xori(s, ones), zeroi(), zeroi()), ones);)
+};
+struct ScreenU16 : Words {
+	SCALAR_BLEND(return 65535 - div65535((65535u - d)*(65535u - s));)
+	VECTOR_BLEND(const V ones = set16(0xFFFF); return xori(mulAdd16(xori(d, ones), xori(s, ones), zeroi(), zeroi()), ones);)
+};
+struct ScreenF : Floats {
+	SCALAR_BLEND(return (d + s) - d*s;)
+	VECTOR_BLEND(return subf(addf(d, s), mulf(d, s));)
+};
+
+/**
+ * @description: blends src (or the constant srcValue if src is NULL) into dst, with the blend factors t (0 if t is
+ * NULL, for kernels without factors)
+ */
+template <class Kernel>
+static void runKernel(typename Kernel::T* dst, const typename Kernel::T* src, typename Kernel::T srcValue,
+		const typename Kernel::T* t, int n){
+	int i = 0;
+#ifdef BLEND_SIMD
+	typename Kernel::V constant = Kernel::set(srcValue), zero = Kernel::set(0);
+	for (; i + Kernel::N <= n; i += Kernel::N){
+		typename Kernel::V s = src ? Kernel::load(src + i) : constant;
+		typename Kernel::V f = t ? Kernel::load(t + i) : zero;
+		Kernel::store(dst + i, Kernel::vector(Kernel::load(dst + i), s, f));
+	}
+#endif
+	for (; i < n; i++){
+		dst[i] = Kernel::scalar(dst[i], src ? src[i] : srcValue, t ? t[i] : 0);
+	}
+}
+
+void blendLerp(uint8_t* dst, const uint8_t* src, const uint8_t* t, int n){ runKernel<LerpU8>(dst, src, 0, t, n); }
+void blendLerp(uint16_t* dst, const uint16_t* src, const uint16_t* t, int n){ runKernel<LerpU16>(dst, src, 0, t, n); }
+void blendLerp(float* dst, const float* src, const float* t, int n){ runKernel<LerpF>(dst, src, 0, t, n); }
+
+void blendLerpConstant(uint8_t* dst, uint8_t src, const uint8_t* t, int n){ runKernel<LerpU8>(dst, NULL, src, t, n); }
+void blendLerpConstant(uint16_t* dst, uint16_t src, const uint16_t* t, int n){ runKernel<LerpU16>(dst, NULL, src, t, n); }
+void blendLerpConstant(float* dst, float src, const float* t, int n){ runKernel<LerpF>(dst, NULL, src, t, n); }
+
+void blendAdd(uint8_t* dst, const uint8_t* src, int n){ runKernel<AddU8>(dst, src, 0, NULL, n); }
+void blendAdd(uint16_t* dst, const uint16_t* src, int n){ runKernel<AddU16>(dst, src, 0, NULL, n); }
+void blendAdd(float* dst, const float* src, int n){ runKernel<AddF>(dst, src, 0, NULL, n); }
+
+void blendMax(uint8_t* dst, const uint8_t* src, int n){ runKernel<MaxU8>(dst, src, 0, NULL, n); }
+void blendMax(uint16_t* dst, const uint16_t* src, int n){ runKernel<MaxU16>(dst, src, 0, NULL, n); }
+void blendMax(float* dst, const float* src, int n){ runKernel<MaxF>(dst, src, 0, NULL, n); }
+
+void blendMultiply(uint8_t* dst, const uint8_t* src, int n){ runKernel<MultiplyU8>(dst, src, 0, NULL, n); }
+void blendMultiply(uint16_t* dst, const uint16_t* src, int n){ runKernel<MultiplyU16>(dst, src, 0, NULL, n); }
+void blendMultiply(float* dst, const float* src, int n){ runKernel<MultiplyF>(dst, src, 0, NULL, n); }
+
+void blendScreen(uint8_t* dst, const uint8_t* src, int n){ runKernel<ScreenU8>(dst, src, 0, NULL, n); }
+void blendScreen(uint16_t* dst, const uint16_t* src, int n){ runKernel<ScreenU16>(dst, src, 0, NULL, n); }
+void blendScreen(float* dst, const float* src, int n){ runKernel<ScreenF>(dst, src, 0, NULL, n); }
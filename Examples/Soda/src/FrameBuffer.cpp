@@ -0,0 +1,98 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FrameBuffer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "FrameBuffer.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void getFrameBuffer(LayoutData* layoutData, FrameBuffer_t* frameBuffer){
+	int n = layoutData->nPanels;
+	if (n > frameBuffer->capacity){
+		delete [] frameBuffer->panelIds;
+		delete [] frameBuffer->r;
+		delete [] frameBuffer->g;
+		delete [] frameBuffer->b;
+		frameBuffer->panelIds = new int[n];
+		frameBuffer->r = new float[n];
+		frameBuffer->g = new float[n];
+		frameBuffer->b = new float[n];
+		frameBuffer->capacity = n;
+	}
+	frameBuffer->nPanels = n;
+	for (int i = 0; i < n; i++){
+		frameBuffer->panelIds[i] = layoutData->panels[i].panelId;
+	}
+	clearFrameBuffer(frameBuffer, 0, 0, 0);
+}
+
+void clearFrameBuffer(FrameBuffer_t* frameBuffer, float r, float g, float b){
+	for (int i = 0; i < frameBuffer->nPanels; i++){
+		frameBuffer->r[i] = r;
+		frameBuffer->g[i] = g;
+		frameBuffer->b[i] = b;
+	}
+}
+
+//the comparisons are ordered so NaN fails both and ends up as 0, like maxps and minps below
+static inline int quantize(float x){
+	x = (x > 0.0f) ? x : 0.0f;
+	x = (x < 255.0f) ? x : 255.0f;
+	return (int)x;
+}
+
+#if defined(__SSE2__)
+static inline __m128i quantize(__m128 x){
+	x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+	return _mm_cvttps_epi32(x);
+}
+#endif
+
+int writeFrames(const FrameBuffer_t* frameBuffer, Frame_t* frames, int transTime){
+	int n = frameBuffer->nPanels;
+	int i = 0;
+#if defined(__SSE2__)
+	//Frame_t interleaves the channels, so quantize 4 panels per channel and scatter them
+	int r[4], g[4], b[4];
+	for (; i + 4 <= n; i += 4){
+		_mm_storeu_si128((__m128i*)r, quantize(_mm_loadu_ps(frameBuffer->r + i)));
+		_mm_storeu_si128((__m128i*)g, quantize(_mm_loadu_ps(frameBuffer->g + i)));
+		_mm_storeu_si128((__m128i*)b, quantize(_mm_loadu_ps(frameBuffer->b + i)));
+		for (int k = 0; k < 4; k++){
+			Frame_t& frame = frames[i + k];
+			frame.panelId = frameBuffer->panelIds[i + k];
+			frame.r = r[k];
+			frame.g = g[k];
+			frame.b = b[k];
+			frame.transTime = transTime;
+		}
+	}
+#endif
+	for (; i < n; i++){
+		frames[i].panelId = frameBuffer->panelIds[i];
+		frames[i].r = quantize(frameBuffer->r[i]);
+		frames[i].g = quantize(frameBuffer->g[i]);
+		frames[i].b = quantize(frameBuffer->b[i]);
+		frames[i].transTime = transTime;
+	}
+	return n;
+}
@@ -0,0 +1,117 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * PaletteGradient.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "PaletteGradient.h"
+#include "OKLab.h"
+#include "DataManager.h"
+#include <vector>
+
+static RGB_t interpolate(const RGB_t& c1, const RGB_t& c2, float fraction){
+	RGB_t rgb;
+	rgb.R = (int)((1.0f - fraction)*c1.R + fraction*c2.R);
+	rgb.G = (int)((1.0f - fraction)*c1.G + fraction*c2.G);
+	rgb.B = (int)((1.0f - fraction)*c1.B + fraction*c2.B);
+	return rgb;
+}
+
+static RGB_t interpolate(const OKLab_t& c1, const OKLab_t& c2, float fraction){
+	RGB_t rgb;
+	OKLabtoRGB(mixOKLab(c1, c2, fraction), &rgb);
+	return rgb;
+}
+
+static RGB_t interpolate(const OKLCh_t& c1, const OKLCh_t& c2, float fraction){
+	OKLab_t lab;
+	OKLChtoOKLab(mixOKLCh(c1, c2, fraction), &lab);
+	RGB_t rgb;
+	OKLabtoRGB(lab, &rgb);
+	return rgb;
+}
+
+/**
+ * @description: fills the gradient between palette colors given in the color space to interpolate in
+ */
+template <typename Color>
+static void sampleGradient(const RGB_t* palette, const Color* colors, int nColors, PaletteGradient_t* gradient){
+	int size = gradient->size;
+	for (int k = 0; k < size; k++){
+		float colour = (float)k*(nColors - 1)/(size - 1);
+		int idx = (int)colour;
+		float fraction = colour - idx;
+		if (idx >= nColors - 1 || fraction == 0){
+			gradient->colors[k] = palette[(idx >= nColors - 1) ? nColors - 1 : idx];
+			continue;
+		}
+		gradient->colors[k] = interpolate(colors[idx], colors[idx + 1], fraction);
+	}
+}
+
+void buildPaletteGradient(const RGB_t* palette, int nColors, int size, PaletteGradient_t* gradient, int mode){
+	size = (size < 2) ? 2 : size;
+	if (size > gradient->capacity){
+		delete [] gradient->colors;
+		gradient->colors = new RGB_t[size];
+		gradient->capacity = size;
+	}
+	gradient->size = size;
+	gradient->scale = (nColors > 1) ? (float)(size - 1)/(nColors - 1) : 0;
+
+	if (nColors < 2){
+		for (int k = 0; k < size; k++){
+			//in the case of no palette, use half white as default
+			gradient->colors[k] = (nColors == 0) ? RGB_t{128, 128, 128} : palette[0];
+		}
+		return;
+	}
+
+	//convert the palette colors once, only the entries in between are converted back
+	if (mode == PALETTE_INTERPOLATION_OKLAB || mode == PALETTE_INTERPOLATION_OKLCH){
+		std::vector<OKLab_t> lab(nColors);
+		for (int i = 0; i < nColors; i++){
+			RGBtoOKLab(palette[i], &lab[i]);
+		}
+		if (mode == PALETTE_INTERPOLATION_OKLAB){
+			sampleGradient(palette, lab.data(), nColors, gradient);
+			return;
+		}
+		std::vector<OKLCh_t> lch(nColors);
+		for (int i = 0; i < nColors; i++){
+			OKLabtoOKLCh(lab[i], &lch[i]);
+		}
+		sampleGradient(palette, lch.data(), nColors, gradient);
+		return;
+	}
+	sampleGradient(palette, palette, nColors, gradient);
+}
+
+void getPaletteGradient(PaletteGradient_t* gradient, int size, int mode){
+	RGB_t* palette = NULL;
+	int nColors = 0;
+	getColorPalette(&palette, &nColors);
+	buildPaletteGradient(palette, nColors, size, gradient, mode);
+}
+
+void getGradientColors(const PaletteGradient_t* gradient, const float* colours, RGB_t* rgb, int n){
+	for (int i = 0; i < n; i++){
+		rgb[i] = getGradientColor(gradient, colours[i]);
+	}
+}
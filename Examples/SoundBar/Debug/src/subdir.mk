@@ -5,15 +5,27 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../src/AuroraPlugin.cpp \
-../src/AveragingFilter.cpp
+../src/AveragingFilter.cpp \
+../src/FrameSlicing.cpp \
+../src/LayoutUpdates.cpp \
+../src/RGB8.cpp \
+../src/LayoutCache.cpp 
 
 OBJS += \
 ./src/AuroraPlugin.o \
-./src/AveragingFilter.o 
+./src/AveragingFilter.o \
+./src/FrameSlicing.o \
+./src/LayoutUpdates.o \
+./src/RGB8.o \
+./src/LayoutCache.o 
 
 CPP_DEPS += \
 ./src/AuroraPlugin.d \
-./src/AveragingFilter.d
+./src/AveragingFilter.d \
+./src/FrameSlicing.d \
+./src/LayoutUpdates.d \
+./src/RGB8.d \
+./src/LayoutCache.d 
 
 # Each subdirectory must supply rules for building sources it contributes
 src/%.o: ../src/%.cpp
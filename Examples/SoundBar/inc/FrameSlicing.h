@@ -0,0 +1,108 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FrameSlicing.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_FRAMESLICING_H_
+#define INC_FRAMESLICING_H_
+
+#include "LayoutProcessingUtils.h"
+#include "AuroraPlugin.h"
+#include "ColorUtils.h"
+
+/**
+ * Flat (CSR) representation of a set of frame slices. The panelIds of all slices are stored back to back in one array,
+ * the panelIds of slice i being panelIds[offsets[i]] ... panelIds[offsets[i+1] - 1].
+ * The buffers are owned by the table and are only reallocated when a layout needs more room than a previous one,
+ * so the same table can be filled again after every rotation without allocating
+ */
+struct FrameSliceTable_t {
+	int nSlices;			/*number of slices in the table*/
+	int nPanelIds;			/*total number of panelIds over all slices*/
+	int* offsets;			/*nSlices + 1 entries, offsets[nSlices] == nPanelIds*/
+	int* panelIds;			/*panelIds of all slices, slice after slice*/
+	int* panelSlices;		/*scratch, the slice of every panel while the table is filled*/
+	int slicesCapacity;
+	int panelIdsCapacity;
+	FrameSliceTable_t(const FrameSliceTable_t&) = delete;
+	FrameSliceTable_t(){
+		nSlices = 0;
+		nPanelIds = 0;
+		offsets = NULL;
+		panelIds = NULL;
+		panelSlices = NULL;
+		slicesCapacity = 0;
+		panelIdsCapacity = 0;
+	}
+	~FrameSliceTable_t(){
+		delete [] offsets;
+		delete [] panelIds;
+		delete [] panelSlices;
+	}
+	int sliceSize(int slice) const {
+		return offsets[slice + 1] - offsets[slice];
+	}
+};
+
+/**
+ * @description: Shape-generic version of getFrameSlicesFromLayoutForTriangle. Breaks the layout down into frame slices
+ * along the x axis for triangle, square, rhythm and mixed layouts.
+ * The grid spacing is derived from the current geometry of every shape: it is the smallest non-zero x offset between
+ * a panel's centroid and the centroid of a panel attached to any of its edges. This gives 0.5*sideLength or
+ * 0.288*sideLength for triangles (as in getFrameSlicesFromLayoutForTriangle), sideLength for axis aligned squares and
+ * 0.707*sideLength for squares at 45 degrees. Mixed layouts use the finest spacing found in the layout.
+ * Rhythm modules do not take part in choosing the spacing but are still placed in the slice their centroid falls in.
+ * Rotate the layout with rotateAuroraPanels before calling this to slice along a different direction.
+ *
+ * @params layoutData: the layoutData to process
+ * @params frameSlices: A buffer that is dynamically allocated internally. Slices are ordered by increasing x, and every
+ * grid column between the leftmost and rightmost panel gets a slice, even if it is empty
+ * Deallocate with freeFrameSlices
+ * @params nFrameSlices: filled with the number of frame slices in frameSlices
+ */
+void getFrameSlicesFromLayout(LayoutData* layoutData, FrameSlice_t** frameSlices, int* nFrameSlices);
+
+/**
+ * @description: returns the grid spacing getFrameSlicesFromLayout would use for the layout in its current orientation
+ * @params layoutData: the layoutData to process
+ * @return: the grid spacing, in layout units. 0 if the layout is empty
+ */
+double getFrameSliceSpacing(LayoutData* layoutData);
+
+/**
+ * @description: same slicing as getFrameSlicesFromLayout, written into a flat FrameSliceTable_t instead of an array of
+ * FrameSlice_t. No allocation happens if the table already has enough capacity
+ * @params layoutData: the layoutData to process
+ * @params table: the table to fill. Previous contents are overwritten
+ */
+void getFrameSliceTableFromLayout(LayoutData* layoutData, FrameSliceTable_t* table);
+
+/**
+ * @description: writes one Frame_t per panel of a slice, all with the same color and transition time
+ * @params table: the frame slices
+ * @params slice: index of the slice to write
+ * @params color: the color of every panel in the slice
+ * @params transTime: the transition time of every panel in the slice
+ * @params frames: the buffer to write to, must have room for table->sliceSize(slice) entries
+ * @return: the number of frames written
+ */
+int fillFramesFromSlice(const FrameSliceTable_t* table, int slice, const RGB_t& color, int transTime, Frame_t* frames);
+
+#endif /* INC_FRAMESLICING_H_ */
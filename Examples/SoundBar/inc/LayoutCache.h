@@ -0,0 +1,150 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutCache.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_LAYOUTCACHE_H_
+#define INC_LAYOUTCACHE_H_
+
+#include "LayoutProcessingUtils.h"
+#include "AuroraPlugin.h"
+#include "ColorUtils.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#define LAYOUT_CACHE_VERSION 2				/*bump whenever the file format or any derived structure changes*/
+#define LAYOUT_CACHE_FILE_SUFFIX ".layoutcache"
+
+#define LAYOUT_CACHE_MISS 0
+#define LAYOUT_CACHE_HIT 1
+
+#define LAYOUT_CACHE_ERROR_NO_CACHE_DIR -40
+
+/**
+ * A uniform grid over the panel centroids. Every cell is at least as large as the biggest panel, so all the edge
+ * neighbours of a panel are within the 3x3 cells around the cell of its centroid
+ */
+struct LayoutGrid_t {
+	double originX, originY;	/*lower left corner of cell (0, 0)*/
+	double cellSize;			/*side length of a cell, in layout units*/
+	int width, height;			/*number of cells along x and y*/
+};
+
+/**
+ * Structures derived from a layout that are expensive to recompute on every start: frame slices, panel adjacency and
+ * a spatial grid. All arrays are read-only and are either owned by this object or point into a memory mapped cache
+ * file. Panel indices refer to layoutData->panels.
+ */
+struct LayoutDerivedData_t {
+	uint64_t fingerprint;			/*getLayoutFingerprint of the layout as passed to loadLayoutDerivedData*/
+	int nPanels;
+	int rotation;					/*degrees the layout was turned by before deriving, see loadLayoutDerivedData*/
+
+	/*frame slices as returned by getFrameSliceTableFromLayout*/
+	int nSlices;
+	const int* sliceOffsets;		/*nSlices + 1 entries*/
+	const int* slicePanelIds;
+
+	/*edge neighbours of panel i are neighbourIndices[neighbourOffsets[i]] ... neighbourIndices[neighbourOffsets[i+1] - 1]*/
+	const int* neighbourOffsets;	/*nPanels + 1 entries*/
+	const int* neighbourIndices;
+
+	/*the panels with their centroid in cell (cx, cy) are cellPanelIndices[cellOffsets[c]] ... [cellOffsets[c+1] - 1],
+	 *with c = cy*grid.width + cx*/
+	LayoutGrid_t grid;
+	const int* cellOffsets;			/*grid.width*grid.height + 1 entries*/
+	const int* cellPanelIndices;
+
+	LayoutDerivedData_t(const LayoutDerivedData_t&) = delete;
+	LayoutDerivedData_t();
+	~LayoutDerivedData_t();
+
+	/**
+	 * @description: unmaps the cache file or frees the owned buffers
+	 */
+	void release();
+
+	void* mapping;					/*the mapped cache file, NULL if the data was computed*/
+	size_t mappingSize;
+	std::vector<int> storage;		/*owns the arrays if the data was computed*/
+};
+
+/**
+ * @description: computes a 64 bit hash of the panelIds, shape types, centroids and orientations of the layout, in
+ * layout order. Rotating the layout or adding, removing or moving a panel changes the fingerprint
+ * @params layoutData: the layout to hash
+ * @return: the fingerprint
+ */
+uint64_t getLayoutFingerprint(LayoutData* layoutData);
+
+/**
+ * @description: computes the derived structures of the layout, without touching any cache file
+ * @params layoutData: the layout to process
+ * @params derived: filled with the derived structures. Previous contents are released
+ */
+void buildLayoutDerivedData(LayoutData* layoutData, LayoutDerivedData_t* derived);
+
+/**
+ * @description: builds the path of the cache file of a plugin, <cache dir>/<pluginName>.layoutcache. The cache dir is
+ * $XDG_CACHE_HOME if the host sets it, else $HOME/.cache, and is created if needed. The working directory of the host
+ * is never used, as it is neither known to the plugin nor guaranteed to be writable
+ * @params pluginName: name of the plugin, unique among the plugins of the host
+ * @params path: filled with the absolute path of the cache file
+ * @params pathSize: size of the path buffer
+ * @return: 0 on success, LAYOUT_CACHE_ERROR_NO_CACHE_DIR if neither variable holds an absolute path, the cache dir
+ * could not be created or the path does not fit
+ */
+int getLayoutCachePath(const char* pluginName, char* path, size_t pathSize);
+
+/**
+ * @description: maps the derived structures of the layout from a cache file. If the file does not exist, has a
+ * different version, was written for a different layout (fingerprint mismatch) or is damaged, the structures are
+ * computed and the file is rewritten for the next start. Writing is best effort, a failure to write only means the next
+ * start misses. Every section of a mapped file is checked against the size of the mapping and every offset and index
+ * against the counts of the layout before anything is used.
+ * A plugin that turns the layout before slicing it (e.g. to the direction of its widest expanse) passes the function
+ * that does it: the cache is keyed on the layout before the turn and remembers the angle, so a hit only turns the
+ * layout by that angle with rotateAuroraPanels instead of searching for it again
+ * @params layoutData: the layout to process
+ * @params cachePath: absolute path of the cache file, e.g. from getLayoutCachePath. If NULL or relative the
+ * structures are computed without any cache file
+ * @params derived: filled with the derived structures. Previous contents are released
+ * @params orientLayout: optional, called on a miss to turn the layout before the structures are derived. Returns the
+ * angle it turned the layout by, in degrees
+ * @return: LAYOUT_CACHE_HIT if the file was mapped, LAYOUT_CACHE_MISS if the structures were computed. Either way
+ * the layout has been turned by derived->rotation
+ */
+int loadLayoutDerivedData(LayoutData* layoutData, const char* cachePath, LayoutDerivedData_t* derived,
+		int (*orientLayout)(LayoutData*) = NULL);
+
+/**
+ * @description: fillFramesFromSlice for the frame slices of a LayoutDerivedData_t
+ * @params derived: the derived structures
+ * @params slice: index of the slice to write
+ * @params color: the color of every panel in the slice
+ * @params transTime: the transition time of every panel in the slice
+ * @params frames: the buffer to write to, must have room for every panel of the slice
+ * @return: the number of frames written
+ */
+int fillFramesFromDerivedSlice(const LayoutDerivedData_t* derived, int slice, const RGB_t& color, int transTime,
+		Frame_t* frames);
+
+#endif /* INC_LAYOUTCACHE_H_ */
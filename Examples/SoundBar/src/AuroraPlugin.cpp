@@ -18,12 +18,17 @@
 
 #include "AuroraPlugin.h"
 #include "LayoutProcessingUtils.h"
+#include "FrameSlicing.h"
+#include "LayoutCache.h"
+#include "LayoutUpdates.h"
 #include "ColorUtils.h"
+#include "RGB8.h"
 #include "DataManager.h"
 #include "PluginFeatures.h"
 #include "Logger.h"
 #include <stdio.h>
 #include <limits.h>
+#include <vector>
 #include "AveragingFilter.h"
 
 #ifdef __cplusplus
@@ -39,25 +44,29 @@ extern "C" {
 #endif
 
 LayoutData* layoutData;
-FrameSlice_t* frameSlices = NULL;
+LayoutDerivedData_t layoutDerived;
 int nFrameSlices = 0;
+static char layoutCachePath[1024];
 
 AveragingFilter af;
 
 static int currentAuroraRotation = 0;
+static LayoutDeltaQueue layoutDeltaQueue;
+static std::vector<LayoutDelta_t> layoutDeltas;
 
 RGB_t * colorPalette = NULL;
 int nColors = 0;
-RGB_t barColor;
+RGB8_t barColor;
 int colorIndex = 1;
-RGB_t baseColor;
+RGB8_t baseColor;
 
-int findMaxExpanse(){
+/**
+ * @description: turns the layout to the multiple of 30 degrees with the widest expanse along x
+ * @return: the angle the layout was turned by, relative to the orientation it had before the call
+ */
+int findMaxExpanse(LayoutData* layoutData){
     int maxDegrees = 0;
     
-    //grab the layout data, this function returns a pointer to a statically allocated buffer. Safe to call as many time as required.
-    //Dont delete this pointer. The memory is managed automatically.
-    layoutData = getLayoutData();
     int maxExpanse = INT_MIN;
     int d;
     //cycle through 0-360 degrees at multiples of 30 degrees
@@ -88,6 +97,22 @@ int findMaxExpanse(){
     return maxDegrees;
 }
 
+/**
+ * @description: applies the layout changes queued by pluginLayoutChanged, at the top of getPluginFrame. The deltas are
+ * in the raw coordinates of the host, so they are applied with the rotation the layout already has. Then the rotation
+ * is re-picked for the new shape of the layout and the layout is re-sliced, instead of restarting the plugin
+ */
+static void updateLayout(){
+    if (layoutDeltaQueue.take(&layoutDeltas) == 0){
+        return;
+    }
+    applyLayoutDeltas(layoutData, layoutDeltas.data(), layoutDeltas.size(), currentAuroraRotation);
+    //findMaxExpanse turns the layout relative to where it is now, so add to the rotation instead of replacing it
+    loadLayoutDerivedData(layoutData, layoutCachePath, &layoutDerived, findMaxExpanse);
+    currentAuroraRotation = (currentAuroraRotation + layoutDerived.rotation) % 360;
+    nFrameSlices = layoutDerived.nSlices;
+}
+
 /**
  * @description: Initialize the plugin. Called once, when the plugin is loaded.
  * This function can be used to enable rhythm or advanced features,
@@ -98,12 +123,21 @@ int findMaxExpanse(){
  */
 void initPlugin(){
     //do allocation here
-    //rotate the layout so that right to left have the maximum number of frame slices
-    currentAuroraRotation = findMaxExpanse();
-    printf ("max expanse found at angle %d", currentAuroraRotation);
+    //grab the layout data, this function returns a pointer to a statically allocated buffer. Safe to call as many time as required.
+    //Dont delete this pointer. The memory is managed automatically.
+    layoutData = getLayoutData();
     
-    //quantizes the layout into frameslices. See SDK documentation for more information
-    getFrameSlicesFromLayoutForTriangle(layoutData, &frameSlices, &nFrameSlices, currentAuroraRotation);
+    //rotate the layout so that right to left have the maximum number of frame slices, then quantize it into
+    //frameslices. Works for triangle, square and mixed layouts. See SDK documentation for more information
+    //The slices and the rotation are mapped from a cache file in the user's cache dir when the layout did not change
+    //since the last start, which skips the search for the maximum expanse. Without a cache dir they are simply computed
+    if (getLayoutCachePath("SoundBar", layoutCachePath, sizeof(layoutCachePath)) != 0){
+        layoutCachePath[0] = '\0';
+    }
+    loadLayoutDerivedData(layoutData, layoutCachePath, &layoutDerived, findMaxExpanse);
+    currentAuroraRotation = layoutDerived.rotation;
+    printf ("max expanse found at angle %d", currentAuroraRotation);
+    nFrameSlices = layoutDerived.nSlices;
     
     getColorPalette(&colorPalette, &nColors);
     
@@ -140,17 +174,17 @@ void initPlugin(){
  * @param sleepTime: specify interval after which this function is called again, NULL if sound visualization plugin
  */
 void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
+    updateLayout();
+    
     //	static int rotationCounter = 0;
     //	if (rotationCounter == 100){
     //		int angle = 30; //the angle to rotate the layout by
     //		rotateAuroraPanels(layoutData, &angle);
     //		currentAuroraRotation += angle; //update the currentAuroraRotation by the new angle
-    //		//call getFrameSlicesFromLayoutForTriangle to get the new frameSlices as per the new layout
-    //		//always call freeFrameSlices before calling getFrameSlicesFromLayoutForTriangle. (safe to call with NULL pointer
-    //		//getFrameSlicesFromLayoutForTriangle allocates memory, and hence is important to ensure that the memory allocated from a previous call is properly deallocated
-    //		//to ensure no memory leaks occur
-    //		freeFrameSlices(frameSlices);
-    //		getFrameSlicesFromLayoutForTriangle(layoutData, &frameSlices, &nFrameSlices, currentAuroraRotation);
+    //		//call loadLayoutDerivedData to get the new frameSlices as per the new layout
+    //		//the previous slices are released by the call
+    //		loadLayoutDerivedData(layoutData, layoutCachePath, &layoutDerived);
+    //		nFrameSlices = layoutDerived.nSlices;
     //		rotationCounter = 0;
     //		currentAuroraRotation = currentAuroraRotation % 360;
     //	}
@@ -200,7 +234,7 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
     int32_t barLength = (energy * maxBarLength) / (2*maxEnergy);
     
     
-    RGB_t netColor;
+    RGB8_t netColor;
     if (barLength > barMarker){
         barMarker = barLength;
     }
@@ -222,26 +256,12 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
         //As the frameSlices moves towards the end of the bar, the effect of the bar color decreases
         //and the base color becomes stronger and stronger.
         //In other words the bar color fades into the base color
-        netColor = (((barColor*x_t)/255) + ((baseColor*(255-x_t)))/255);
-        netColor = limitRGB(netColor, 255, 0);
-        for (unsigned int j = 0; j < frameSlices[i].panelIds.size(); j++){
-            frames[frameIndex].panelId = frameSlices[i].panelIds[j];
-            frames[frameIndex].r = netColor.R;
-            frames[frameIndex].g = netColor.G;
-            frames[frameIndex].b = netColor.B;
-            frames[frameIndex].transTime = 1;
-            frameIndex++;
-        }
+        //the packed colors saturate, so the mix needs no clamping
+        netColor = scaleRGB8(barColor, x_t) + scaleRGB8(baseColor, 255 - x_t);
+        frameIndex += fillFramesFromDerivedSlice(&layoutDerived, i, netColor, 1, &frames[frameIndex]);
     }
     for (int i = nFramesAffected; i < nFrameSlices; i++){
-        for (unsigned int j = 0; j < frameSlices[i].panelIds.size(); j++){
-            frames[frameIndex].panelId = frameSlices[i].panelIds[j];
-            frames[frameIndex].r = baseColor.R;
-            frames[frameIndex].g = baseColor.G;
-            frames[frameIndex].b = baseColor.B;
-            frames[frameIndex].transTime = 1;
-            frameIndex++;
-        }
+        frameIndex += fillFramesFromDerivedSlice(&layoutDerived, i, baseColor, 1, &frames[frameIndex]);
     }
     
     if (barMarker > 0){
@@ -256,11 +276,20 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime){
     *nFrames = frameIndex;
 }
 
+/**
+ * @description: called on the host thread when panels are added, removed or moved while the plugin runs. The frame
+ * may be reading the layout and its slices right now, so the deltas are only queued for updateLayout
+ */
+void pluginLayoutChanged(LayoutData* changedLayoutData, const LayoutDelta_t* deltas, int nDeltas){
+    layoutDeltaQueue.push(deltas, nDeltas);
+}
+
 /**
  * @description: called once when the plugin is being closed.
  * Do all deallocation for memory allocated in initplugin here
  */
 void pluginCleanup(){
 	//do deallocation here
-    freeFrameSlices(frameSlices);
+    //unmap the cached slices, or free them if they were computed
+    layoutDerived.release();
 }
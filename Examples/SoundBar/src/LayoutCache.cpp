@@ -0,0 +1,527 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * LayoutCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "LayoutCache.h"
+#include "FrameSlicing.h"
+#include "Logger.h"
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define LAYOUT_CACHE_MAGIC 0x4C43464EU		/*"NFCL" in little endian*/
+#define NEIGHBOUR_DISTANCE_TOLERANCE 1.1	/*allowed slack on the centroid distance of two edge neighbours*/
+
+/*
+ * File format: a header, followed by a table of nSections section entries, followed by the section data.
+ * Every section starts on an 8 byte boundary. The file is only meant to be read back on the machine that wrote it
+ */
+enum {
+	SECTION_COUNTS = 1,				/*int[3]: nPanels, nSlices, rotation*/
+	SECTION_SLICE_OFFSETS,
+	SECTION_SLICE_PANELIDS,
+	SECTION_NEIGHBOUR_OFFSETS,
+	SECTION_NEIGHBOUR_INDICES,
+	SECTION_GRID,					/*LayoutGrid_t*/
+	SECTION_CELL_OFFSETS,
+	SECTION_CELL_PANELS,
+	N_SECTIONS = SECTION_CELL_PANELS
+};
+
+struct CacheHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t fingerprint;
+	uint64_t fileSize;
+	uint32_t nSections;
+	uint32_t reserved;
+};
+
+struct CacheSection {
+	uint32_t tag;
+	uint32_t reserved;
+	uint64_t offset;
+	uint64_t size;
+};
+
+LayoutDerivedData_t::LayoutDerivedData_t(){
+	fingerprint = 0;
+	nPanels = 0;
+	rotation = 0;
+	nSlices = 0;
+	sliceOffsets = NULL;
+	slicePanelIds = NULL;
+	neighbourOffsets = NULL;
+	neighbourIndices = NULL;
+	memset(&grid, 0, sizeof(grid));
+	cellOffsets = NULL;
+	cellPanelIndices = NULL;
+	mapping = NULL;
+	mappingSize = 0;
+}
+
+LayoutDerivedData_t::~LayoutDerivedData_t(){
+	release();
+}
+
+void LayoutDerivedData_t::release(){
+	if (mapping){
+		munmap(mapping, mappingSize);
+		mapping = NULL;
+		mappingSize = 0;
+	}
+	std::vector<int>().swap(storage);
+	nPanels = 0;
+	rotation = 0;
+	nSlices = 0;
+	sliceOffsets = slicePanelIds = NULL;
+	neighbourOffsets = neighbourIndices = NULL;
+	cellOffsets = cellPanelIndices = NULL;
+}
+
+static inline uint64_t fnv1a(uint64_t hash, int64_t value){
+	for (int i = 0; i < 8; i++){
+		hash ^= (uint64_t)((value >> (8*i)) & 0xFF);
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+uint64_t getLayoutFingerprint(LayoutData* layoutData){
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	hash = fnv1a(hash, layoutData->nPanels);
+	hash = fnv1a(hash, layoutData->globalOrientation);
+	for (int i = 0; i < layoutData->nPanels; i++){
+		Shape* shape = layoutData->panels[i].shape;
+		hash = fnv1a(hash, layoutData->panels[i].panelId);
+		hash = fnv1a(hash, shape->shapeType);
+		hash = fnv1a(hash, shape->getOrientation());
+		//centroids are hashed to a hundredth of a layout unit, so float noise from rotations does not matter
+		hash = fnv1a(hash, llround(shape->getCentroid().x*100));
+		hash = fnv1a(hash, llround(shape->getCentroid().y*100));
+	}
+	return hash;
+}
+
+/**
+ * @description: distance from the centroid of the shape to the middle of its first edge
+ */
+static double getInradius(Shape* shape){
+	if (shape->nVertices < 3){
+		return 0;
+	}
+	Point mid((shape->vertices[0].x + shape->vertices[1].x)/2, (shape->vertices[0].y + shape->vertices[1].y)/2);
+	return Point::distance(mid, shape->getCentroid());
+}
+
+static void buildGrid(LayoutData* layoutData, LayoutGrid_t* grid, std::vector<int>& cellOffsets, std::vector<int>& cellPanels){
+	int n = layoutData->nPanels;
+	double minX = 0, minY = 0, maxX = 0, maxY = 0, cellSize = 0;
+	for (int i = 0; i < n; i++){
+		Shape* shape = layoutData->panels[i].shape;
+		const Point& c = shape->getCentroid();
+		if (i == 0){
+			minX = maxX = c.x;
+			minY = maxY = c.y;
+		}
+		minX = (c.x < minX) ? c.x : minX;
+		maxX = (c.x > maxX) ? c.x : maxX;
+		minY = (c.y < minY) ? c.y : minY;
+		maxY = (c.y > maxY) ? c.y : maxY;
+		if (shape->nVertices > 0){
+			double diameter = 2*Point::distance(shape->vertices[0], c);
+			if (diameter > cellSize){
+				cellSize = diameter;
+			}
+		}
+	}
+	if (cellSize == 0){
+		cellSize = Shape::sideLength;
+	}
+	grid->originX = minX;
+	grid->originY = minY;
+	grid->cellSize = cellSize;
+	grid->width = (n == 0) ? 0 : (int)((maxX - minX)/cellSize) + 1;
+	grid->height = (n == 0) ? 0 : (int)((maxY - minY)/cellSize) + 1;
+
+	int nCells = grid->width*grid->height;
+	std::vector<int> cellOf(n);
+	cellOffsets.assign(nCells + 1, 0);
+	for (int i = 0; i < n; i++){
+		const Point& c = layoutData->panels[i].shape->getCentroid();
+		int cx = (int)((c.x - minX)/cellSize);
+		int cy = (int)((c.y - minY)/cellSize);
+		cellOf[i] = cy*grid->width + cx;
+		cellOffsets[cellOf[i] + 1]++;
+	}
+	for (int c = 1; c <= nCells; c++){
+		cellOffsets[c] += cellOffsets[c - 1];
+	}
+	cellPanels.resize(n);
+	std::vector<int> cursor(cellOffsets.begin(), cellOffsets.end() - 1);
+	for (int i = 0; i < n; i++){
+		cellPanels[cursor[cellOf[i]]++] = i;
+	}
+}
+
+static void buildAdjacency(LayoutData* layoutData, const LayoutGrid_t& grid, const std::vector<int>& cellOffsets,
+		const std::vector<int>& cellPanels, std::vector<int>& neighbourOffsets, std::vector<int>& neighbourIndices){
+	int n = layoutData->nPanels;
+	std::vector<double> inradius(n);
+	for (int i = 0; i < n; i++){
+		inradius[i] = getInradius(layoutData->panels[i].shape);
+	}
+	neighbourOffsets.assign(1, 0);
+	neighbourIndices.clear();
+	for (int i = 0; i < n; i++){
+		const Point& ci = layoutData->panels[i].shape->getCentroid();
+		int cx = (int)((ci.x - grid.originX)/grid.cellSize);
+		int cy = (int)((ci.y - grid.originY)/grid.cellSize);
+		for (int y = cy - 1; y <= cy + 1; y++){
+			for (int x = cx - 1; x <= cx + 1; x++){
+				if (x < 0 || y < 0 || x >= grid.width || y >= grid.height){
+					continue;
+				}
+				int c = y*grid.width + x;
+				for (int k = cellOffsets[c]; k < cellOffsets[c + 1]; k++){
+					int j = cellPanels[k];
+					if (j == i || inradius[i] == 0 || inradius[j] == 0){
+						continue;
+					}
+					double d = Point::distance(ci, layoutData->panels[j].shape->getCentroid());
+					if (d <= (inradius[i] + inradius[j])*NEIGHBOUR_DISTANCE_TOLERANCE){
+						neighbourIndices.push_back(j);
+					}
+				}
+			}
+		}
+		neighbourOffsets.push_back(neighbourIndices.size());
+	}
+}
+
+/**
+ * @description: appends a block of ints to the storage and returns its offset in ints
+ */
+static size_t appendStorage(std::vector<int>& storage, const int* data, size_t count){
+	size_t offset = storage.size();
+	storage.insert(storage.end(), data, data + count);
+	return offset;
+}
+
+void buildLayoutDerivedData(LayoutData* layoutData, LayoutDerivedData_t* derived){
+	derived->release();
+
+	FrameSliceTable_t slices;
+	getFrameSliceTableFromLayout(layoutData, &slices);
+	std::vector<int> cellOffsets, cellPanels, neighbourOffsets, neighbourIndices;
+	buildGrid(layoutData, &derived->grid, cellOffsets, cellPanels);
+	buildAdjacency(layoutData, derived->grid, cellOffsets, cellPanels, neighbourOffsets, neighbourIndices);
+
+	//concatenate everything into one buffer first, and only take pointers once it stops growing
+	std::vector<int>& storage = derived->storage;
+	size_t sliceOffsetsAt = storage.size();
+	if (slices.nSlices > 0){
+		appendStorage(storage, slices.offsets, slices.nSlices + 1);
+	}
+	else {
+		storage.push_back(0);
+	}
+	size_t slicePanelIdsAt = appendStorage(storage, slices.panelIds, slices.nPanelIds);
+	size_t neighbourOffsetsAt = appendStorage(storage, neighbourOffsets.data(), neighbourOffsets.size());
+	size_t neighbourIndicesAt = appendStorage(storage, neighbourIndices.data(), neighbourIndices.size());
+	size_t cellOffsetsAt = appendStorage(storage, cellOffsets.data(), cellOffsets.size());
+	size_t cellPanelsAt = appendStorage(storage, cellPanels.data(), cellPanels.size());
+
+	derived->fingerprint = getLayoutFingerprint(layoutData);
+	derived->nPanels = layoutData->nPanels;
+	derived->nSlices = slices.nSlices;
+	derived->sliceOffsets = storage.data() + sliceOffsetsAt;
+	derived->slicePanelIds = storage.data() + slicePanelIdsAt;
+	derived->neighbourOffsets = storage.data() + neighbourOffsetsAt;
+	derived->neighbourIndices = storage.data() + neighbourIndicesAt;
+	derived->cellOffsets = storage.data() + cellOffsetsAt;
+	derived->cellPanelIndices = storage.data() + cellPanelsAt;
+}
+
+static inline uint64_t align8(uint64_t offset){
+	return (offset + 7) & ~(uint64_t)7;
+}
+
+static bool writeCacheFile(const char* cachePath, const LayoutDerivedData_t* derived){
+	int nCells = derived->grid.width*derived->grid.height;
+	int counts[3] = {derived->nPanels, derived->nSlices, derived->rotation};
+	const void* data[N_SECTIONS] = {
+		counts,
+		derived->sliceOffsets,
+		derived->slicePanelIds,
+		derived->neighbourOffsets,
+		derived->neighbourIndices,
+		&derived->grid,
+		derived->cellOffsets,
+		derived->cellPanelIndices
+	};
+	uint64_t sizes[N_SECTIONS] = {
+		sizeof(counts),
+		(derived->nSlices + 1)*sizeof(int),
+		derived->sliceOffsets[derived->nSlices]*sizeof(int),
+		(derived->nPanels + 1)*sizeof(int),
+		derived->neighbourOffsets[derived->nPanels]*sizeof(int),
+		sizeof(LayoutGrid_t),
+		(nCells + 1)*sizeof(int),
+		derived->nPanels*sizeof(int)
+	};
+
+	CacheSection sections[N_SECTIONS];
+	uint64_t offset = align8(sizeof(CacheHeader) + sizeof(sections));
+	for (int i = 0; i < N_SECTIONS; i++){
+		sections[i].tag = i + 1;
+		sections[i].reserved = 0;
+		sections[i].offset = offset;
+		sections[i].size = sizes[i];
+		offset = align8(offset + sizes[i]);
+	}
+	CacheHeader header;
+	header.magic = LAYOUT_CACHE_MAGIC;
+	header.version = LAYOUT_CACHE_VERSION;
+	header.fingerprint = derived->fingerprint;
+	header.fileSize = offset;
+	header.nSections = N_SECTIONS;
+	header.reserved = 0;
+
+	std::vector<char> file(offset, 0);
+	memcpy(&file[0], &header, sizeof(header));
+	memcpy(&file[sizeof(header)], sections, sizeof(sections));
+	for (int i = 0; i < N_SECTIONS; i++){
+		if (sizes[i] > 0){
+			memcpy(&file[sections[i].offset], data[i], sizes[i]);
+		}
+	}
+
+	//write to a temporary file and rename it, so a reader never maps a half written cache
+	char tmpPath[1024];
+	snprintf(tmpPath, sizeof(tmpPath), "%s.%d.tmp", cachePath, (int)getpid());
+	FILE* fp = fopen(tmpPath, "wb");
+	if (!fp){
+		return false;
+	}
+	bool ok = fwrite(&file[0], 1, file.size(), fp) == file.size();
+	ok = (fclose(fp) == 0) && ok;
+	if (!ok || rename(tmpPath, cachePath) != 0){
+		unlink(tmpPath);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @description: returns the data of the section with the given tag, or NULL if there is none, if it does not have the
+ * expected size or if it does not lie entirely inside the mapping
+ */
+static const void* getSection(const char* base, size_t mappingSize, const CacheHeader* header, uint32_t tag,
+		uint64_t expectedSize){
+	const CacheSection* sections = (const CacheSection*)(base + sizeof(CacheHeader));
+	for (uint32_t i = 0; i < header->nSections; i++){
+		if (sections[i].tag != tag){
+			continue;
+		}
+		//written so that no sum can wrap around, whatever the file holds
+		if (sections[i].size != expectedSize || (sections[i].offset & 7) != 0 || sections[i].offset > mappingSize ||
+				sections[i].size > mappingSize - sections[i].offset){
+			return NULL;
+		}
+		return base + sections[i].offset;
+	}
+	return NULL;
+}
+
+/**
+ * @description: checks that offsets has n + 1 entries starting at 0 that never decrease
+ */
+static bool isValidOffsets(const int* offsets, int n){
+	if (offsets[0] != 0){
+		return false;
+	}
+	for (int i = 0; i < n; i++){
+		if (offsets[i + 1] < offsets[i]){
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @description: checks that all count indices are in [0, limit)
+ */
+static bool isValidIndices(const int* indices, int count, int limit){
+	for (int i = 0; i < count; i++){
+		if (indices[i] < 0 || indices[i] >= limit){
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool mapCacheFile(const char* cachePath, uint64_t fingerprint, int nLayoutPanels, LayoutDerivedData_t* derived){
+	int fd = open(cachePath, O_RDONLY);
+	if (fd < 0){
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CacheHeader)){
+		close(fd);
+		return false;
+	}
+	size_t size = st.st_size;
+	void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED){
+		return false;
+	}
+
+	//every count read from the file is checked before it sizes anything, and sizes are computed in 64 bits
+	const char* base = (const char*)mapping;
+	const CacheHeader* header = (const CacheHeader*)base;
+	const int* counts = NULL;
+	const LayoutGrid_t* grid = NULL;
+	uint64_t nCells = 0;
+	bool ok = header->magic == LAYOUT_CACHE_MAGIC && header->version == LAYOUT_CACHE_VERSION &&
+			header->fingerprint == fingerprint && header->fileSize == size &&
+			header->nSections <= (size - sizeof(CacheHeader))/sizeof(CacheSection);
+	if (ok){
+		counts = (const int*)getSection(base, size, header, SECTION_COUNTS, 3*sizeof(int));
+		grid = (const LayoutGrid_t*)getSection(base, size, header, SECTION_GRID, sizeof(LayoutGrid_t));
+		ok = counts && grid && counts[0] == nLayoutPanels && counts[1] >= 0 && grid->width >= 0 &&
+				grid->height >= 0 && grid->cellSize > 0;
+	}
+	if (ok){
+		nCells = (uint64_t)grid->width*(uint64_t)grid->height;
+		ok = nCells < size/sizeof(int);
+	}
+	if (ok){
+		int nPanels = counts[0], nSlices = counts[1];
+		derived->sliceOffsets = (const int*)getSection(base, size, header, SECTION_SLICE_OFFSETS,
+				((uint64_t)nSlices + 1)*sizeof(int));
+		derived->neighbourOffsets = (const int*)getSection(base, size, header, SECTION_NEIGHBOUR_OFFSETS,
+				((uint64_t)nPanels + 1)*sizeof(int));
+		derived->cellOffsets = (const int*)getSection(base, size, header, SECTION_CELL_OFFSETS,
+				(nCells + 1)*sizeof(int));
+		ok = derived->sliceOffsets && derived->neighbourOffsets && derived->cellOffsets &&
+				isValidOffsets(derived->sliceOffsets, nSlices) && derived->sliceOffsets[nSlices] == nPanels &&
+				isValidOffsets(derived->neighbourOffsets, nPanels) &&
+				isValidOffsets(derived->cellOffsets, (int)nCells) && derived->cellOffsets[nCells] == nPanels;
+		if (ok){
+			int nSlicePanelIds = derived->sliceOffsets[nSlices];
+			int nNeighbours = derived->neighbourOffsets[nPanels];
+			derived->slicePanelIds = (const int*)getSection(base, size, header, SECTION_SLICE_PANELIDS,
+					(uint64_t)nSlicePanelIds*sizeof(int));
+			derived->neighbourIndices = (const int*)getSection(base, size, header, SECTION_NEIGHBOUR_INDICES,
+					(uint64_t)nNeighbours*sizeof(int));
+			derived->cellPanelIndices = (const int*)getSection(base, size, header, SECTION_CELL_PANELS,
+					(uint64_t)nPanels*sizeof(int));
+			ok = derived->slicePanelIds && derived->neighbourIndices && derived->cellPanelIndices &&
+					isValidIndices(derived->neighbourIndices, nNeighbours, nPanels) &&
+					isValidIndices(derived->cellPanelIndices, nPanels, nPanels);
+		}
+		if (ok){
+			derived->nPanels = nPanels;
+			derived->nSlices = nSlices;
+			derived->rotation = counts[2];
+			derived->grid = *grid;
+		}
+	}
+	if (!ok){
+		munmap(mapping, size);
+		derived->release();
+		return false;
+	}
+	derived->fingerprint = fingerprint;
+	derived->mapping = mapping;
+	derived->mappingSize = size;
+	return true;
+}
+
+int getLayoutCachePath(const char* pluginName, char* path, size_t pathSize){
+	char dir[1024];
+	const char* xdg = getenv("XDG_CACHE_HOME");
+	const char* home = getenv("HOME");
+	int n;
+	if (xdg && xdg[0] == '/'){
+		n = snprintf(dir, sizeof(dir), "%s", xdg);
+	}
+	else if (home && home[0] == '/'){
+		n = snprintf(dir, sizeof(dir), "%s/.cache", home);
+	}
+	else {
+		return LAYOUT_CACHE_ERROR_NO_CACHE_DIR;
+	}
+	if (n < 0 || (size_t)n >= sizeof(dir) || (mkdir(dir, 0700) != 0 && errno != EEXIST)){
+		return LAYOUT_CACHE_ERROR_NO_CACHE_DIR;
+	}
+	n = snprintf(path, pathSize, "%s/%s%s", dir, pluginName, LAYOUT_CACHE_FILE_SUFFIX);
+	if (n < 0 || (size_t)n >= pathSize){
+		return LAYOUT_CACHE_ERROR_NO_CACHE_DIR;
+	}
+	return 0;
+}
+
+int loadLayoutDerivedData(LayoutData* layoutData, const char* cachePath, LayoutDerivedData_t* derived,
+		int (*orientLayout)(LayoutData*)){
+	derived->release();
+	bool isCached = cachePath && cachePath[0] == '/';
+	uint64_t fingerprint = getLayoutFingerprint(layoutData);
+	if (isCached && mapCacheFile(cachePath, fingerprint, layoutData->nPanels, derived)){
+		PRINTLOG("Layout cache hit: %s\n", cachePath);
+		if (derived->rotation != 0){
+			int angle = derived->rotation;
+			rotateAuroraPanels(layoutData, &angle);
+		}
+		return LAYOUT_CACHE_HIT;
+	}
+	int rotation = orientLayout ? orientLayout(layoutData) : 0;
+	buildLayoutDerivedData(layoutData, derived);
+	derived->fingerprint = fingerprint;
+	derived->rotation = rotation;
+	if (isCached && !writeCacheFile(cachePath, derived)){
+		PRINTLOG("Could not write layout cache: %s\n", cachePath);
+	}
+	return LAYOUT_CACHE_MISS;
+}
+
+int fillFramesFromDerivedSlice(const LayoutDerivedData_t* derived, int slice, const RGB_t& color, int transTime,
+		Frame_t* frames){
+	const int* panelIds = derived->slicePanelIds + derived->sliceOffsets[slice];
+	int n = derived->sliceOffsets[slice + 1] - derived->sliceOffsets[slice];
+	int r = color.R, g = color.G, b = color.B;
+	for (int i = 0; i < n; i++){
+		frames[i].panelId = panelIds[i];
+		frames[i].r = r;
+		frames[i].g = g;
+		frames[i].b = b;
+		frames[i].transTime = transTime;
+	}
+	return n;
+}
@@ -0,0 +1,44 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+CPP_SRCS += \
+../src/main.cpp \
+../src/Decimator.cpp \
+../src/RealFft.cpp \
+../src/MelFilterbank.cpp \
+../src/FeatureEngine.cpp \
+../src/UdpLink.cpp \
+../src/AudioCapture.cpp \
+../src/BlockRing.cpp 
+
+OBJS += \
+./src/main.o \
+./src/Decimator.o \
+./src/RealFft.o \
+./src/MelFilterbank.o \
+./src/FeatureEngine.o \
+./src/UdpLink.o \
+./src/AudioCapture.o \
+./src/BlockRing.o 
+
+CPP_DEPS += \
+./src/main.d \
+./src/Decimator.d \
+./src/RealFft.d \
+./src/MelFilterbank.d \
+./src/FeatureEngine.d \
+./src/UdpLink.d \
+./src/AudioCapture.d \
+./src/BlockRing.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+src/%.o: ../src/%.cpp
+	@echo 'Building file: $<'
+	@echo 'Invoking: G++ Compiler'
+	g++ -I../inc -I/usr/local/include -O3 -Wall -c -fmessage-length=0 -std=c++11 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
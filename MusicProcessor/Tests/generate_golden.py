@@ -0,0 +1,216 @@
+# Copyright 2017 Nanoleaf Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Writes golden/feature_vectors.txt, the features music_processor.py computes for a few test signals, which
+# FeatureEngineCheck compares the native processor with.
+#
+# With librosa installed the features are computed by the steps of process_music_data. Without it, by a numpy port of
+# the parts of librosa and resampy the script uses (resampy's kaiser_fast filter, librosa.stft and
+# librosa.filters.mel), which follows their arithmetic including the float32 accumulations. The fixture records which
+# one produced it.
+#
+# The committed fixture comes from the numpy port: librosa could not be installed where it was generated (pip had no
+# network access). To regenerate it with librosa, install the requirements of music_processor.py and pass --librosa,
+# which fails instead of falling back to the port, then run make check and commit the fixture if it passes:
+#
+#   pip install -r ../../requirements.txt
+#   python generate_golden.py --librosa
+
+import numpy as np
+import os
+import sys
+
+N_SAMPLES = 2**11   # input_samples of the script
+N_FFT = 512
+N_MEL = 26
+
+# (is_fft, n_bins, is_energy, is_mel) as in the handshake of a plugin
+REQUESTS = [(1, 16, 1, 0), (1, 64, 1, 0), (1, 256, 0, 0), (0, 26, 1, 1)]
+
+
+def make_signals():
+    t44 = np.arange(N_SAMPLES) / 44100.0
+    t48 = np.arange(N_SAMPLES) / 48000.0
+    rng = np.random.RandomState(1)
+    clicks = np.zeros(N_SAMPLES)
+    clicks[::256] = 0.9
+    clicks[1::256] = -0.45
+    signals = [
+        ("sine440", 44100, 0.5 * np.sin(2 * np.pi * 440 * t44)),
+        ("quiet_sine1000", 44100, 0.01 * np.sin(2 * np.pi * 1000 * t44)),
+        ("tones", 48000, 0.3 * np.sin(2 * np.pi * 200 * t48) + 0.2 * np.sin(2 * np.pi * 1500 * t48) +
+         0.1 * np.sin(2 * np.pi * 4000 * t48)),
+        ("chirp", 44100, 0.4 * np.sin(2 * np.pi * (100 * t44 + (8000 - 100) / (2 * t44[-1]) * t44 ** 2))),
+        ("noise", 44100, np.clip(0.1 * rng.randn(N_SAMPLES), -1, 1)),
+        ("clicks", 48000, clicks),
+        ("silence", 44100, np.zeros(N_SAMPLES)),
+    ]
+    # samples are stored as 16 bit integers, the input is exactly value/32768 on both sides
+    return [(name, rate, np.round(x * 32767).astype(np.int16)) for name, rate, x in signals]
+
+
+def get_output_fft_bins(fft_mag, n_out):
+    # as in music_processor.py
+    n_in = len(fft_mag)
+    step_size = int(n_in/n_out)
+    fft_out = np.zeros(n_out)
+    n_filled = 0
+    i = 0
+    while n_filled < n_out:
+        acc = np.sum(fft_mag[i:min(i+step_size, n_in)])
+        i += step_size
+        if acc > 255:
+            acc = 255
+        fft_out[n_filled] = acc
+        n_filled += 1
+    return fft_out[0:n_out]
+
+
+class LibrosaSteps:
+    name = "librosa"
+
+    def __init__(self):
+        import librosa
+        self.librosa = librosa
+        self.name = "librosa " + librosa.__version__
+
+    def resample(self, x, sample_rate):
+        return self.librosa.resample(x, orig_sr=sample_rate, target_sr=sample_rate / 4, res_type='kaiser_fast')
+
+    def stft(self, x):
+        return self.librosa.stft(x, n_fft=N_FFT, hop_length=N_FFT, center=False)
+
+    def mel_basis(self, sample_rate):
+        return self.librosa.filters.mel(sr=sample_rate, n_fft=N_FFT, n_mels=N_MEL)
+
+
+class NumpySteps:
+    name = "numpy port of resampy kaiser_fast, librosa.stft and librosa.filters.mel"
+
+    def __init__(self):
+        # resampy's kaiser_fast table: 16 zero crossings, 2**9 entries per crossing, Kaiser window, rolloff 0.85
+        num_zeros, precision, beta, rolloff = 16, 512, 8.555504641634386, 0.85
+        n = num_zeros * precision
+        sinc_win = rolloff * np.sinc(rolloff * np.linspace(0, num_zeros, num=n + 1, endpoint=True))
+        taper = np.kaiser(2 * n + 1, beta)[n:]
+        self.interp_win = taper * sinc_win
+        self.precision = precision
+
+    def resample(self, x, sample_rate):
+        # resampy.resample at a ratio of 1/4: every output sample falls on an input sample, the filter is read at
+        # whole multiples of the table step. Accumulates into float32 in resampy's order, the center and left wing
+        # first, then the right wing
+        ratio = 0.25
+        win = self.interp_win * ratio
+        step = int(ratio * self.precision)
+        n_out = int(len(x) * ratio)
+        n = np.arange(n_out) * 4
+        y = np.zeros(n_out, dtype=x.dtype)
+        for i in range(min(n_out * 4, len(win) // step)):
+            valid = n - i >= 0
+            y[valid] = (y[valid] + win[i * step] * x[n[valid] - i]).astype(x.dtype)
+        for k in range((len(win) - step) // step):
+            valid = n + k + 1 < len(x)
+            y[valid] = (y[valid] + win[step + k * step] * x[n[valid] + k + 1]).astype(x.dtype)
+        return y
+
+    def stft(self, x):
+        window = 0.5 - 0.5 * np.cos(2 * np.pi * np.arange(N_FFT) / N_FFT)   # periodic Hann
+        frames = x[:N_FFT].reshape(N_FFT, 1)
+        return np.fft.rfft(window.reshape(N_FFT, 1) * frames, axis=0).astype(np.complex64)
+
+    def mel_basis(self, sample_rate):
+        # Slaney's mel scale and area normalization, librosa's defaults
+        def hz_to_mel(f):
+            f = np.asanyarray(f, dtype=np.float64)
+            mels = f / (200.0 / 3)
+            log_t = f >= 1000.0
+            mels[log_t] = 15.0 + np.log(f[log_t] / 1000.0) / (np.log(6.4) / 27.0)
+            return mels
+
+        def mel_to_hz(m):
+            m = np.asanyarray(m, dtype=np.float64)
+            freqs = m * (200.0 / 3)
+            log_t = m >= 15.0
+            freqs[log_t] = 1000.0 * np.exp(np.log(6.4) / 27.0 * (m[log_t] - 15.0))
+            return freqs
+
+        fftfreqs = np.linspace(0, sample_rate / 2.0, 1 + N_FFT // 2)
+        mel_f = mel_to_hz(np.linspace(hz_to_mel(np.array([0.0]))[0], hz_to_mel(np.array([sample_rate / 2.0]))[0],
+                                      N_MEL + 2))
+        fdiff = np.diff(mel_f)
+        ramps = np.subtract.outer(mel_f, fftfreqs)
+        weights = np.zeros((N_MEL, 1 + N_FFT // 2), dtype=np.float32)
+        for i in range(N_MEL):
+            lower = -ramps[i] / fdiff[i]
+            upper = ramps[i + 2] / fdiff[i + 1]
+            weights[i] = np.maximum(0, np.minimum(lower, upper))
+        enorm = 2.0 / (mel_f[2:N_MEL + 2] - mel_f[:N_MEL])
+        weights *= enorm[:, np.newaxis]
+        return weights
+
+
+def process_music_data(steps, data_np, sample_rate, is_fft, is_mel, n_out_bins, is_energy):
+    # the steps of process_music_data in music_processor.py
+    if is_energy:
+        energy = np.abs(data_np) ** 2
+        energy = energy.sum()
+        energy *= 2**5
+        energy_output = int(energy.astype(np.uint16))
+    else:
+        energy_output = -1
+
+    data_np = steps.resample(data_np, sample_rate)
+    fft_data = steps.stft(data_np)
+    if is_fft:
+        fft_data_mag = np.abs(fft_data[0:N_FFT // 2]) ** 2
+        fft_data_mag *= 2**3
+        fft_output = get_output_fft_bins(fft_data_mag, n_out_bins)
+    else:
+        fft_data_mag = np.abs(fft_data)**2
+        fft_data_mag *= 2**2
+        mel_data = steps.mel_basis(sample_rate / 4).dot(fft_data_mag)
+        fft_output = get_output_fft_bins(mel_data, n_out_bins)
+    return fft_output.astype(np.uint8), energy_output
+
+
+def main():
+    try:
+        steps = LibrosaSteps()
+    except ImportError:
+        if "--librosa" in sys.argv[1:]:
+            print("librosa is not installed, see the requirements of music_processor.py")
+            return 1
+        steps = NumpySteps()
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "golden", "feature_vectors.txt")
+    with open(path, "w") as out:
+        out.write("# features of music_processor.py for %d sample blocks, written by generate_golden.py\n" % N_SAMPLES)
+        out.write("# computed with %s, numpy %s\n" % (steps.name, np.__version__))
+        out.write("# signal <name> <sample rate> <n samples>, then the samples times 32768\n")
+        out.write("# features <is_fft> <n_bins> <is_energy> <is_mel>, then the bins and the energy (-1 if disabled)\n")
+        for name, sample_rate, samples in make_signals():
+            out.write("signal %s %d %d\n" % (name, sample_rate, len(samples)))
+            for i in range(0, len(samples), 16):
+                out.write(" ".join(str(s) for s in samples[i:i + 16]) + "\n")
+            data_np = (samples / 32768.0).astype(np.float32)
+            for is_fft, n_bins, is_energy, is_mel in REQUESTS:
+                bins, energy = process_music_data(steps, data_np, sample_rate, is_fft, is_mel, n_bins, is_energy)
+                out.write("features %d %d %d %d\n" % (is_fft, n_bins, is_energy, is_mel))
+                out.write(" ".join(str(b) for b in bins) + " %d\n" % energy)
+    print("wrote %s with %s" % (path, steps.name))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
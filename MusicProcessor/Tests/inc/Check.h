@@ -0,0 +1,64 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * Check.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TESTS_INC_CHECK_H_
+#define TESTS_INC_CHECK_H_
+
+#include <stdio.h>
+#include <chrono>
+
+/*
+ * Minimal helpers for the checks and benchmarks under Tests. A check is a program that prints every failed CHECK and
+ * returns CHECK_RESULT(), non zero if anything failed. A benchmark prints its timings and always succeeds
+ */
+
+static int checkFailures __attribute__((unused)) = 0;
+
+#define CHECK(condition, format, ...) \
+	do { \
+		if (!(condition)){ \
+			checkFailures++; \
+			printf("%s:%d: CHECK(%s) failed: " format "\n", __FILE__, __LINE__, #condition, ##__VA_ARGS__); \
+		} \
+	} while (0)
+
+#define CHECK_RESULT() \
+	(printf("%s: %s\n", __FILE__, checkFailures ? "FAILED" : "passed"), checkFailures ? 1 : 0)
+
+/**
+ * @description: runs a function repeatedly and returns the mean time per call, in microseconds. The function is run
+ * once before timing, to warm up caches and allocations
+ * @params f: the function to time
+ * @params nRuns: number of timed calls
+ */
+template <typename F>
+double timePerCall(F f, int nRuns){
+	f();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < nRuns; i++){
+		f();
+	}
+	std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count()/nRuns;
+}
+
+#endif /* TESTS_INC_CHECK_H_ */
@@ -0,0 +1,177 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * BlockRingCheck.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "Check.h"
+#include "BlockRing.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*
+ * The ring hands the blocks of the audio callback to the analysis in the order they were pushed. The indices keep
+ * counting past the capacity, so blocks must stay in order when they wrap around the slots. A full ring drops and
+ * counts the incoming block and keeps the queued ones, and a block longer than blockSize is cut to blockSize without
+ * spilling into the next slot. Finally a producer thread pushes blocks of every size while the main thread consumes
+ * them, every sample must arrive once and in order. The producer waits while the ring is full, so nothing may be
+ * dropped. make tsan runs this check with the thread sanitizer
+ */
+
+#define RING_BLOCKS 4
+#define RING_BLOCK_SIZE 8
+#define THREAD_BLOCKS 20000
+
+//fills a block with consecutive values from first
+static std::vector<float> makeBlock(int first, int size){
+	std::vector<float> block(size);
+	for (int i = 0; i < size; i++){
+		block[i] = first + i;
+	}
+	return block;
+}
+
+//whether the oldest block is the size samples from first, without releasing it
+static bool isFront(const BlockRing& ring, int first, int size){
+	int frontSize = -1;
+	const float* block = ring.front(&frontSize);
+	if (!block || frontSize != size){
+		return false;
+	}
+	for (int i = 0; i < size; i++){
+		if (block[i] != first + i){
+			return false;
+		}
+	}
+	return true;
+}
+
+static void checkWraparound(){
+	BlockRing ring(RING_BLOCKS, RING_BLOCK_SIZE);
+	int size;
+	CHECK(ring.front(&size) == NULL && ring.getNQueued() == 0, "a new ring is not empty");
+	//3 blocks per round over 4 slots, so every round starts in another slot and the indices wrap many times
+	int nPushed = 0, nPopped = 0;
+	for (int round = 0; round < 10; round++){
+		for (int i = 0; i < 3; i++, nPushed++){
+			std::vector<float> block = makeBlock(100*nPushed, 1 + nPushed%RING_BLOCK_SIZE);
+			CHECK(ring.push(block.data(), block.size()), "round %d: block %d dropped", round, nPushed);
+		}
+		CHECK(ring.getNQueued() == 3, "round %d: %d blocks queued, expected 3", round, ring.getNQueued());
+		for (int i = 0; i < 3; i++, nPopped++){
+			CHECK(isFront(ring, 100*nPopped, 1 + nPopped%RING_BLOCK_SIZE), "round %d: block %d out of order", round,
+					nPopped);
+			ring.release();
+		}
+		CHECK(ring.front(&size) == NULL, "round %d: the ring is not empty after releasing everything", round);
+	}
+	CHECK(ring.getNOverruns() == 0, "%u overruns without the ring ever being full", ring.getNOverruns());
+}
+
+static void checkOverruns(){
+	//3 blocks are rounded up to 4
+	BlockRing ring(3, RING_BLOCK_SIZE);
+	for (int i = 0; i < RING_BLOCKS; i++){
+		std::vector<float> block = makeBlock(100*i, RING_BLOCK_SIZE);
+		CHECK(ring.push(block.data(), block.size()), "block %d of %d dropped", i, RING_BLOCKS);
+	}
+	for (int i = 0; i < 5; i++){
+		std::vector<float> block = makeBlock(1000, RING_BLOCK_SIZE);
+		CHECK(!ring.push(block.data(), block.size()), "push %d into a full ring succeeded", i);
+		CHECK(ring.getNOverruns() == (unsigned)i + 1, "%u overruns after %d dropped blocks", ring.getNOverruns(),
+				i + 1);
+	}
+	CHECK(ring.getNQueued() == RING_BLOCKS, "%d blocks queued in a full ring", ring.getNQueued());
+	CHECK(isFront(ring, 0, RING_BLOCK_SIZE), "an overrun replaced the oldest block");
+
+	//a released slot takes the next block, after the ones that were kept
+	ring.release();
+	std::vector<float> block = makeBlock(2000, RING_BLOCK_SIZE);
+	CHECK(ring.push(block.data(), block.size()), "push after a release dropped");
+	for (int i = 1; i < RING_BLOCKS; i++){
+		CHECK(isFront(ring, 100*i, RING_BLOCK_SIZE), "kept block %d lost after the overruns", i);
+		ring.release();
+	}
+	CHECK(isFront(ring, 2000, RING_BLOCK_SIZE), "the block pushed after the release is not last");
+	CHECK(ring.getNOverruns() == 5, "%u overruns, expected 5", ring.getNOverruns());
+}
+
+static void checkTruncation(){
+	BlockRing ring(RING_BLOCKS, RING_BLOCK_SIZE);
+	std::vector<float> longBlock = makeBlock(0, 3*RING_BLOCK_SIZE);
+	std::vector<float> nextBlock = makeBlock(500, RING_BLOCK_SIZE);
+	CHECK(ring.push(longBlock.data(), longBlock.size()), "long block dropped");
+	CHECK(ring.push(nextBlock.data(), nextBlock.size()), "block after the long one dropped");
+	CHECK(isFront(ring, 0, RING_BLOCK_SIZE), "the long block is not its first %d samples", RING_BLOCK_SIZE);
+	ring.release();
+	CHECK(isFront(ring, 500, RING_BLOCK_SIZE), "the long block spilled into the next slot");
+	ring.release();
+	CHECK(ring.getNOverruns() == 0, "truncation counted as an overrun");
+}
+
+static void checkThreads(){
+	BlockRing ring(RING_BLOCKS, RING_BLOCK_SIZE);
+	std::atomic<int> nFullPushes(0);
+	std::thread producer([&](){
+		int next = 0;
+		for (int i = 0; i < THREAD_BLOCKS; i++){
+			std::vector<float> block = makeBlock(next, 1 + i%RING_BLOCK_SIZE);
+			while (ring.getNQueued() == RING_BLOCKS){
+				std::this_thread::yield();
+			}
+			if (!ring.push(block.data(), block.size())){
+				nFullPushes++;
+			}
+			next += block.size();
+		}
+	});
+
+	int expected = 0, nBlocks = 0, nOutOfOrder = 0;
+	while (nBlocks < THREAD_BLOCKS){
+		int size;
+		const float* block = ring.front(&size);
+		if (!block){
+			std::this_thread::yield();
+			continue;
+		}
+		if (size != 1 + nBlocks%RING_BLOCK_SIZE){
+			nOutOfOrder++;
+		}
+		for (int i = 0; i < size; i++, expected++){
+			nOutOfOrder += block[i] != expected;
+		}
+		ring.release();
+		nBlocks++;
+	}
+	producer.join();
+	CHECK(nOutOfOrder == 0, "%d samples or sizes out of order", nOutOfOrder);
+	CHECK(nFullPushes == 0 && ring.getNOverruns() == 0, "%d pushes dropped, %u overruns", nFullPushes.load(),
+			ring.getNOverruns());
+	int size;
+	CHECK(ring.front(&size) == NULL, "blocks left after the producer is done");
+}
+
+int main(){
+	checkWraparound();
+	checkOverruns();
+	checkTruncation();
+	checkThreads();
+	return CHECK_RESULT();
+}
@@ -0,0 +1,309 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FeatureEngineCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "FeatureEngine.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/*
+ * The features of the native processor must match the ones of music_processor.py. generate_golden.py computed them
+ * for a few 2048 sample blocks, the script's input size. The script down-samples and analyzes every block on its own,
+ * as if surrounded by silence: the engine gets the block with a window and hop of 512, then the decimator lookahead
+ * in zeros, which completes exactly one frame made of the block. Every bin and the energy may be off by
+ * GOLDEN_TOLERANCE, the float sums round differently and the script truncates to integers.
+ * Feeding the block in pieces of any size must give the same packet.
+ *
+ * The plugins get the default overlapping analysis, a window of 512 and a hop of 128. Down-sampled frame j of a
+ * stream ends at sample 128*j, and must be the window == hop analysis of the same 512 down-sampled samples: the
+ * stream delayed by 4*s captured zeros is down-sampled to the same samples delayed by s, so an engine with a hop of
+ * 512 fed it with s = -128*j modulo 512 ends a frame exactly there. This only holds once the window is inside the
+ * stream, before that the filter tail of the delayed stream reaches into the window. The energy is the one of the
+ * 2048 captured samples before 4*128*j. A block completes as many frames as it adds hops to the down-sampled stream,
+ * and only the newest of them is emitted
+ */
+
+#define GOLDEN_VECTORS_PATH "golden/feature_vectors.txt"
+#define GOLDEN_TOLERANCE 1
+#define GOLDEN_WINDOW 512
+#define OVERLAP_HOP 128
+#define OVERLAP_STREAM 16384					/*captured samples*/
+#define OVERLAP_SAMPLE_RATE 44100
+
+struct GoldenFeatures {
+	SoundFeatureRequest_t request;
+	std::vector<int> bins;
+	int energy;						/*-1 if not requested*/
+};
+
+struct GoldenSignal {
+	std::string name;
+	double sampleRate;
+	std::vector<float> samples;
+	std::vector<GoldenFeatures> features;
+};
+
+//skips the comment lines, then reads the next word
+static bool readWord(FILE* file, char* word){
+	while (fscanf(file, " %63s", word) == 1){
+		if (word[0] != '#'){
+			return true;
+		}
+		int c;
+		while ((c = fgetc(file)) != EOF && c != '\n'){
+		}
+	}
+	return false;
+}
+
+static bool readGoldenVectors(const char* path, std::vector<GoldenSignal>* signals){
+	FILE* file = fopen(path, "r");
+	if (!file){
+		return false;
+	}
+	char word[64];
+	bool ok = true;
+	while (ok && readWord(file, word)){
+		if (strcmp(word, "signal") == 0){
+			GoldenSignal signal;
+			char name[64];
+			int nSamples = 0;
+			ok = fscanf(file, " %63s %lf %d", name, &signal.sampleRate, &nSamples) == 3 && nSamples > 0;
+			signal.name = name;
+			for (int i = 0; ok && i < nSamples; i++){
+				int value;
+				ok = fscanf(file, " %d", &value) == 1;
+				signal.samples.push_back(value/32768.0f);
+			}
+			signals->push_back(signal);
+		}
+		else if (strcmp(word, "features") == 0 && !signals->empty()){
+			GoldenFeatures features;
+			int isFft, nBins, isEnergy, isMel;
+			ok = fscanf(file, " %d %d %d %d", &isFft, &nBins, &isEnergy, &isMel) == 4 && nBins > 0
+					&& nBins <= FEATURE_ENGINE_MAX_BINS;
+			features.request = {isFft != 0, nBins, isEnergy != 0, isMel != 0};
+			for (int i = 0; ok && i < nBins; i++){
+				int value;
+				ok = fscanf(file, " %d", &value) == 1;
+				features.bins.push_back(value);
+			}
+			ok = ok && fscanf(file, " %d", &features.energy) == 1;
+			signals->back().features.push_back(features);
+		}
+		else {
+			ok = false;
+		}
+	}
+	fclose(file);
+	return ok;
+}
+
+/*
+ * feeds the block in pieces of pieceSize samples followed by the lookahead in zeros, and returns the packet of the
+ * one frame this completes, empty if it completes none or more
+ */
+static std::vector<uint8_t> processBlock(const GoldenSignal& signal, const SoundFeatureRequest_t& request,
+		int pieceSize){
+	FeatureEngine engine;
+	std::vector<uint8_t> packet(FEATURE_ENGINE_MAX_PACKET);
+	if (engine.init(request, signal.sampleRate, GOLDEN_WINDOW, GOLDEN_WINDOW) != 0){
+		return std::vector<uint8_t>();
+	}
+	int nFrames = 0;
+	int nSamples = signal.samples.size();
+	for (int i = 0; i < nSamples; i += pieceSize){
+		int n = (nSamples - i < pieceSize) ? nSamples - i : pieceSize;
+		nFrames += engine.process(&signal.samples[i], n, packet.data()) > 0;
+	}
+	Decimator decimator(FEATURE_ENGINE_DECIMATION);
+	std::vector<float> zeros(decimator.getLookahead(), 0.0f);
+	int nBytes = engine.process(zeros.data(), zeros.size(), packet.data());
+	nFrames += nBytes > 0;
+	if (nFrames != 1 || nBytes != engine.getPacketSize()){
+		return std::vector<uint8_t>();
+	}
+	packet.resize(nBytes);
+	return packet;
+}
+
+static void checkSignal(const GoldenSignal& signal){
+	for (unsigned int f = 0; f < signal.features.size(); f++){
+		const GoldenFeatures& expected = signal.features[f];
+		const SoundFeatureRequest_t& request = expected.request;
+		const char* kind = request.isMel ? "mel" : "fft";
+		std::vector<uint8_t> packet = processBlock(signal, request, signal.samples.size());
+		CHECK(!packet.empty(), "%s, %s %d bins: the block does not complete exactly one frame", signal.name.c_str(),
+				kind, request.nBins);
+		if (packet.empty()){
+			continue;
+		}
+		for (int i = 0; i < request.nBins; i++){
+			CHECK(abs(packet[i] - expected.bins[i]) <= GOLDEN_TOLERANCE, "%s, %s %d bins: bin %d is %d, expected %d",
+					signal.name.c_str(), kind, request.nBins, i, packet[i], expected.bins[i]);
+		}
+		if (request.isEnergy){
+			uint16_t energy;
+			memcpy(&energy, &packet[request.nBins], sizeof(energy));
+			CHECK(abs(energy - expected.energy) <= GOLDEN_TOLERANCE, "%s: energy %d, expected %d", signal.name.c_str(),
+					energy, expected.energy);
+		}
+		else {
+			CHECK(packet.size() == (unsigned int)request.nBins + 4 && packet[request.nBins] == 0
+					&& packet[request.nBins + 3] == 0, "%s: no zero padding without energy", signal.name.c_str());
+		}
+
+		const int pieceSizes[] = {1, 7, 64, 333, 512, 1000};
+		for (int pieceSize : pieceSizes){
+			CHECK(processBlock(signal, request, pieceSize) == packet, "%s, %s %d bins: pieces of %d give another packet",
+					signal.name.c_str(), kind, request.nBins, pieceSize);
+		}
+	}
+}
+
+//feeds the stream one sample at a time, then the decimator lookahead in zeros, and returns the packet of every frame
+static std::vector<std::vector<uint8_t> > getEveryFrame(const std::vector<float>& stream,
+		const SoundFeatureRequest_t& request, int hopSize){
+	FeatureEngine engine;
+	std::vector<std::vector<uint8_t> > frames;
+	if (engine.init(request, OVERLAP_SAMPLE_RATE, GOLDEN_WINDOW, hopSize) != 0){
+		return frames;
+	}
+	Decimator decimator(FEATURE_ENGINE_DECIMATION);
+	std::vector<float> input(stream);
+	input.insert(input.end(), decimator.getLookahead(), 0.0f);
+	uint8_t packet[FEATURE_ENGINE_MAX_PACKET];
+	for (float sample : input){
+		int nBytes = engine.process(&sample, 1, packet);
+		if (nBytes > 0){
+			frames.push_back(std::vector<uint8_t>(packet, packet + nBytes));
+		}
+	}
+	return frames;
+}
+
+//the energy of the window of frame j, from the captured samples
+static int getFrameEnergy(const std::vector<float>& stream, int j){
+	int end = FEATURE_ENGINE_DECIMATION*OVERLAP_HOP*j;
+	double sum = 0;
+	for (int i = end - FEATURE_ENGINE_DECIMATION*GOLDEN_WINDOW; i < end; i++){
+		if (i >= 0 && i < (int)stream.size()){
+			sum += stream[i]*stream[i];
+		}
+	}
+	double value = sum*32;
+	return (value <= 0) ? 0 : (value < 65535) ? (int)value : 65535;
+}
+
+static void checkOverlap(const SoundFeatureRequest_t& request){
+	const char* kind = request.isMel ? "mel" : "fft";
+	std::vector<float> stream(OVERLAP_STREAM);
+	srand(2);
+	for (int i = 0; i < OVERLAP_STREAM; i++){
+		//a tone that fades in and out over the stream, so that every frame has other features
+		double t = i/(double)OVERLAP_SAMPLE_RATE;
+		double envelope = 0.5 - 0.5*cos(2*M_PI*i*3/OVERLAP_STREAM);
+		stream[i] = 0.4*envelope*sin(2*M_PI*(300 + 2000*t)*t) + 0.05*(rand()/(float)RAND_MAX - 0.5f);
+	}
+
+	//frame j of the overlapping analysis, from the window == hop analysis of the delayed stream
+	int nFrames = OVERLAP_STREAM/(FEATURE_ENGINE_DECIMATION*OVERLAP_HOP);
+	std::vector<std::vector<uint8_t> > expected(nFrames + 1);
+	for (int shift = 0; shift < GOLDEN_WINDOW; shift += OVERLAP_HOP){
+		std::vector<float> delayed(FEATURE_ENGINE_DECIMATION*shift, 0.0f);
+		delayed.insert(delayed.end(), stream.begin(), stream.end());
+		std::vector<std::vector<uint8_t> > frames = getEveryFrame(delayed, request, GOLDEN_WINDOW);
+		for (unsigned int m = 0; m < frames.size(); m++){
+			int j = ((m + 1)*GOLDEN_WINDOW - shift)/OVERLAP_HOP;
+			if (j*OVERLAP_HOP >= GOLDEN_WINDOW && j <= nFrames){
+				expected[j] = frames[m];
+			}
+		}
+	}
+
+	std::vector<std::vector<uint8_t> > frames = getEveryFrame(stream, request, OVERLAP_HOP);
+	CHECK((int)frames.size() == nFrames, "%s %d bins: %d frames of a %d sample stream, expected %d", kind,
+			request.nBins, (int)frames.size(), OVERLAP_STREAM, nFrames);
+	for (unsigned int i = 0; i < frames.size() && (int)i < nFrames; i++){
+		int j = i + 1;
+		if (!expected[j].empty()){
+			CHECK(frames[i] == expected[j], "%s %d bins: frame %d differs from the window == hop analysis", kind,
+					request.nBins, j);
+		}
+		if (request.isEnergy){
+			uint16_t energy;
+			memcpy(&energy, &frames[i][request.nBins], sizeof(energy));
+			CHECK(abs(energy - getFrameEnergy(stream, j)) <= GOLDEN_TOLERANCE, "%s: frame %d energy %d, expected %d",
+					kind, j, energy, getFrameEnergy(stream, j));
+		}
+	}
+
+	//blocks of any size complete the frames of the hops they add, and emit the newest
+	const int pieceSizes[] = {7, 512, 1000, 2048, 5000};
+	for (int pieceSize : pieceSizes){
+		FeatureEngine engine;
+		engine.init(request, OVERLAP_SAMPLE_RATE, GOLDEN_WINDOW, OVERLAP_HOP);
+		Decimator decimator(FEATURE_ENGINE_DECIMATION);
+		std::vector<float> input(stream);
+		input.insert(input.end(), decimator.getLookahead(), 0.0f);
+		std::vector<float> decimated(decimator.getMaxOutputSize(pieceSize));
+		int nDecimated = 0, nWrong = 0;
+		uint8_t packet[FEATURE_ENGINE_MAX_PACKET];
+		for (unsigned int i = 0; i < input.size(); i += pieceSize){
+			int n = (input.size() - i < (unsigned int)pieceSize) ? input.size() - i : pieceSize;
+			int nBytes = engine.process(&input[i], n, packet);
+			int before = nDecimated/OVERLAP_HOP;
+			nDecimated += decimator.process(&input[i], n, decimated.data());
+			int newest = nDecimated/OVERLAP_HOP;
+			if (nBytes != ((newest > before) ? engine.getPacketSize() : 0)){
+				nWrong++;
+			}
+			else if (newest > before && newest <= (int)frames.size() && std::vector<uint8_t>(packet, packet + nBytes)
+					!= frames[newest - 1]){
+				nWrong++;
+			}
+		}
+		CHECK(nDecimated/OVERLAP_HOP == nFrames, "pieces of %d: %d frames, expected %d", pieceSize,
+				nDecimated/OVERLAP_HOP, nFrames);
+		CHECK(nWrong == 0, "%s %d bins, pieces of %d: %d blocks emitted another frame than their newest", kind,
+				request.nBins, pieceSize, nWrong);
+	}
+}
+
+int main(){
+	std::vector<GoldenSignal> signals;
+	CHECK(readGoldenVectors(GOLDEN_VECTORS_PATH, &signals), "cannot read %s", GOLDEN_VECTORS_PATH);
+	CHECK(!signals.empty(), "no signals in %s", GOLDEN_VECTORS_PATH);
+	for (const GoldenSignal& signal : signals){
+		CHECK(!signal.features.empty(), "%s: no features", signal.name.c_str());
+		checkSignal(signal);
+	}
+	const SoundFeatureRequest_t overlapRequests[] = {{true, 16, true, false}, {true, 256, false, false},
+			{false, FEATURE_ENGINE_N_MEL, true, true}};
+	for (const SoundFeatureRequest_t& request : overlapRequests){
+		checkOverlap(request);
+	}
+	return CHECK_RESULT();
+}
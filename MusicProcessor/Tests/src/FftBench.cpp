@@ -0,0 +1,118 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FftBench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Check.h"
+#include "FeatureEngine.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * Times the spectrum of one block as enableFft gets it: RealFft::forward of the 512 windowed samples, the squared
+ * magnitudes and BinGrouping::apply into 32 bins. For scale, the same with a direct DFT over precomputed twiddles, and
+ * the whole FeatureEngine::process of a 2048 sample capture block (down-sampling included), the work
+ * process_music_data does per block in music_processor.py.
+ * make bench runs it from the SSE build and from the AVX2 build, each prints which one it is. The AVX2 build skips
+ * itself on a processor without AVX2
+ */
+
+#define BENCH_WINDOW 512
+#define BENCH_BINS 32
+#define BENCH_BLOCK 2048
+
+#if defined(__AVX2__)
+#define BENCH_SIMD "AVX2"
+#elif defined(__AVX__)
+#define BENCH_SIMD "AVX"
+#elif defined(__SSE2__)
+#define BENCH_SIMD "SSE2"
+#else
+#define BENCH_SIMD "scalar"
+#endif
+
+int main(){
+#if defined(__AVX2__)
+	if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")){
+		printf("%s build: skipped, the processor has no AVX2\n", BENCH_SIMD);
+		return 0;
+	}
+#endif
+	const int nBins = BENCH_WINDOW/2 + 1;
+	std::vector<float> frame(BENCH_WINDOW);
+	srand(1);
+	for (int i = 0; i < BENCH_WINDOW; i++){
+		frame[i] = (0.5 - 0.5*cos(2*M_PI*i/BENCH_WINDOW))*(rand()/(float)RAND_MAX - 0.5f);
+	}
+	RealFft fft(BENCH_WINDOW);
+	BinGrouping grouping;
+	grouping.init(BENCH_WINDOW/2, BENCH_BINS);
+	std::vector<float> re(nBins), im(nBins), power(nBins);
+	uint8_t out[BENCH_BINS];
+
+	double fftUs = timePerCall([&](){
+		float* buffer = fft.getBuffer();
+		for (int i = 0; i < BENCH_WINDOW; i++){
+			buffer[i] = frame[i];
+		}
+		fft.forward(re.data(), im.data());
+		for (int k = 0; k < nBins; k++){
+			power[k] = 8*(re[k]*re[k] + im[k]*im[k]);
+		}
+		grouping.apply(power.data(), out);
+	}, 200000);
+
+	std::vector<float> cosTable(BENCH_WINDOW), sinTable(BENCH_WINDOW);
+	for (int i = 0; i < BENCH_WINDOW; i++){
+		cosTable[i] = cos(2*M_PI*i/BENCH_WINDOW);
+		sinTable[i] = -sin(2*M_PI*i/BENCH_WINDOW);
+	}
+	double dftUs = timePerCall([&](){
+		for (int k = 0; k < nBins; k++){
+			float sumRe = 0, sumIm = 0;
+			for (int t = 0; t < BENCH_WINDOW; t++){
+				int j = (k*t) & (BENCH_WINDOW - 1);
+				sumRe += frame[t]*cosTable[j];
+				sumIm += frame[t]*sinTable[j];
+			}
+			power[k] = 8*(sumRe*sumRe + sumIm*sumIm);
+		}
+		grouping.apply(power.data(), out);
+	}, 2000);
+
+	std::vector<float> block(BENCH_BLOCK);
+	for (int i = 0; i < BENCH_BLOCK; i++){
+		block[i] = 0.5f*sin(2*M_PI*440*i/44100.0) + 0.1f*(rand()/(float)RAND_MAX - 0.5f);
+	}
+	uint8_t packet[FEATURE_ENGINE_MAX_PACKET];
+	FeatureEngine fftEngine, melEngine;
+	fftEngine.init({true, BENCH_BINS, true, false}, 44100, BENCH_WINDOW, BENCH_WINDOW);
+	melEngine.init({false, 0, true, true}, 44100, BENCH_WINDOW, BENCH_WINDOW);
+	double fftBlockUs = timePerCall([&](){ fftEngine.process(block.data(), BENCH_BLOCK, packet); }, 50000);
+	double melBlockUs = timePerCall([&](){ melEngine.process(block.data(), BENCH_BLOCK, packet); }, 50000);
+
+	printf("%s build:\n", BENCH_SIMD);
+	printf("spectrum of a %d sample window into %d bins: RealFft %6.2f us, direct DFT %8.2f us\n", BENCH_WINDOW,
+			BENCH_BINS, fftUs, dftUs);
+	printf("FeatureEngine::process of a %d sample block: fft %6.2f us, mel %6.2f us\n", BENCH_BLOCK, fftBlockUs,
+			melBlockUs);
+	return 0;
+}
@@ -0,0 +1,99 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * AudioCapture.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_AUDIOCAPTURE_H_
+#define INC_AUDIOCAPTURE_H_
+
+#include "BlockRing.h"
+#include <portaudio.h>
+#include <atomic>
+
+#define AUDIO_CAPTURE_ERROR_INIT -20
+#define AUDIO_CAPTURE_ERROR_NO_DEVICE -21
+#define AUDIO_CAPTURE_ERROR_OPEN -22
+
+#define AUDIO_CAPTURE_RING_BLOCKS 8		/*blocks the analysis may fall behind before blocks are dropped*/
+
+/**
+ * Mono float capture from the default input device, at its default sample rate, with PortAudio (the library
+ * pyaudio wraps). The callback queues every block in a lock-free ring, the analysis takes them in order. Blocks are
+ * only lost if the analysis falls AUDIO_CAPTURE_RING_BLOCKS blocks behind, and then counted
+ */
+class AudioCapture {
+	PaStream* stream;
+	double sampleRate;
+	BlockRing* ring;
+	std::atomic<unsigned> nInputOverflows;		/*blocks PortAudio lost before the callback*/
+
+	AudioCapture(const AudioCapture&) = delete;
+	AudioCapture& operator=(const AudioCapture&) = delete;
+
+	static int inputCallback(const void* input, void* output, unsigned long frameCount,
+			const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags, void* userData);
+
+public:
+	AudioCapture();
+	~AudioCapture();
+
+	/**
+	 * @description: opens the default input device and starts capturing
+	 * @params framesPerBuffer: samples per block
+	 * @return: 0 on success, AUDIO_CAPTURE_ERROR_* otherwise
+	 */
+	int start(int framesPerBuffer);
+
+	/**
+	 * @description: stops capturing and closes the device
+	 */
+	void stop();
+
+	double getSampleRate() const { return sampleRate; }
+
+	/**
+	 * @description: the oldest captured block not processed yet. It stays valid until releaseBlock is called
+	 * @params size: filled with the number of samples
+	 * @return: the samples, NULL if there is no new block
+	 */
+	const float* getBlock(int* size) const;
+
+	/**
+	 * @description: releases the block returned by getBlock
+	 */
+	void releaseBlock();
+
+	/**
+	 * @description: number of captured blocks waiting for the analysis
+	 */
+	int getNQueued() const;
+
+	/**
+	 * @description: number of blocks dropped because the analysis was AUDIO_CAPTURE_RING_BLOCKS blocks behind
+	 */
+	unsigned getNOverruns() const;
+
+	/**
+	 * @description: number of times PortAudio reported lost input, before the blocks reached the capture
+	 */
+	unsigned getNInputOverflows() const { return nInputOverflows.load(std::memory_order_relaxed); }
+};
+
+#endif /* INC_AUDIOCAPTURE_H_ */
@@ -0,0 +1,82 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * BlockRing.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_BLOCKRING_H_
+#define INC_BLOCKRING_H_
+
+#include <atomic>
+
+/**
+ * Lock-free ring of sample blocks between one producer (the audio callback) and one consumer (the analysis).
+ * All blocks are allocated up front. The producer copies a block in, the consumer reads the oldest block in place
+ * and releases it when done, neither ever waits. When the ring is full the incoming block is dropped and counted,
+ * the blocks already queued are kept
+ */
+class BlockRing {
+	int nBlocks;					/*a power of 2*/
+	int blockSize;					/*maximum samples per block*/
+	float* samples;					/*nBlocks*blockSize*/
+	int* sizes;						/*samples in every block*/
+	std::atomic<unsigned> writeIndex;	/*blocks pushed, only written by the producer*/
+	std::atomic<unsigned> readIndex;	/*blocks released, only written by the consumer*/
+	std::atomic<unsigned> nOverruns;	/*blocks dropped because the ring was full*/
+
+	BlockRing(const BlockRing&) = delete;
+	BlockRing& operator=(const BlockRing&) = delete;
+
+public:
+	/**
+	 * @params nBlocks: capacity in blocks, rounded up to a power of 2
+	 * @params blockSize: maximum samples per block, longer blocks are truncated
+	 */
+	BlockRing(int nBlocks, int blockSize);
+	~BlockRing();
+
+	/**
+	 * @description: producer side, queues a copy of a block
+	 * @params block: the samples
+	 * @params size: number of samples
+	 * @return: false if the ring was full and the block was dropped
+	 */
+	bool push(const float* block, int size);
+
+	/**
+	 * @description: consumer side, the oldest queued block. It stays valid until release is called
+	 * @params size: filled with the number of samples
+	 * @return: the samples, NULL if the ring is empty
+	 */
+	const float* front(int* size) const;
+
+	/**
+	 * @description: consumer side, gives the block returned by front back to the producer
+	 */
+	void release();
+
+	/**
+	 * @description: number of blocks waiting for the consumer
+	 */
+	int getNQueued() const;
+
+	unsigned getNOverruns() const { return nOverruns.load(std::memory_order_relaxed); }
+};
+
+#endif /* INC_BLOCKRING_H_ */
@@ -0,0 +1,75 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * Decimator.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_DECIMATOR_H_
+#define INC_DECIMATOR_H_
+
+#include <vector>
+
+/**
+ * Integer factor down-sampling with a windowed sinc low pass filter, the filter of resampy's 'kaiser_fast' (16 zero
+ * crossings, Kaiser window with beta 8.5555, rolloff 0.85) that librosa.resample(res_type='kaiser_fast') uses.
+ * For an integer factor the filter is only ever read at whole multiples of its table step, so it reduces to a fixed,
+ * symmetric FIR evaluated at every factor-th input sample.
+ * The input is a continuous stream cut in blocks of any size: the decimator keeps the samples the filter still needs
+ * across blocks, so an output sample is produced once the filter length after it has arrived (63 input samples at a
+ * factor of 4). Before the first sample the input counts as 0
+ */
+class Decimator {
+	int factor;
+	std::vector<float> taps;		/*taps[d] weighs the input d samples away from the output position, d >= 0*/
+	std::vector<float> history;		/*input from nTaps - 1 samples before the next output position on*/
+
+public:
+	/**
+	 * @description: computes the filter taps
+	 * @params factor: the decimation factor, a power of 2 up to 512
+	 */
+	Decimator(int factor);
+
+	/**
+	 * @description: forgets the stream, the next block starts a new one
+	 */
+	void reset();
+
+	/**
+	 * @description: output sample k is taken at input sample k*factor, and produced once this many input samples
+	 * after it arrived
+	 */
+	int getLookahead() const { return taps.size() - 1; }
+
+	/**
+	 * @description: the most output samples a block can produce
+	 */
+	int getMaxOutputSize(int nSamples) const;
+
+	/**
+	 * @description: filters and down-samples the next block of the stream
+	 * @params in: the input block
+	 * @params nSamples: number of input samples
+	 * @params out: filled with at most getMaxOutputSize(nSamples) samples
+	 * @return: the number of output samples
+	 */
+	int process(const float* in, int nSamples, float* out);
+};
+
+#endif /* INC_DECIMATOR_H_ */
@@ -0,0 +1,161 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FeatureEngine.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_FEATUREENGINE_H_
+#define INC_FEATUREENGINE_H_
+
+#include "Decimator.h"
+#include "MelFilterbank.h"
+#include "RealFft.h"
+#include <stdint.h>
+#include <vector>
+
+#define FEATURE_ENGINE_DECIMATION 4			/*the spectrum is taken at a quarter of the capture rate*/
+#define FEATURE_ENGINE_WINDOW 512			/*default analysis window, in down-sampled samples*/
+#define FEATURE_ENGINE_HOP 128				/*default hop, a frame every 512 captured samples*/
+#define FEATURE_ENGINE_MIN_WINDOW 16
+#define FEATURE_ENGINE_MAX_WINDOW 2048
+#define FEATURE_ENGINE_N_MEL 26				/*fixed, same as on the Aurora*/
+#define FEATURE_ENGINE_MAX_BINS 256
+#define FEATURE_ENGINE_MAX_PACKET (FEATURE_ENGINE_MAX_BINS + 4)
+
+#define FEATURE_ENGINE_ERROR_SAMPLE_RATE -1
+#define FEATURE_ENGINE_ERROR_N_BINS -2
+#define FEATURE_ENGINE_ERROR_WINDOW -3
+
+/**
+ * The sound features a plugin asked for, as sent in the handshake: "is_fft n_bins is_energy is_mel"
+ */
+struct SoundFeatureRequest_t {
+	bool isFft;
+	int nBins;			/*number of output bins, forced to FEATURE_ENGINE_N_MEL for mel*/
+	bool isEnergy;
+	bool isMel;			/*either isFft or isMel, mel wins if both are set*/
+};
+
+/**
+ * Sums consecutive input bins into output bins, saturated to 8 bit, as get_output_fft_bins does.
+ * Every output bin sums nIn/nOut inputs (rounded down), trailing inputs are dropped. The bounds of the groups are
+ * computed once per number of output bins
+ */
+class BinGrouping {
+	int nOut;
+	std::vector<int> bounds;		/*first and end input of every output bin*/
+
+public:
+	BinGrouping();
+
+	/**
+	 * @params nIn: number of input bins
+	 * @params nOut: number of output bins
+	 */
+	void init(int nIn, int nOut);
+
+	/**
+	 * @params in: the input bins
+	 * @params out: filled with the output bins
+	 */
+	void apply(const float* in, uint8_t* out) const;
+};
+
+/**
+ * Computes the sound features of the captured stream and packs them the way music_processor.py sends them:
+ * nBins uint8 bins followed by the energy as one native endian uint16, or by 4 zero bytes if energy is not enabled.
+ * The stream is down-sampled by 4 and analyzed in overlapping windows, a new frame every hop samples. The bins are
+ * the squared STFT magnitudes of the last window (FFT scaled by 8, mel spectrum of the magnitudes scaled by 4),
+ * summed in groups of nInputBins/nBins and saturated to 255. The energy is the sum of the squared captured samples
+ * the window was down-sampled from, times 32: down-sampled sample k stands for captured sample 4k, so energy and
+ * spectrum describe the same audio although the decimator produces a sample only a few captured samples later.
+ * With a window of 512 the scales are the ones of the script, which analyzed 2048 captured samples at a time without
+ * overlap. Blocks can have any size, the state carries over from one block to the next
+ */
+class FeatureEngine {
+	SoundFeatureRequest_t request;
+	int windowSize;
+	int hopSize;
+	Decimator decimator;
+	RealFft* fft;
+	MelFilterbank* melFilterbank;
+	BinGrouping grouping;
+	std::vector<float> window;					/*periodic Hann window, as librosa.stft uses*/
+	std::vector<float> decimated;				/*the last windowSize down-sampled samples, then the new ones*/
+	int nSinceFrame;							/*down-sampled samples since the end of the last frame*/
+	std::vector<float> squares;					/*squares of the last captured samples, a ring indexed by nCaptured*/
+	long long nCaptured;						/*captured samples since init*/
+	long long nDecimated;						/*down-sampled samples since init*/
+	std::vector<float> spectrumRe;
+	std::vector<float> spectrumIm;
+	std::vector<float> power;					/*scaled squared magnitudes*/
+
+	FeatureEngine(const FeatureEngine&) = delete;
+	FeatureEngine& operator=(const FeatureEngine&) = delete;
+
+	void storeSquares(const float* block, int nSamples);
+	double getWindowEnergy(long long windowEnd) const;
+	void computeSpectrum(const float* frame);
+
+public:
+	FeatureEngine();
+	~FeatureEngine();
+
+	/**
+	 * @description: sets the engine up for the features requested by the plugin and starts a new stream
+	 * @params request: the requested features
+	 * @params sampleRate: capture sample rate
+	 * @params windowSize: analysis window in down-sampled samples, a power of 2 from FEATURE_ENGINE_MIN_WINDOW to
+	 * FEATURE_ENGINE_MAX_WINDOW
+	 * @params hopSize: down-sampled samples between frames, dividing windowSize
+	 * @return: 0 on success, FEATURE_ENGINE_ERROR_* on invalid parameters
+	 */
+	int init(const SoundFeatureRequest_t& request, double sampleRate, int windowSize = FEATURE_ENGINE_WINDOW,
+			int hopSize = FEATURE_ENGINE_HOP);
+
+	/**
+	 * @description: size of every packet, in bytes
+	 */
+	int getPacketSize() const;
+
+	/**
+	 * @description: captured samples per hop, the capture block size that gives one frame per block
+	 */
+	int getCaptureHop() const { return hopSize*FEATURE_ENGINE_DECIMATION; }
+
+	/**
+	 * @description: feeds the next block of the stream. If one or more frames were completed, the features of the
+	 * newest one are computed, earlier ones would be outdated already
+	 * @params block: the samples, in [-1, 1]
+	 * @params nSamples: number of samples
+	 * @params packet: filled with getPacketSize() bytes if a frame was completed
+	 * @return: the number of bytes written, 0 if the block did not complete a frame
+	 */
+	int process(const float* block, int nSamples, uint8_t* packet);
+};
+
+/**
+ * @description: checks an analysis window and hop, as FeatureEngine::init does
+ * @params windowSize: analysis window in down-sampled samples
+ * @params hopSize: down-sampled samples between frames
+ * @return: true if the engine supports them
+ */
+bool isValidAnalysisWindow(int windowSize, int hopSize);
+
+#endif /* INC_FEATUREENGINE_H_ */
@@ -0,0 +1,66 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * MelFilterbank.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_MELFILTERBANK_H_
+#define INC_MELFILTERBANK_H_
+
+#include <vector>
+
+/**
+ * Triangular mel filterbank as librosa.filters.mel builds it with its defaults: Slaney's mel scale (linear below
+ * 1 kHz, logarithmic above), bands from 0 Hz to the Nyquist frequency and every triangle normalized to unit area.
+ * Every band only covers the few bins between its neighbours' centers, so only those weights are kept, as a band
+ * matrix: the first bin and the weights of every band. The weights are computed once per sample rate, applying them
+ * is a short dot product per band, vectorized with SSE (AVX when compiled with -mavx or -mavx2)
+ */
+class MelFilterbank {
+	double sampleRate;
+	int nMels;
+	int nBins;					/*nFft/2 + 1 power spectrum bins*/
+	std::vector<int> bands;		/*first bin, number of bins and offset in weights of every band*/
+	float* weights;				/*the weights of every band, every band starts aligned*/
+
+	MelFilterbank(const MelFilterbank&) = delete;
+	MelFilterbank& operator=(const MelFilterbank&) = delete;
+
+public:
+	/**
+	 * @params sampleRate: sample rate of the signal the spectrum was taken from
+	 * @params nFft: the FFT size
+	 * @params nMels: number of mel bands
+	 */
+	MelFilterbank(double sampleRate, int nFft, int nMels);
+	~MelFilterbank();
+
+	/**
+	 * @description: the mel spectrum of a power spectrum, as librosa.feature.melspectrogram(S=power)
+	 * @params power: nFft/2 + 1 power spectrum bins
+	 * @params mel: filled with nMels band energies
+	 */
+	void apply(const float* power, float* mel) const;
+
+	double getSampleRate() const { return sampleRate; }
+	int getNMels() const { return nMels; }
+	int getNBins() const { return nBins; }
+};
+
+#endif /* INC_MELFILTERBANK_H_ */
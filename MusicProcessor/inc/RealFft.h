@@ -0,0 +1,79 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * RealFft.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_REALFFT_H_
+#define INC_REALFFT_H_
+
+/**
+ * FFT of a real signal, unnormalized like numpy.fft.rfft. The n samples are transformed as n/2 complex values (even
+ * samples real, odd samples imaginary) with a radix-2 FFT, then split into the n/2 + 1 bins of the real signal.
+ * Bit reversal, twiddles and split factors are computed once. The butterflies work on separate real and imaginary
+ * arrays in aligned buffers and are vectorized with SSE (AVX when compiled with -mavx or -mavx2)
+ */
+class RealFft {
+	int n;
+	int half;						/*size of the complex transform*/
+	int* bitReverse;				/*half entries*/
+	float* twiddleRe;				/*half entries, the twiddles of the stage of length len start at len/2*/
+	float* twiddleIm;
+	float* splitRe;					/*exp(-2*pi*i*k/n) for k < half*/
+	float* splitIm;
+	float* buffer;					/*n input samples*/
+	float* workRe;					/*half entries*/
+	float* workIm;
+
+	RealFft(const RealFft&) = delete;
+	RealFft& operator=(const RealFft&) = delete;
+
+public:
+	/**
+	 * @params n: transform size, a power of 2 and at least 4
+	 */
+	RealFft(int n);
+	~RealFft();
+
+	/**
+	 * @description: the aligned input buffer, fill it with n samples before calling forward
+	 */
+	float* getBuffer() { return buffer; }
+
+	int getSize() const { return n; }
+
+	/**
+	 * @description: transforms the input buffer, X[k] = sum x[t]*exp(-2*pi*i*k*t/n) for k = 0 ... n/2.
+	 * The input buffer is left untouched
+	 * @params re: filled with the n/2 + 1 real parts
+	 * @params im: filled with the n/2 + 1 imaginary parts
+	 */
+	void forward(float* re, float* im);
+};
+
+/**
+ * @description: allocates a float buffer aligned for the widest vectors, release it with freeAligned
+ * @params size: number of floats
+ * @return: the buffer, zeroed
+ */
+float* allocAligned(int size);
+
+void freeAligned(float* buffer);
+
+#endif /* INC_REALFFT_H_ */
@@ -0,0 +1,79 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UdpLink.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_UDPLINK_H_
+#define INC_UDPLINK_H_
+
+#include "FeatureEngine.h"
+#include <stdint.h>
+
+#define UDP_LINK_HOST "127.0.0.1"
+#define UDP_LINK_FEATURE_PORT 27182		/*features are sent here*/
+#define UDP_LINK_REQUEST_PORT 27184		/*the plugin sends its feature request here*/
+#define UDP_LINK_REQUEST_SIZE 20
+
+#define UDP_LINK_ERROR_SOCKET -10
+#define UDP_LINK_ERROR_BIND -11
+#define UDP_LINK_ERROR_RECEIVE -12
+#define UDP_LINK_ERROR_SEND -13
+
+/**
+ * The UDP side of the music processor, on the loopback interface like music_processor.py: receives the sound
+ * feature request of the plugin and sends it the features of every block
+ */
+class UdpLink {
+	int sendSocket;
+
+	UdpLink(const UdpLink&) = delete;
+	UdpLink& operator=(const UdpLink&) = delete;
+
+public:
+	UdpLink();
+	~UdpLink();
+
+	/**
+	 * @description: blocks until the plugin sends its request. Packets from other hosts or that do not parse are
+	 * ignored
+	 * @params request: filled with the request
+	 * @return: 0 on success, UDP_LINK_ERROR_* if the socket failed
+	 */
+	int waitForRequest(SoundFeatureRequest_t* request);
+
+	/**
+	 * @description: sends a feature packet
+	 * @params packet: the packet
+	 * @params size: its size in bytes
+	 * @return: 0 on success, UDP_LINK_ERROR_* if the packet could not be sent
+	 */
+	int send(const uint8_t* packet, int size);
+};
+
+/**
+ * @description: parses a feature request, "is_fft n_bins is_energy is_mel" separated by white space
+ * @params text: the request, not necessarily null terminated
+ * @params size: its length
+ * @params request: filled with the request
+ * @return: true if all four values were found
+ */
+bool parseSoundFeatureRequest(const char* text, int size, SoundFeatureRequest_t* request);
+
+#endif /* INC_UDPLINK_H_ */
@@ -0,0 +1,109 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * AudioCapture.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "AudioCapture.h"
+#include <stdio.h>
+
+AudioCapture::AudioCapture() : stream(NULL), sampleRate(0), ring(NULL), nInputOverflows(0){
+}
+
+AudioCapture::~AudioCapture(){
+	stop();
+}
+
+int AudioCapture::inputCallback(const void* input, void* output, unsigned long frameCount,
+		const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags, void* userData){
+	AudioCapture* capture = (AudioCapture*)userData;
+	if (statusFlags & paInputOverflow){
+		capture->nInputOverflows.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (input){
+		capture->ring->push((const float*)input, frameCount);
+	}
+	return paContinue;
+}
+
+int AudioCapture::start(int framesPerBuffer){
+	if (Pa_Initialize() != paNoError){
+		return AUDIO_CAPTURE_ERROR_INIT;
+	}
+	PaDeviceIndex device = Pa_GetDefaultInputDevice();
+	if (device == paNoDevice){
+		printf("Input audio device not found, terminating ...\n");
+		Pa_Terminate();
+		return AUDIO_CAPTURE_ERROR_NO_DEVICE;
+	}
+	const PaDeviceInfo* info = Pa_GetDeviceInfo(device);
+	printf("default inputs: sample rate %.1f, latency low %.4f, latency high %.4f, channels %d\n",
+			info->defaultSampleRate, info->defaultLowInputLatency, info->defaultHighInputLatency,
+			info->maxInputChannels);
+	sampleRate = info->defaultSampleRate;
+	ring = new BlockRing(AUDIO_CAPTURE_RING_BLOCKS, framesPerBuffer);
+
+	PaStreamParameters parameters;
+	parameters.device = device;
+	parameters.channelCount = 1;
+	parameters.sampleFormat = paFloat32;
+	parameters.suggestedLatency = info->defaultLowInputLatency;
+	parameters.hostApiSpecificStreamInfo = NULL;
+	PaError error = Pa_OpenStream(&stream, &parameters, NULL, sampleRate, framesPerBuffer, paNoFlag,
+			inputCallback, this);
+	if (error == paNoError){
+		error = Pa_StartStream(stream);
+	}
+	if (error != paNoError){
+		printf("Could not open the input stream: %s\n", Pa_GetErrorText(error));
+		stop();
+		return AUDIO_CAPTURE_ERROR_OPEN;
+	}
+	return 0;
+}
+
+void AudioCapture::stop(){
+	if (stream){
+		Pa_StopStream(stream);
+		Pa_CloseStream(stream);
+		stream = NULL;
+	}
+	if (sampleRate > 0){
+		Pa_Terminate();
+		sampleRate = 0;
+	}
+	delete ring;
+	ring = NULL;
+}
+
+const float* AudioCapture::getBlock(int* size) const {
+	return ring ? ring->front(size) : NULL;
+}
+
+void AudioCapture::releaseBlock(){
+	ring->release();
+}
+
+int AudioCapture::getNQueued() const {
+	return ring ? ring->getNQueued() : 0;
+}
+
+unsigned AudioCapture::getNOverruns() const {
+	return ring ? ring->getNOverruns() : 0;
+}
@@ -0,0 +1,72 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * BlockRing.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "BlockRing.h"
+#include <string.h>
+
+BlockRing::BlockRing(int nBlocks, int blockSize) : nBlocks(1), blockSize(blockSize), writeIndex(0), readIndex(0),
+		nOverruns(0){
+	while (this->nBlocks < nBlocks){
+		this->nBlocks <<= 1;
+	}
+	samples = new float[this->nBlocks*blockSize];
+	sizes = new int[this->nBlocks];
+}
+
+BlockRing::~BlockRing(){
+	delete [] samples;
+	delete [] sizes;
+}
+
+bool BlockRing::push(const float* block, int size){
+	unsigned w = writeIndex.load(std::memory_order_relaxed);
+	if (w - readIndex.load(std::memory_order_acquire) >= (unsigned)nBlocks){
+		nOverruns.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	int slot = w & (nBlocks - 1);
+	size = (size > blockSize) ? blockSize : size;
+	memcpy(samples + slot*blockSize, block, size*sizeof(float));
+	sizes[slot] = size;
+	//publish the block only once it is written
+	writeIndex.store(w + 1, std::memory_order_release);
+	return true;
+}
+
+const float* BlockRing::front(int* size) const {
+	unsigned r = readIndex.load(std::memory_order_relaxed);
+	if (r == writeIndex.load(std::memory_order_acquire)){
+		return NULL;
+	}
+	int slot = r & (nBlocks - 1);
+	*size = sizes[slot];
+	return samples + slot*blockSize;
+}
+
+void BlockRing::release(){
+	//the producer may only reuse the slot once the consumer is done reading it
+	readIndex.store(readIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+int BlockRing::getNQueued() const {
+	return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,86 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * Decimator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "Decimator.h"
+#include <math.h>
+
+#define KAISER_FAST_ZEROS 16
+#define KAISER_FAST_BETA 8.555504641634386
+#define KAISER_FAST_ROLLOFF 0.85
+#define KAISER_FAST_TABLE_BITS 512		/*table entries per zero crossing*/
+
+//zeroth order modified Bessel function of the first kind, by its power series
+static double besselI0(double x){
+	double sum = 1, term = 1;
+	for (int k = 1; k < 64 && term > 1e-17*sum; k++){
+		term *= (x/(2*k))*(x/(2*k));
+		sum += term;
+	}
+	return sum;
+}
+
+/*
+ * resampy samples rolloff*sinc(rolloff*t)*kaiser(t) at t = j/KAISER_FAST_TABLE_BITS zero crossings and scales it by
+ * 1/factor when down-sampling. At an integer ratio the output positions fall exactly on input samples, so only the
+ * entries j = d*KAISER_FAST_TABLE_BITS/factor are used, one per input sample at distance d
+ */
+Decimator::Decimator(int factor) : factor(factor){
+	const int tableSize = KAISER_FAST_ZEROS*KAISER_FAST_TABLE_BITS;
+	const int step = KAISER_FAST_TABLE_BITS/factor;
+	int nTaps = tableSize/step;		//resampy never reads the last table entry, at exactly 16 zero crossings
+	taps.resize(nTaps);
+	for (int d = 0; d < nTaps; d++){
+		int j = d*step;
+		double t = (double)j/KAISER_FAST_TABLE_BITS;
+		double x = KAISER_FAST_ROLLOFF*t;
+		double sinc = (x == 0) ? 1 : sin(M_PI*x)/(M_PI*x);
+		double r = (double)j/tableSize;
+		double window = besselI0(KAISER_FAST_BETA*sqrt(1 - r*r))/besselI0(KAISER_FAST_BETA);
+		taps[d] = KAISER_FAST_ROLLOFF*sinc*window/factor;
+	}
+	reset();
+}
+
+void Decimator::reset(){
+	history.assign(taps.size() - 1, 0.0f);
+}
+
+int Decimator::getMaxOutputSize(int nSamples) const {
+	return nSamples/factor + 1;
+}
+
+int Decimator::process(const float* in, int nSamples, float* out){
+	history.insert(history.end(), in, in + nSamples);
+	int nTaps = taps.size();
+	int nOut = 0;
+	int n = nTaps - 1;		//the next output position in history
+	for (; n + nTaps - 1 < (int)history.size(); n += factor){
+		const float* x = &history[n];
+		double acc = taps[0]*x[0];
+		for (int d = 1; d < nTaps; d++){
+			acc += taps[d]*(x[-d] + x[d]);
+		}
+		out[nOut++] = acc;
+	}
+	history.erase(history.begin(), history.begin() + (n - (nTaps - 1)));
+	return nOut;
+}
@@ -0,0 +1,210 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * FeatureEngine.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "FeatureEngine.h"
+#include <math.h>
+#include <string.h>
+
+FeatureEngine::FeatureEngine() : windowSize(0), hopSize(0), decimator(FEATURE_ENGINE_DECIMATION), fft(NULL),
+		melFilterbank(NULL), nSinceFrame(0), nCaptured(0), nDecimated(0){
+	request = {false, 0, false, false};
+}
+
+FeatureEngine::~FeatureEngine(){
+	delete fft;
+	delete melFilterbank;
+}
+
+int FeatureEngine::init(const SoundFeatureRequest_t& request, double sampleRate, int windowSize, int hopSize){
+	if (sampleRate <= 0){
+		return FEATURE_ENGINE_ERROR_SAMPLE_RATE;
+	}
+	if (!isValidAnalysisWindow(windowSize, hopSize)){
+		return FEATURE_ENGINE_ERROR_WINDOW;
+	}
+	this->request = request;
+	if (request.isMel){
+		this->request.nBins = FEATURE_ENGINE_N_MEL;
+		this->request.isFft = false;
+	}
+	if (this->request.nBins < 0 || this->request.nBins > FEATURE_ENGINE_MAX_BINS
+			|| (this->request.isFft && this->request.nBins > windowSize/2)){
+		return FEATURE_ENGINE_ERROR_N_BINS;
+	}
+
+	if (!fft || fft->getSize() != windowSize){
+		delete fft;
+		fft = new RealFft(windowSize);
+		window.resize(windowSize);
+		for (int i = 0; i < windowSize; i++){
+			window[i] = 0.5 - 0.5*cos(2*M_PI*i/windowSize);
+		}
+		spectrumRe.resize(windowSize/2 + 1);
+		spectrumIm.resize(windowSize/2 + 1);
+		power.resize(windowSize/2 + 1);
+	}
+	//the filterbank only depends on the sample rate and window, keep it if the plugin is re-initialized with the same
+	double melSampleRate = sampleRate/FEATURE_ENGINE_DECIMATION;
+	if (this->request.isMel && (!melFilterbank || melFilterbank->getSampleRate() != melSampleRate
+			|| melFilterbank->getNBins() != windowSize/2 + 1)){
+		delete melFilterbank;
+		melFilterbank = new MelFilterbank(melSampleRate, windowSize, FEATURE_ENGINE_N_MEL);
+	}
+	if (this->request.isMel){
+		grouping.init(FEATURE_ENGINE_N_MEL, this->request.nBins);
+	}
+	else {
+		grouping.init(windowSize/2, this->request.nBins);
+	}
+
+	//start a new stream, as if it was preceded by silence
+	this->windowSize = windowSize;
+	this->hopSize = hopSize;
+	decimator.reset();
+	decimated.assign(windowSize, 0.0f);
+	nSinceFrame = 0;
+	//the newest frame ends at most a hop and the decimator lookahead before the newest captured sample
+	squares.assign((windowSize + hopSize + 1)*FEATURE_ENGINE_DECIMATION + decimator.getLookahead(), 0.0f);
+	nCaptured = 0;
+	nDecimated = 0;
+	return 0;
+}
+
+int FeatureEngine::getPacketSize() const {
+	return request.nBins + (request.isEnergy ? 2 : 4);
+}
+
+void FeatureEngine::storeSquares(const float* block, int nSamples){
+	int nSquares = squares.size();
+	int position = nCaptured % nSquares;
+	for (int i = 0; i < nSamples; i++){
+		squares[position] = block[i]*block[i];
+		position = (position + 1 == nSquares) ? 0 : position + 1;
+	}
+}
+
+/*
+ * the sum of the squares of the windowSize*FEATURE_ENGINE_DECIMATION captured samples before windowEnd. The ring holds
+ * them all, and samples before the stream started are still 0 in it
+ */
+double FeatureEngine::getWindowEnergy(long long windowEnd) const {
+	int nSquares = squares.size();
+	int position = (windowEnd - windowSize*FEATURE_ENGINE_DECIMATION) % nSquares;
+	position = (position < 0) ? position + nSquares : position;
+	double sum = 0;
+	for (int i = 0; i < windowSize*FEATURE_ENGINE_DECIMATION; i++){
+		sum += squares[position];
+		position = (position + 1 == nSquares) ? 0 : position + 1;
+	}
+	return sum;
+}
+
+void FeatureEngine::computeSpectrum(const float* frame){
+	float* buffer = fft->getBuffer();
+	for (int i = 0; i < windowSize; i++){
+		buffer[i] = window[i]*frame[i];
+	}
+	fft->forward(spectrumRe.data(), spectrumIm.data());
+	for (int k = 0; k <= windowSize/2; k++){
+		power[k] = spectrumRe[k]*spectrumRe[k] + spectrumIm[k]*spectrumIm[k];
+	}
+}
+
+int FeatureEngine::process(const float* block, int nSamples, uint8_t* packet){
+	if (!fft){
+		return 0;
+	}
+	if (request.isEnergy){
+		storeSquares(block, nSamples);
+	}
+	nCaptured += nSamples;
+	int nKept = decimated.size();
+	decimated.resize(nKept + decimator.getMaxOutputSize(nSamples));
+	int nNew = decimator.process(block, nSamples, &decimated[nKept]);
+	decimated.resize(nKept + nNew);
+	nDecimated += nNew;
+	int nPending = nSinceFrame + nNew;
+	nSinceFrame = nPending % hopSize;
+	bool isFrame = nPending >= hopSize;
+	//the newest completed frame ends nSinceFrame samples before the end
+	int frameEnd = decimated.size() - nSinceFrame;
+
+	if (isFrame){
+		int nBins = request.nBins;
+		memset(packet, 0, getPacketSize());
+		if (request.isFft || request.isMel){
+			computeSpectrum(&decimated[frameEnd - windowSize]);
+			if (request.isFft){
+				for (int k = 0; k < windowSize/2; k++){
+					power[k] *= 8;
+				}
+				grouping.apply(power.data(), packet);
+			}
+			else {
+				float mel[FEATURE_ENGINE_N_MEL];
+				for (int k = 0; k <= windowSize/2; k++){
+					power[k] *= 4;
+				}
+				melFilterbank->apply(power.data(), mel);
+				grouping.apply(mel, packet);
+			}
+		}
+		if (request.isEnergy){
+			long long windowEnd = (nDecimated - nSinceFrame)*FEATURE_ENGINE_DECIMATION;
+			double value = getWindowEnergy(windowEnd)*32;
+			uint16_t energy16 = (value <= 0) ? 0 : (value < 65535) ? (uint16_t)value : 65535;
+			memcpy(packet + nBins, &energy16, sizeof(energy16));
+		}
+	}
+
+	//the next frame ends a hop after this one, it only needs the last window
+	decimated.erase(decimated.begin(), decimated.end() - windowSize);
+	return isFrame ? getPacketSize() : 0;
+}
+
+bool isValidAnalysisWindow(int windowSize, int hopSize){
+	return windowSize >= FEATURE_ENGINE_MIN_WINDOW && windowSize <= FEATURE_ENGINE_MAX_WINDOW
+			&& (windowSize & (windowSize - 1)) == 0 && hopSize > 0 && windowSize % hopSize == 0;
+}
+
+BinGrouping::BinGrouping() : nOut(0){
+}
+
+void BinGrouping::init(int nIn, int nOut){
+	this->nOut = nOut;
+	bounds.resize(2*nOut);
+	int step = (nOut > 0) ? nIn/nOut : 0;
+	for (int i = 0; i < nOut; i++){
+		bounds[2*i] = i*step;
+		bounds[2*i + 1] = (i + 1)*step;
+	}
+}
+
+void BinGrouping::apply(const float* in, uint8_t* out) const {
+	for (int i = 0; i < nOut; i++){
+		float acc = 0;
+		for (int k = bounds[2*i]; k < bounds[2*i + 1]; k++){
+			acc += in[k];
+		}
+		out[i] = (acc > 255) ? 255 : (uint8_t)acc;
+	}
+}
@@ -0,0 +1,147 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * MelFilterbank.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "MelFilterbank.h"
+#include "RealFft.h"
+#include <math.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//Slaney's mel scale: 200/3 Hz per mel up to 1 kHz (15 mels), then a factor of 6.4 per 27 mels
+#define MEL_LINEAR_HZ_PER_MEL (200.0/3)
+#define MEL_LOG_START_HZ 1000.0
+#define MEL_LOG_START_MEL (MEL_LOG_START_HZ/MEL_LINEAR_HZ_PER_MEL)
+#define MEL_LOG_STEP (log(6.4)/27)
+
+#if defined(__AVX__)
+#define VECTOR_FLOATS 8
+typedef __m256 vfloat;
+static inline vfloat load(const float* p){ return _mm256_load_ps(p); }
+static inline vfloat loadu(const float* p){ return _mm256_loadu_ps(p); }
+static inline vfloat add(vfloat a, vfloat b){ return _mm256_add_ps(a, b); }
+static inline vfloat mul(vfloat a, vfloat b){ return _mm256_mul_ps(a, b); }
+static inline vfloat zero(){ return _mm256_setzero_ps(); }
+static inline float sum(vfloat v){
+	__m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+#elif defined(__SSE2__)
+#define VECTOR_FLOATS 4
+typedef __m128 vfloat;
+static inline vfloat load(const float* p){ return _mm_load_ps(p); }
+static inline vfloat loadu(const float* p){ return _mm_loadu_ps(p); }
+static inline vfloat add(vfloat a, vfloat b){ return _mm_add_ps(a, b); }
+static inline vfloat mul(vfloat a, vfloat b){ return _mm_mul_ps(a, b); }
+static inline vfloat zero(){ return _mm_setzero_ps(); }
+static inline float sum(vfloat v){
+	__m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+	return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+#else
+#define VECTOR_FLOATS 1
+#endif
+
+static double hzToMel(double hz){
+	if (hz < MEL_LOG_START_HZ){
+		return hz/MEL_LINEAR_HZ_PER_MEL;
+	}
+	return MEL_LOG_START_MEL + log(hz/MEL_LOG_START_HZ)/MEL_LOG_STEP;
+}
+
+static double melToHz(double mel){
+	if (mel < MEL_LOG_START_MEL){
+		return mel*MEL_LINEAR_HZ_PER_MEL;
+	}
+	return MEL_LOG_START_HZ*exp(MEL_LOG_STEP*(mel - MEL_LOG_START_MEL));
+}
+
+static double melWeight(const std::vector<double>& edges, int m, double hz){
+	double lower = (hz - edges[m])/(edges[m + 1] - edges[m]);
+	double upper = (edges[m + 2] - hz)/(edges[m + 2] - edges[m + 1]);
+	double w = (lower < upper) ? lower : upper;
+	return (w > 0) ? w*2/(edges[m + 2] - edges[m]) : 0;
+}
+
+MelFilterbank::MelFilterbank(double sampleRate, int nFft, int nMels) : sampleRate(sampleRate), nMels(nMels),
+		nBins(nFft/2 + 1){
+	//band edges, evenly spaced in mels from 0 to the Nyquist frequency
+	std::vector<double> edges(nMels + 2);
+	double maxMel = hzToMel(sampleRate/2);
+	for (int i = 0; i < nMels + 2; i++){
+		edges[i] = melToHz(maxMel*i/(nMels + 1));
+	}
+	//the non-zero range of every band, each band padded to whole vectors in the weights
+	bands.resize(3*nMels);
+	int nWeights = 0;
+	for (int m = 0; m < nMels; m++){
+		int first = nBins, end = 0;
+		for (int k = 0; k < nBins; k++){
+			if (melWeight(edges, m, sampleRate/2*k/(nBins - 1)) > 0){
+				first = (k < first) ? k : first;
+				end = k + 1;
+			}
+		}
+		if (end <= first){
+			first = end = 0;
+		}
+		bands[3*m] = first;
+		bands[3*m + 1] = end - first;
+		bands[3*m + 2] = nWeights;
+		nWeights += (end - first + VECTOR_FLOATS - 1)/VECTOR_FLOATS*VECTOR_FLOATS;
+	}
+	weights = allocAligned(nWeights);
+	for (int m = 0; m < nMels; m++){
+		for (int k = 0; k < bands[3*m + 1]; k++){
+			weights[bands[3*m + 2] + k] = melWeight(edges, m, sampleRate/2*(bands[3*m] + k)/(nBins - 1));
+		}
+	}
+}
+
+MelFilterbank::~MelFilterbank(){
+	freeAligned(weights);
+}
+
+void MelFilterbank::apply(const float* power, float* mel) const {
+	for (int m = 0; m < nMels; m++){
+		const float* p = power + bands[3*m];
+		const float* w = weights + bands[3*m + 2];
+		int n = bands[3*m + 1];
+		int k = 0;
+		float acc = 0;
+#if VECTOR_FLOATS > 1
+		//the padding of the weights is zero, but the power spectrum ends at nBins, so the tail is scalar
+		vfloat vacc = zero();
+		for (; k + VECTOR_FLOATS <= n; k += VECTOR_FLOATS){
+			vacc = add(vacc, mul(load(w + k), loadu(p + k)));
+		}
+		acc = sum(vacc);
+#endif
+		for (; k < n; k++){
+			acc += w[k]*p[k];
+		}
+		mel[m] = acc;
+	}
+}
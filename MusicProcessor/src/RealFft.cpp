@@ -0,0 +1,168 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * RealFft.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "RealFft.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define ALIGNMENT 32
+
+#if defined(__AVX__)
+#define VECTOR_FLOATS 8
+typedef __m256 vfloat;
+static inline vfloat load(const float* p){ return _mm256_load_ps(p); }
+static inline void store(float* p, vfloat v){ _mm256_store_ps(p, v); }
+static inline vfloat add(vfloat a, vfloat b){ return _mm256_add_ps(a, b); }
+static inline vfloat sub(vfloat a, vfloat b){ return _mm256_sub_ps(a, b); }
+static inline vfloat mul(vfloat a, vfloat b){ return _mm256_mul_ps(a, b); }
+#elif defined(__SSE2__)
+#define VECTOR_FLOATS 4
+typedef __m128 vfloat;
+static inline vfloat load(const float* p){ return _mm_load_ps(p); }
+static inline void store(float* p, vfloat v){ _mm_store_ps(p, v); }
+static inline vfloat add(vfloat a, vfloat b){ return _mm_add_ps(a, b); }
+static inline vfloat sub(vfloat a, vfloat b){ return _mm_sub_ps(a, b); }
+static inline vfloat mul(vfloat a, vfloat b){ return _mm_mul_ps(a, b); }
+#endif
+
+float* allocAligned(int size){
+	void* buffer = NULL;
+	if (posix_memalign(&buffer, ALIGNMENT, (size > 0 ? size : 1)*sizeof(float)) != 0){
+		return NULL;
+	}
+	memset(buffer, 0, size*sizeof(float));
+	return (float*)buffer;
+}
+
+void freeAligned(float* buffer){
+	free(buffer);
+}
+
+RealFft::RealFft(int n) : n(n), half(n/2){
+	int log2half = 0;
+	while ((1 << log2half) < half){
+		log2half++;
+	}
+	bitReverse = new int[half];
+	for (int i = 0; i < half; i++){
+		int r = 0;
+		for (int b = 0; b < log2half; b++){
+			r |= ((i >> b) & 1) << (log2half - 1 - b);
+		}
+		bitReverse[i] = r;
+	}
+	twiddleRe = allocAligned(half);
+	twiddleIm = allocAligned(half);
+	for (int len = 2; len <= half; len <<= 1){
+		for (int k = 0; k < len/2; k++){
+			twiddleRe[len/2 + k] = cos(-2*M_PI*k/len);
+			twiddleIm[len/2 + k] = sin(-2*M_PI*k/len);
+		}
+	}
+	splitRe = allocAligned(half);
+	splitIm = allocAligned(half);
+	for (int k = 0; k < half; k++){
+		splitRe[k] = cos(-2*M_PI*k/n);
+		splitIm[k] = sin(-2*M_PI*k/n);
+	}
+	buffer = allocAligned(n);
+	workRe = allocAligned(half);
+	workIm = allocAligned(half);
+}
+
+RealFft::~RealFft(){
+	delete [] bitReverse;
+	freeAligned(twiddleRe);
+	freeAligned(twiddleIm);
+	freeAligned(splitRe);
+	freeAligned(splitIm);
+	freeAligned(buffer);
+	freeAligned(workRe);
+	freeAligned(workIm);
+}
+
+void RealFft::forward(float* re, float* im){
+	//pair up even and odd samples as complex values, in bit reversed order
+	for (int k = 0; k < half; k++){
+		int t = 2*bitReverse[k];
+		workRe[k] = buffer[t];
+		workIm[k] = buffer[t + 1];
+	}
+
+	//butterflies, doubling the transform length every stage. Once a stage has a vector of twiddles, the twiddles and
+	//both halves of every block are aligned vectors
+	for (int len = 2; len <= half; len <<= 1){
+		int h = len/2;
+		const float* wRe = twiddleRe + h;
+		const float* wIm = twiddleIm + h;
+		for (int i = 0; i < half; i += len){
+			float* aRe = workRe + i;
+			float* aIm = workIm + i;
+			float* bRe = aRe + h;
+			float* bIm = aIm + h;
+			int k = 0;
+#if defined(VECTOR_FLOATS)
+			for (; h >= VECTOR_FLOATS && k < h; k += VECTOR_FLOATS){
+				vfloat wr = load(wRe + k), wi = load(wIm + k);
+				vfloat br = load(bRe + k), bi = load(bIm + k);
+				vfloat ar = load(aRe + k), ai = load(aIm + k);
+				vfloat vr = sub(mul(br, wr), mul(bi, wi));
+				vfloat vi = add(mul(br, wi), mul(bi, wr));
+				store(bRe + k, sub(ar, vr));
+				store(bIm + k, sub(ai, vi));
+				store(aRe + k, add(ar, vr));
+				store(aIm + k, add(ai, vi));
+			}
+#endif
+			for (; k < h; k++){
+				float vRe = bRe[k]*wRe[k] - bIm[k]*wIm[k];
+				float vIm = bRe[k]*wIm[k] + bIm[k]*wRe[k];
+				bRe[k] = aRe[k] - vRe;
+				bIm[k] = aIm[k] - vIm;
+				aRe[k] += vRe;
+				aIm[k] += vIm;
+			}
+		}
+	}
+
+	//split the transform Z of the pairs into the transforms of the even and odd samples,
+	//E[k] = (Z[k] + conj(Z[half - k]))/2 and O[k] = (Z[k] - conj(Z[half - k]))/2i, and combine them,
+	//X[k] = E[k] + exp(-2*pi*i*k/n)*O[k]
+	re[0] = workRe[0] + workIm[0];
+	im[0] = 0;
+	re[half] = workRe[0] - workIm[0];
+	im[half] = 0;
+	for (int k = 1; k < half; k++){
+		float zRe = workRe[k], zIm = workIm[k];
+		float cRe = workRe[half - k], cIm = -workIm[half - k];
+		float eRe = 0.5f*(zRe + cRe), eIm = 0.5f*(zIm + cIm);
+		float oRe = 0.5f*(zIm - cIm), oIm = -0.5f*(zRe - cRe);
+		re[k] = eRe + splitRe[k]*oRe - splitIm[k]*oIm;
+		im[k] = eIm + splitRe[k]*oIm + splitIm[k]*oRe;
+	}
+}
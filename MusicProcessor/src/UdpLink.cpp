@@ -0,0 +1,105 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * UdpLink.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "UdpLink.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static sockaddr_in loopbackAddress(int port){
+	sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	inet_pton(AF_INET, UDP_LINK_HOST, &address.sin_addr);
+	return address;
+}
+
+bool parseSoundFeatureRequest(const char* text, int size, SoundFeatureRequest_t* request){
+	char buffer[UDP_LINK_REQUEST_SIZE + 1];
+	size = (size > UDP_LINK_REQUEST_SIZE) ? UDP_LINK_REQUEST_SIZE : size;
+	memcpy(buffer, text, size);
+	buffer[size] = 0;
+	int isFft, nBins, isEnergy, isMel;
+	if (sscanf(buffer, "%d %d %d %d", &isFft, &nBins, &isEnergy, &isMel) != 4){
+		return false;
+	}
+	request->isFft = isFft;
+	request->nBins = nBins;
+	request->isEnergy = isEnergy;
+	request->isMel = isMel;
+	return true;
+}
+
+UdpLink::UdpLink() : sendSocket(-1){
+}
+
+UdpLink::~UdpLink(){
+	if (sendSocket >= 0){
+		close(sendSocket);
+	}
+}
+
+int UdpLink::waitForRequest(SoundFeatureRequest_t* request){
+	int receiveSocket = socket(AF_INET, SOCK_DGRAM, 0);
+	if (receiveSocket < 0){
+		return UDP_LINK_ERROR_SOCKET;
+	}
+	sockaddr_in address = loopbackAddress(UDP_LINK_REQUEST_PORT);
+	if (bind(receiveSocket, (sockaddr*)&address, sizeof(address)) < 0){
+		close(receiveSocket);
+		return UDP_LINK_ERROR_BIND;
+	}
+	sockaddr_in loopback = loopbackAddress(0);
+	while (true){
+		char packet[UDP_LINK_REQUEST_SIZE];
+		sockaddr_in from;
+		socklen_t fromSize = sizeof(from);
+		int size = recvfrom(receiveSocket, packet, sizeof(packet), 0, (sockaddr*)&from, &fromSize);
+		if (size < 0){
+			close(receiveSocket);
+			return UDP_LINK_ERROR_RECEIVE;
+		}
+		if (from.sin_addr.s_addr == loopback.sin_addr.s_addr && parseSoundFeatureRequest(packet, size, request)){
+			break;
+		}
+	}
+	close(receiveSocket);
+	return 0;
+}
+
+int UdpLink::send(const uint8_t* packet, int size){
+	if (sendSocket < 0){
+		sendSocket = socket(AF_INET, SOCK_DGRAM, 0);
+		if (sendSocket < 0){
+			return UDP_LINK_ERROR_SOCKET;
+		}
+	}
+	sockaddr_in address = loopbackAddress(UDP_LINK_FEATURE_PORT);
+	if (sendto(sendSocket, packet, size, 0, (sockaddr*)&address, sizeof(address)) != size){
+		return UDP_LINK_ERROR_SEND;
+	}
+	return 0;
+}
@@ -0,0 +1,168 @@
+/*
+    Copyright 2017 Nanoleaf Ltd.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+/*
+ * main.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "AudioCapture.h"
+#include "FeatureEngine.h"
+#include "UdpLink.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+
+#define VISUALIZER_SCALAR 5
+#define VISUALIZER_HI_LIMIT 100
+#define VISUALIZER_BLOCK_SIZE 2048			/*the scale of the bar is the one of blocks of this size*/
+#define VISUALIZER_INTERVAL_MS 50
+
+static std::atomic<bool> stopLoop(false);
+
+static void keyPressLoop(){
+	std::string key;
+	while (true){
+		printf("enter q to quit\n>>> ");
+		fflush(stdout);
+		if (!std::getline(std::cin, key) || key == "q"){
+			stopLoop = true;
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+	}
+}
+
+static void visualizer(const float* block, int nSamples){
+	double value = 0;
+	for (int i = 0; i < nSamples; i++){
+		value += block[i]*block[i];
+	}
+	value *= VISUALIZER_SCALAR*(double)VISUALIZER_BLOCK_SIZE/nSamples;
+	int length = (value > VISUALIZER_HI_LIMIT) ? VISUALIZER_HI_LIMIT : (int)value;
+	char bar[VISUALIZER_HI_LIMIT + 3];
+	bar[0] = '\r';
+	memset(bar + 1, '|', length);
+	memset(bar + 1 + length, ' ', VISUALIZER_HI_LIMIT - length);
+	bar[VISUALIZER_HI_LIMIT + 1] = '\n';
+	bar[VISUALIZER_HI_LIMIT + 2] = 0;
+	fputs(bar, stdout);
+	fflush(stdout);
+}
+
+static void printUsage(const char* name){
+	printf("usage: %s [--viz] [--window N] [--hop N]\n"
+			"Music processing and streaming for the Nanoleaf Rhythm SDK\n"
+			"  --viz       turn on simple visualizer, please limit use to setup and debug\n"
+			"  --window N  analysis window in samples after down-sampling by %d, a power of 2 (default %d)\n"
+			"  --hop N     samples between feature updates after down-sampling, dividing the window (default %d)\n",
+			name, FEATURE_ENGINE_DECIMATION, FEATURE_ENGINE_WINDOW, FEATURE_ENGINE_HOP);
+}
+
+int main(int argc, char** argv){
+	bool visualize = false;
+	int windowSize = FEATURE_ENGINE_WINDOW;
+	int hopSize = FEATURE_ENGINE_HOP;
+	for (int i = 1; i < argc; i++){
+		if (strcmp(argv[i], "--viz") == 0){
+			visualize = true;
+		}
+		else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc){
+			windowSize = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--hop") == 0 && i + 1 < argc){
+			hopSize = atoi(argv[++i]);
+		}
+		else {
+			printUsage(argv[0]);
+			return (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) ? 0 : 1;
+		}
+	}
+	if (!isValidAnalysisWindow(windowSize, hopSize)){
+		printf("The window must be a power of 2 from %d to %d and the hop must divide it\n",
+				FEATURE_ENGINE_MIN_WINDOW, FEATURE_ENGINE_MAX_WINDOW);
+		return 1;
+	}
+
+	UdpLink link;
+	printf("Music processor initialized... please run your plugin to continue or ctrl+c to exit\n");
+	SoundFeatureRequest_t request;
+	int ret = link.waitForRequest(&request);
+	if (ret != 0){
+		printf("Could not receive the sound features of the plugin (%d)\n", ret);
+		return 1;
+	}
+	printf("Plugin detected... continuing\n");
+
+	AudioCapture capture;
+	//one capture block per hop, so every block completes a frame as soon as it arrives
+	if (capture.start(hopSize*FEATURE_ENGINE_DECIMATION) != 0){
+		return 1;
+	}
+	FeatureEngine engine;
+	ret = engine.init(request, capture.getSampleRate(), windowSize, hopSize);
+	if (ret != 0){
+		printf("Unsupported sound features or sample rate (%d)\n", ret);
+		return 1;
+	}
+
+	printf("Music processor active!\n");
+	if (visualize){
+		printf("Visualize on: try a loud clap and a simple sound bar should appear\n");
+	}
+	else {
+		printf("If nothing seems to be happening, try running with --viz\n");
+	}
+	std::thread keyPressThread(keyPressLoop);
+
+	uint8_t packet[FEATURE_ENGINE_MAX_PACKET];
+	int packetSize = 0;
+	std::chrono::steady_clock::time_point visualizerTime = std::chrono::steady_clock::now();
+	while (!stopLoop){
+		int nSamples;
+		const float* block = capture.getBlock(&nSamples);
+		if (!block){
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+		if (visualize && std::chrono::steady_clock::now() >= visualizerTime){
+			visualizer(block, nSamples);
+			visualizerTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(VISUALIZER_INTERVAL_MS);
+		}
+		int size = engine.process(block, nSamples, packet);
+		packetSize = (size > 0) ? size : packetSize;
+		capture.releaseBlock();
+		//every block is analyzed, but if the analysis fell behind only the features of the newest frame are sent
+		if (capture.getNQueued() > 0 || packetSize == 0){
+			continue;
+		}
+		link.send(packet, packetSize);
+		packetSize = 0;
+	}
+	printf("Stopping music processor!\n");
+	printf("blocks dropped: %u by the analysis falling behind, %u by the audio input\n", capture.getNOverruns(),
+			capture.getNInputOverflows());
+
+	capture.stop();
+	keyPressThread.join();
+	return 0;
+}